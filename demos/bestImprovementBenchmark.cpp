@@ -0,0 +1,67 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <tbb/task_arena.h>
+
+#include "meshcore/optimization/BestImprovementSearch.h"
+#include "meshcore/optimization/StripPackingMoves.h"
+#include "meshcore/optimization/StripPackingObjectives.h"
+
+/*
+ * Measures how BestImprovementSearch scales with the number of cores.
+ * A fixed number of iterations is run on a tower of stacked items, once for each number of threads.
+ */
+int main(int argc, char *argv[]){
+
+    const size_t numberOfItems = argc > 1 ? std::stoul(argv[1]) : 64;
+    const unsigned int iterations = argc > 2 ? std::stoul(argv[2]) : 20;
+
+    std::vector<Vertex> cubeVertices = {Vertex(0,0,0), Vertex(1,0,0), Vertex(0,1,0), Vertex(1,1,0),
+                                        Vertex(0,0,1), Vertex(1,0,1), Vertex(0,1,1), Vertex(1,1,1)};
+    auto cube = ModelSpaceMesh(cubeVertices).getConvexHull();
+    cube->setName("cube.obj");
+    std::vector<Vertex> tetrahedronVertices = {Vertex(0,0,0), Vertex(1,0,0), Vertex(0,1,0), Vertex(0,0,1)};
+    auto tetrahedron = ModelSpaceMesh(tetrahedronVertices).getConvexHull();
+    tetrahedron->setName("tetrahedron.obj");
+
+    const auto problem = std::make_shared<StripPackingProblem>("", "Best improvement benchmark", AABB(Vertex(0,0,0), Vertex(10,10,4.0f*numberOfItems)),
+                                                               std::vector<std::shared_ptr<ModelSpaceMesh>>{cube, tetrahedron},
+                                                               std::vector<size_t>{numberOfItems/2, numberOfItems - numberOfItems/2}, ObjectOrigin::AlignToMinimum);
+    const auto initialSolution = std::make_shared<StripPackingSolution>(problem);
+    for (size_t itemIndex = 0; itemIndex < numberOfItems; ++itemIndex){
+        Transformation transformation;
+        transformation.setPosition(glm::vec3(0.0f, 0.0f, 2.0f * static_cast<float>(itemIndex)));
+        initialSolution->setItemTransformation(itemIndex, transformation);
+    }
+
+    const StripPackingHeightObjective objective;
+    StripPackingTranslationMoveFactory moveFactory;
+    const Random random(0);
+
+    const auto maximumConcurrency = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    double sequentialDuration = 0.0;
+    std::cout << "Items: " << numberOfItems << ", iterations: " << iterations << std::endl;
+    std::vector<int> concurrencies;
+    for (int concurrency = 1; concurrency < maximumConcurrency; concurrency *= 2){
+        concurrencies.push_back(concurrency);
+    }
+    concurrencies.push_back(maximumConcurrency);
+
+    for (const auto concurrency: concurrencies){
+        BestImprovementSearch<StripPackingSolution> search(moveFactory, objective, iterations, random, 0.5f);
+        std::shared_ptr<StripPackingSolution> result;
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        tbb::task_arena(concurrency).execute([&](){
+            result = search.executeSearch(initialSolution);
+        });
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        const auto duration = std::chrono::duration<double, std::milli>(end - start).count();
+        if(concurrency == 1){
+            sequentialDuration = duration;
+        }
+        std::cout << "Threads: " << concurrency << "\tTime: " << duration << " ms\tSpeedup: " << sequentialDuration / duration << "\tHeight: " << objective.evaluate(result) << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#include "meshcore/acceleration/BoundingVolumeHierarchy.h"
+#include "meshcore/geometric/Intersection.h"
+#include "meshcore/utility/random.h"
+
+/*
+ * Compares collision tests between two meshes that only differ by a translation.
+ * The generic path transforms every triangle of one mesh, the per-node path queries the other tree for every node of
+ * the first tree (as Intersection::intersect did before), the dual traversal walks both trees at once.
+ */
+int main(int argc, char *argv[]){
+
+    const int resolution = argc > 1 ? std::stoi(argv[1]) : 40;
+    const int queries = argc > 2 ? std::stoi(argv[2]) : 2000;
+
+    // A wavy height field, which gives many near misses between the two meshes
+    std::vector<Vertex> vertices;
+    std::vector<IndexTriangle> triangles;
+    for (int row = 0; row <= resolution; ++row){
+        for (int column = 0; column <= resolution; ++column){
+            const auto x = static_cast<float>(column) / resolution;
+            const auto y = static_cast<float>(row) / resolution;
+            vertices.emplace_back(x, y, 0.1f * std::sin(20.0f * x) * std::cos(20.0f * y));
+        }
+    }
+    for (int row = 0; row < resolution; ++row){
+        for (int column = 0; column < resolution; ++column){
+            const auto index = static_cast<size_t>(row * (resolution + 1) + column);
+            triangles.emplace_back(index, index + 1, index + resolution + 1);
+            triangles.emplace_back(index + 1, index + resolution + 2, index + resolution + 1);
+        }
+    }
+    const auto mesh = std::make_shared<ModelSpaceMesh>(vertices, triangles);
+    const BoundingVolumeHierarchy tree(mesh);
+
+    const Random random(0);
+    std::vector<glm::vec3> translations;
+    for (int query = 0; query < queries; ++query){
+        translations.emplace_back(random.nextFloat(-0.5f, 0.5f), random.nextFloat(-0.5f, 0.5f), random.nextFloat(0.0f, 0.3f));
+    }
+
+    const auto measure = [&](const std::string& name, const auto& intersects){
+        int intersecting = 0;
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& translation: translations){
+            intersecting += intersects(translation);
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        const auto duration = std::chrono::duration<double, std::micro>(end - start).count() / queries;
+        std::cout << name << "\t" << duration << " us/query\tIntersecting: " << intersecting << std::endl;
+        return duration;
+    };
+
+    std::cout << "Triangles: " << triangles.size() << ", queries: " << queries << std::endl;
+    const auto generic = measure("Generic", [&](const glm::vec3& translation){
+        Transformation transformation;
+        transformation.setPosition(translation);
+        for (const auto& triangle: tree.getTriangles()){
+            if(tree.intersectsTriangle(triangle.getTransformed(transformation))){
+                return true;
+            }
+        }
+        return false;
+    });
+    const auto perNode = measure("Per node", [&](const glm::vec3& translation){
+        for (const auto& node: tree.getNodes()){
+            if(tree.intersectsAABB(node.bounds.getTranslated(translation))){
+                for (int i = 0; i < node.triangleCount; ++i){
+                    if(tree.intersectsTriangle(tree.getTriangles()[node.firstChildOrTriangleIndex + i].getTranslated(translation))){
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    });
+    const auto dual = measure("Dual", [&](const glm::vec3& translation){
+        return tree.intersectsTranslated(tree, translation);
+    });
+    std::cout << "Speedup over generic: " << generic / dual << ", over per node: " << perNode / dual << std::endl;
+    return 0;
+}
@@ -8,6 +8,8 @@
 #include "meshcore/core/VertexTriangle.h"
 #include "meshcore/core/ModelSpaceMesh.h"
 #include "meshcore/core/Ray.h"
+#include <limits>
+#include <optional>
 #include <vector>
 
 class BoundingVolumeHierarchy {
@@ -29,17 +31,48 @@ public:
         float lowerDistanceBoundSquared = std::numeric_limits<float>::max();
     };
 
+    struct ClosestPointQueryResult {
+        float distanceSquared = std::numeric_limits<float>::max();
+        Vertex closestPoint{};
+        unsigned int triangleIndex = 0; // Into getTriangles()
+    };
+
+    struct RayHit {
+        float distance = 0.0f; // Along the ray, in units of its direction
+        glm::vec2 barycentricCoordinates{}; // Weights of the triangle's second and third vertex at the hit point
+        unsigned int triangleIndex = 0; // Into getTriangles()
+    };
+
+    static constexpr unsigned int PACKET_SIZE = 8; // Rays traversed together by queryClosestHits
+
 private:
     std::vector<VertexTriangle> triangles;
     std::vector<Node> nodes;
+    std::vector<float> triangleBoundComponents; // Minimum x, y, z and maximum x, y, z of the triangles' bounds, one block per component, for batched leaf tests
+
+    void initialiseTriangleBoundComponents();
 public:
     explicit BoundingVolumeHierarchy(const std::shared_ptr<ModelSpaceMesh> &mesh);
+    BoundingVolumeHierarchy(std::vector<Node> nodes, std::vector<VertexTriangle> triangles); // Restore a previously built hierarchy
     [[nodiscard]] bool intersectsTriangle(const VertexTriangle &triangle) const;
     [[nodiscard]] bool intersectsAABB(const AABB &aabb) const;
+    [[nodiscard]] bool intersectsTranslated(const BoundingVolumeHierarchy &other, const glm::vec3 &translation) const; // Both hierarchies in the same frame, the other one translated
     [[nodiscard]] bool containsPoint(const glm::vec3& point) const;
     void queryClosestTriangle(const Vertex &vertex, ClosestTriangleQueryResult* result) const;
     void queryClosestTriangle(const VertexTriangle &triangle, ClosestTriangleQueryResult* result) const;
 
+    // Closest points on the mesh of many points, one result per point. The points are processed in parallel in the order
+    // of a Morton curve through their bounds, and each query starts with the distance to the previous point's closest
+    // triangle as its bound, which culls most of the tree for nearby points
+    void queryClosestPoints(const std::vector<Vertex> &points, std::vector<ClosestPointQueryResult>& results) const;
+    [[nodiscard]] std::optional<RayHit> queryClosestHit(const Ray &ray, float maximumDistance=std::numeric_limits<float>::max()) const;
+    [[nodiscard]] bool isOccluded(const Ray &ray, float maximumDistance=std::numeric_limits<float>::max()) const; // Any triangle hit before the maximum distance, stops at the first one found
+    void queryRayHits(const Ray &ray, std::vector<RayHit>& hits) const; // Appends all triangles hit in front of the ray's origin, unordered
+
+    // Closest hits of many rays, which descend the tree together in packets of PACKET_SIZE rays. Faster than separate
+    // queries for coherent rays, such as parallel rays on a grid or rays from a common origin in nearby directions
+    void queryClosestHits(const std::vector<Ray> &rays, std::vector<std::optional<RayHit>>& hits, float maximumDistance=std::numeric_limits<float>::max()) const;
+
 
 
     [[nodiscard]] float getShortestDistanceSquared(const glm::vec3& point) const;
@@ -12,14 +12,21 @@
 
 template<class Tree>
 class CachingBoundsTreeFactory {
+
+    // This map keeps every ModelSpaceMesh allocated because it stores their shared pointers,
+    // it might be better to make these trees part of the ModelSpaceMesh class itself.
+    // Storing raw or weak pointers causes undefined behavior because another ModelSpaceMesh in the same location would be considered the same key.
+    using CacheMap = tbb::concurrent_hash_map<std::shared_ptr<ModelSpaceMesh>, std::shared_ptr<Tree>>;
+
+    static CacheMap& getCacheMap() {
+        static CacheMap cacheMap;
+        return cacheMap;
+    }
+
 public:
     static std::shared_ptr<Tree> getBoundsTree(const std::shared_ptr<ModelSpaceMesh> &modelSpaceMesh) {
 
-        // This map keeps every ModelSpaceMesh allocated because it stores their shared pointers,
-        // it might be better to make these trees part of the ModelSpaceMesh class itself.
-        // Storing raw or weak pointers causes undefined behavior because another ModelSpaceMesh in the same location would be considered the same key.
-        using CacheMap = tbb::concurrent_hash_map<std::shared_ptr<ModelSpaceMesh>, std::shared_ptr<Tree>>;
-        static CacheMap cacheMap;
+        auto& cacheMap = getCacheMap();
 
         // 1. Check if cached already
         {
@@ -41,6 +48,16 @@ public:
             return tree;
         }
     }
+
+    /**
+     * Register a tree that was built elsewhere (e.g. restored from a bundle file) for the given mesh.
+     * An existing entry for the mesh is replaced.
+     */
+    static void putBoundsTree(const std::shared_ptr<ModelSpaceMesh> &modelSpaceMesh, const std::shared_ptr<Tree> &tree) {
+        typename CacheMap::accessor accessor; // Lock for writing
+        getCacheMap().insert(accessor, modelSpaceMesh);
+        accessor->second = tree;
+    }
 };
 
 #endif //MESHCORE_CACHINGBOUNDSTREEFACTORY_H
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef MESHCORE_HEIGHTMAP_H
+#define MESHCORE_HEIGHTMAP_H
+
+#include <map>
+#include <optional>
+#include <tuple>
+#include <memory>
+#include <vector>
+#include "meshcore/core/ModelSpaceMesh.h"
+#include "meshcore/core/Quaternion.h"
+#include "meshcore/core/Transformation.h"
+
+/**
+ * Top and bottom surface of a mesh in a fixed orientation, rasterised on a grid in the xy-plane.
+ *
+ * Heights are relative to the minimum of the rotated mesh's AABB. Each cell holds an upper bound of the top surface
+ * and a lower bound of the bottom surface above that cell. The maps are dilated by one cell in x and y, so they remain
+ * conservative when the mesh is placed at any offset relative to a grid with the same cell size.
+ */
+class DepthMap {
+    AABB bounds; // Of the rotated and scaled mesh
+    float cellSize;
+    int columns;
+    int rows;
+    std::vector<float> tops; // Minus infinity where the mesh doesn't cover the cell
+    std::vector<float> bottoms; // Plus infinity where the mesh doesn't cover the cell
+
+public:
+    DepthMap(const ModelSpaceMesh& modelSpaceMesh, const Quaternion& rotation, float scale, float cellSize);
+
+    [[nodiscard]] const AABB& getBounds() const { return bounds; }
+    [[nodiscard]] float getCellSize() const { return cellSize; }
+    [[nodiscard]] int getColumns() const { return columns; }
+    [[nodiscard]] int getRows() const { return rows; }
+    [[nodiscard]] float getTop(int column, int row) const { return tops[row * columns + column]; }
+    [[nodiscard]] float getBottom(int column, int row) const { return bottoms[row * columns + column]; }
+    [[nodiscard]] const float* getBottomRow(int row) const { return bottoms.data() + row * columns; }
+};
+
+/**
+ * Top surface of a set of placed items, rasterised over the xy-footprint of a container (2.5D).
+ *
+ * Everything below the top surface is considered occupied, so computeLowestPlacement returns a height at which an item
+ * is guaranteed not to intersect the placed items, not necessarily the lowest such height. Suitable as a conservative
+ * filter before exact intersection tests. Items are identified by an index and can be moved or removed incrementally,
+ * which only touches the cells they cover.
+ */
+class Heightmap {
+
+    struct Placement {
+        std::shared_ptr<const DepthMap> depthMap;
+        int column = 0; // Cell of the depth map's origin
+        int row = 0;
+        float z = 0.0f; // Height of the item's AABB minimum
+    };
+
+    AABB footprint;
+    float cellSize;
+    int columns;
+    int rows;
+    std::vector<float> heights;
+    std::vector<std::vector<size_t>> cellItems; // Items covering each cell, required to restore the heights when an item is removed
+    std::vector<std::optional<Placement>> placements;
+
+    using DepthMapKey = std::tuple<const ModelSpaceMesh*, float, float, float, float, float>;
+    std::map<DepthMapKey, std::pair<std::shared_ptr<ModelSpaceMesh>, std::shared_ptr<const DepthMap>>> depthMaps;
+
+    [[nodiscard]] int computeColumn(float x) const; // Unclamped, can lie outside the grid
+    [[nodiscard]] int computeRow(float y) const;
+    [[nodiscard]] static float computeContribution(const Placement& placement, int column, int row);
+
+public:
+    Heightmap(const AABB& container, float cellSize);
+
+    /** A quarter of the smallest side of the meshes' footprints, with at most 512 cells along each side of the container **/
+    [[nodiscard]] static float computeDefaultCellSize(const AABB& container, const std::vector<std::shared_ptr<ModelSpaceMesh>>& modelSpaceMeshes);
+
+    // Depth maps are cached per mesh, rotation and scale, with this heightmap's cell size
+    [[nodiscard]] const std::shared_ptr<const DepthMap>& getDepthMap(const std::shared_ptr<ModelSpaceMesh>& modelSpaceMesh, const Quaternion& rotation, float scale=1.0f);
+
+    void setItem(size_t itemIndex, const std::shared_ptr<ModelSpaceMesh>& modelSpaceMesh, const Transformation& transformation);
+    void setItem(size_t itemIndex, const std::shared_ptr<const DepthMap>& depthMap, const Vertex& minimum); // Minimum of the item's AABB
+    void removeItem(size_t itemIndex);
+    void clear();
+
+    /** Lowest height for the minimum of the item's AABB, placed at the given x and y, that keeps it above the surface **/
+    [[nodiscard]] float computeLowestPlacement(const DepthMap& depthMap, float x, float y) const;
+
+    [[nodiscard]] float getCellSize() const { return cellSize; }
+    [[nodiscard]] int getColumns() const { return columns; }
+    [[nodiscard]] int getRows() const { return rows; }
+    [[nodiscard]] float getHeight(int column, int row) const { return heights[row * columns + column]; }
+};
+
+#endif //MESHCORE_HEIGHTMAP_H
@@ -0,0 +1,73 @@
+#ifndef MESHCORE_ORIENTATIONCACHE_H
+#define MESHCORE_ORIENTATIONCACHE_H
+
+#include <array>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "meshcore/core/ModelSpaceMesh.h"
+#include "meshcore/core/Quaternion.h"
+#include "BoundingVolumeHierarchy.h"
+
+/**
+ * A mesh with a rotation baked into its vertices, along with the derived data used by placement and collision queries.
+ * Two oriented meshes only differ by a translation, so their intersection can be tested without transforming triangles.
+ */
+struct OrientedMesh {
+    Quaternion rotation;
+    std::shared_ptr<ModelSpaceMesh> mesh; // Rotated vertices, same triangles as the original mesh
+    std::shared_ptr<ModelSpaceMesh> convexHull; // Rotated convex hull of the original mesh
+    AABB bounds; // Of the rotated mesh
+    std::shared_ptr<BoundingVolumeHierarchy> tree; // Built in the rotated frame, null if the cache doesn't build trees
+
+    [[nodiscard]] size_t computeMemoryUsage() const;
+};
+
+struct OrientationCacheParameters {
+    float quantisation = 1e-5f; // Rotations whose quaternions differ less than this along each component share an entry
+    size_t maximumMemory = 0; // In bytes, the oldest entries are evicted when it is exceeded, 0 means unlimited
+    bool buildTrees = true;
+    bool lazyBuild = true; // Build missing entries on lookup, otherwise only the entries added through prepare are returned
+};
+
+/**
+ * Oriented meshes per ModelSpaceMesh and rotation, for problems that restrict rotations to a discrete set.
+ *
+ * Rotations are keyed by their quantised quaternion, with q and -q mapping to the same key. Lookups are thread safe,
+ * entries are built outside the lock, so different entries can be built concurrently.
+ */
+class OrientationCache {
+
+    using Key = std::pair<const ModelSpaceMesh*, std::array<long, 4>>;
+
+    struct Entry {
+        std::shared_ptr<ModelSpaceMesh> modelSpaceMesh; // Keeps the key's mesh alive, so its address can't be reused by another mesh
+        std::shared_ptr<const OrientedMesh> orientedMesh;
+        std::list<Key>::iterator age;
+    };
+
+    const OrientationCacheParameters parameters;
+    mutable std::mutex mutex;
+    std::map<Key, Entry> entries;
+    std::list<Key> insertionOrder; // Oldest first
+    size_t memoryUsage = 0;
+
+    [[nodiscard]] Key computeKey(const std::shared_ptr<ModelSpaceMesh>& modelSpaceMesh, const Quaternion& rotation) const;
+    [[nodiscard]] std::shared_ptr<const OrientedMesh> build(const ModelSpaceMesh& modelSpaceMesh, const Quaternion& rotation) const;
+    std::shared_ptr<const OrientedMesh> insert(const Key& key, const std::shared_ptr<ModelSpaceMesh>& modelSpaceMesh, std::shared_ptr<const OrientedMesh> orientedMesh);
+
+public:
+    explicit OrientationCache(OrientationCacheParameters parameters={});
+
+    [[nodiscard]] std::shared_ptr<const OrientedMesh> find(const std::shared_ptr<ModelSpaceMesh>& modelSpaceMesh, const Quaternion& rotation) const; // Null if not cached
+    [[nodiscard]] std::shared_ptr<const OrientedMesh> get(const std::shared_ptr<ModelSpaceMesh>& modelSpaceMesh, const Quaternion& rotation); // Null if not cached and lazyBuild is disabled
+    void prepare(const std::vector<std::shared_ptr<ModelSpaceMesh>>& modelSpaceMeshes, const std::vector<Quaternion>& rotations); // Builds all combinations in parallel
+
+    [[nodiscard]] const OrientationCacheParameters& getParameters() const;
+    [[nodiscard]] size_t getNumberOfEntries() const;
+    [[nodiscard]] size_t getMemoryUsage() const;
+    void clear();
+};
+
+#endif //MESHCORE_ORIENTATIONCACHE_H
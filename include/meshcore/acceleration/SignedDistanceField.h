@@ -0,0 +1,60 @@
+#ifndef MESHCORE_SIGNEDDISTANCEFIELD_H
+#define MESHCORE_SIGNEDDISTANCEFIELD_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "meshcore/core/ModelSpaceMesh.h"
+#include "meshcore/core/Transformation.h"
+
+class BoundingVolumeHierarchy;
+
+struct SignedDistanceFieldParameters {
+    unsigned int resolution = 64; // Cells along the longest side of the mesh's bounds
+    float bandWidth = 0.0f; // Relative to the longest side, samples further from the surface only store the sign, zero for exact samples everywhere
+};
+
+/**
+ * Signed distances to the surface of a closed mesh, sampled on a regular grid in its model space. Negative inside.
+ *
+ * The samples are computed in parallel with the mesh's cached bounding volume hierarchy, the sign with its ray based inside
+ * test. As the signed distance changes at most as fast as the position, the eight samples around a point bound its
+ * distance from both sides in constant time. Queries fall back to the tree only if these bounds aren't decisive.
+ * With a narrow band, samples further than the band width from the surface are clamped to plus or minus the band width,
+ * which skips most of the tree descents while building. Clamped samples only bound the distance from one side.
+ */
+class SignedDistanceField {
+    Vertex origin; // Position of sample (0,0,0)
+    float cellSize = 0.0f;
+    glm::uvec3 dimensions{0}; // Samples along each axis
+    float bandWidth = 0.0f; // Absolute, infinite if all samples are exact
+    std::vector<float> samples; // Sample (x,y,z) at index (z * dimensions.y + y) * dimensions.x + x
+
+    [[nodiscard]] size_t computeSampleIndex(unsigned int x, unsigned int y, unsigned int z) const;
+
+public:
+    explicit SignedDistanceField(const std::shared_ptr<ModelSpaceMesh>& modelSpaceMesh, const SignedDistanceFieldParameters& parameters={}); // Uses the cached tree of the mesh
+    SignedDistanceField(const Vertex& origin, float cellSize, const glm::uvec3& dimensions, float bandWidth, std::vector<float> samples); // Restore a previously computed field
+
+    [[nodiscard]] const Vertex& getOrigin() const;
+    [[nodiscard]] float getCellSize() const;
+    [[nodiscard]] const glm::uvec3& getDimensions() const;
+    [[nodiscard]] float getBandWidth() const;
+    [[nodiscard]] const std::vector<float>& getSamples() const;
+    [[nodiscard]] AABB getBounds() const;
+
+    [[nodiscard]] float getSignedDistance(const Vertex& point) const; // Trilinear estimate, clamped to the band
+    [[nodiscard]] std::pair<float, float> getSignedDistanceBounds(const Vertex& point) const; // Lower and upper bound of the exact signed distance
+
+    // Unsigned distance from the point to the surface smaller than the given distance, queries the tree of the same mesh only if the bounds aren't decisive
+    [[nodiscard]] bool isWithinDistance(const Vertex& point, float distance, const BoundingVolumeHierarchy& tree) const;
+
+    // Coarse estimate of how far the other mesh penetrates this one, the largest trilinear depth of its vertices
+    [[nodiscard]] float estimatePenetrationDepth(const ModelSpaceMesh& other, const Transformation& otherToThisTransformation) const;
+
+    void save(const std::string& path) const;
+    static std::shared_ptr<SignedDistanceField> load(const std::string& path);
+};
+
+#endif //MESHCORE_SIGNEDDISTANCEFIELD_H
@@ -8,22 +8,30 @@
 #include <vector>
 #include <memory>
 #include <optional>
+#include <mutex>
 #include <string>
+#include <array>
 #include <unordered_set>
 #include "Vertex.h"
 #include "IndexTriangle.h"
 #include "IndexEdge.h"
 #include "IndexFace.h"
 #include "AABB.h"
+#include "OBB.h"
+#include "Quaternion.h"
 #include "meshcore/geometric/GJK.h"
 
-class ModelSpaceMesh: public GJKConvexShape {
+class ConvexDecomposition;
+class CollisionProxy;
+class SignedDistanceField;
+
+class ModelSpaceMesh: public GJKConvexShape, public std::enable_shared_from_this<ModelSpaceMesh> {
 
     std::string name;
     std::vector<Vertex> vertices;
     std::vector<IndexTriangle> triangles;
 
-    // Cached data
+    // Cached data, each property is computed at most once, also when queried concurrently
     mutable std::optional<std::vector<IndexEdge>> triangleEdges;
     mutable std::optional<std::vector<IndexFace>> faces;
     mutable std::optional<std::vector<IndexEdge>> faceEdges;
@@ -33,19 +41,38 @@ class ModelSpaceMesh: public GJKConvexShape {
     mutable std::optional<Vertex> volumeCentroid;
     mutable std::optional<Vertex> surfaceCentroid;
     mutable std::optional<AABB> bounds;
+    mutable std::optional<OBB> orientedBounds;
     mutable std::shared_ptr<ModelSpaceMesh> convexHull = nullptr;
     mutable std::optional<std::vector<std::vector<size_t>>> connectedVertexIndices;
+    mutable std::shared_ptr<const ConvexDecomposition> convexDecomposition = nullptr;
+    mutable std::shared_ptr<const CollisionProxy> collisionProxy = nullptr;
+    mutable std::shared_ptr<const SignedDistanceField> signedDistanceField = nullptr;
+
+    mutable std::once_flag triangleEdgesFlag;
+    mutable std::once_flag facesFlag;
+    mutable std::once_flag faceEdgesFlag;
+    mutable std::once_flag convexFlag;
+    mutable std::once_flag volumeFlag; // Volume and volume centroid
+    mutable std::once_flag surfaceAreaFlag; // Surface area and surface centroid
+    mutable std::once_flag boundsFlag;
+    mutable std::once_flag orientedBoundsFlag;
+    mutable std::once_flag convexHullFlag;
+    mutable std::once_flag connectedVertexIndicesFlag;
+    mutable std::once_flag convexDecompositionFlag;
+    mutable std::once_flag collisionProxyFlag;
+    mutable std::once_flag signedDistanceFieldFlag;
 
     void computeVolumeAndCentroid() const;
     void computeSurfaceAreaAndCentroid() const;
     void computeConvexity() const;
     void computeFaces() const;
+    void computeConvexHull() const;
 
 public:
     ModelSpaceMesh() = default;
     explicit ModelSpaceMesh(std::vector<Vertex> vertices);
     ModelSpaceMesh(std::vector<Vertex> vertices, std::vector<IndexTriangle> triangles);
-    ModelSpaceMesh(const ModelSpaceMesh& other) = default;
+    ModelSpaceMesh(const ModelSpaceMesh& other); // Copies the geometry, the cached properties are recomputed on demand
     ~ModelSpaceMesh() override = default;
 
     [[nodiscard]] const std::vector<Vertex>& getVertices() const;
@@ -56,10 +83,17 @@ public:
     [[nodiscard]] std::vector<IndexEdge> getSufficientIntersectionEdges() const; // Edge faces enough?
 
     const AABB &getBounds() const;
+    [[nodiscard]] const OBB &getOBB() const; // Not necessarily optimal, but never larger than the bounds
 
     [[nodiscard]] const std::vector<std::vector<size_t>>& getConnectedVertexIndices() const;
     const std::shared_ptr<ModelSpaceMesh>& getConvexHull() const;
     bool isConvex() const;
+    [[nodiscard]] const std::shared_ptr<const ConvexDecomposition>& getConvexDecomposition() const; // Approximate, with the default parameters unless another decomposition was set before
+    void setPrecomputedConvexDecomposition(const std::shared_ptr<const ConvexDecomposition>& precomputedConvexDecomposition) const; // E.g. computed with another tolerance, ignored once the decomposition exists
+    [[nodiscard]] const std::shared_ptr<const CollisionProxy>& getCollisionProxy() const; // Simplified mesh enclosing this one, with the default parameters unless another proxy was set before
+    void setPrecomputedCollisionProxy(const std::shared_ptr<const CollisionProxy>& precomputedCollisionProxy) const; // Ignored once the proxy exists
+    [[nodiscard]] const std::shared_ptr<const SignedDistanceField>& getSignedDistanceField() const; // With the default parameters unless another field was set before, only computed when requested, then the mesh should be owned by a shared pointer
+    void setPrecomputedSignedDistanceField(const std::shared_ptr<const SignedDistanceField>& precomputedSignedDistanceField) const; // E.g. loaded from a file, ignored once the field exists
     float getVolume() const;
     Vertex getVolumeCentroid() const;
     Vertex getSurfaceCentroid() const;
@@ -68,8 +102,16 @@ public:
     const std::string &getName() const;
     void setName(const std::string &newName);
 
+    // Seed the cached properties with values that were computed before, e.g. when loading a precompiled bundle
+    void setPrecomputedProperties(const AABB& precomputedBounds, float precomputedVolume, const Vertex& precomputedVolumeCentroid, const std::shared_ptr<ModelSpaceMesh>& precomputedConvexHull) const;
+
+    // Compute all cached properties at once, independent properties are computed concurrently if parallel is set
+    void precomputeAll(bool parallel=true) const;
+
     // GJKConvexShape interface
     glm::vec3 computeSupport(const glm::vec3 &direction) const override;
+    [[nodiscard]] size_t computeSupportIndex(const glm::vec3 &direction, size_t startIndex) const; // Hill climb over connected vertices, requires a convex mesh
+    [[nodiscard]] AABB computeSupportAABB(const glm::vec3& position, const Quaternion& rotation, float scale, std::array<size_t, 6>& extremeVertexIndices) const; // Of the scaled, rotated and translated mesh, requires a convex mesh
     glm::vec3 getCenter() const override;
 
 };
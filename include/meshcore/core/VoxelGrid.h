@@ -0,0 +1,62 @@
+#ifndef MESHCORE_VOXELGRID_H
+#define MESHCORE_VOXELGRID_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "Core.h"
+#include "Vertex.h"
+#include "AABB.h"
+
+/**
+ * Occupancy grid with one bit per voxel.
+ *
+ * Voxels are packed per row along the x-axis into 64-bit words, each row being padded to a whole number of words.
+ * Overlap and containment tests between grids under integer voxel translations work a word at a time (AND + popcount)
+ * instead of voxel by voxel, which makes voxelised items usable for feasibility checks without triangulating them.
+ */
+class VoxelGrid {
+
+    glm::uvec3 dimensions;      // Number of voxels along each axis
+    Vertex origin;              // Minimum corner of voxel (0,0,0)
+    Vertex voxelSize;           // Size of a single voxel along each axis
+    size_t wordsPerRow;
+    std::vector<uint64_t> words; // Row (y,z) starts at word (z * dimensions.y + y) * wordsPerRow, padding bits are always zero
+    std::string name = "VoxelGrid";
+
+public:
+    explicit VoxelGrid(const glm::uvec3& dimensions, const Vertex& origin=Vertex(0.0f), const Vertex& voxelSize=Vertex(1.0f));
+
+    [[nodiscard]] const glm::uvec3& getDimensions() const;
+    [[nodiscard]] const Vertex& getOrigin() const;
+    [[nodiscard]] const Vertex& getVoxelSize() const;
+    [[nodiscard]] AABB getBounds() const;
+    [[nodiscard]] const std::string& getName() const;
+    void setName(const std::string& newName);
+
+    [[nodiscard]] bool isOccupied(unsigned int x, unsigned int y, unsigned int z) const;
+    void setOccupied(unsigned int x, unsigned int y, unsigned int z, bool occupied=true);
+    void setRowRange(unsigned int y, unsigned int z, unsigned int xBegin, unsigned int xEnd); // Occupy voxels [xBegin, xEnd) of a row
+    void setColumnRange(unsigned int x, unsigned int z, unsigned int yBegin, unsigned int yEnd); // Occupy voxels [yBegin, yEnd) along y
+
+    [[nodiscard]] size_t getOccupiedCount() const;
+    [[nodiscard]] float getVolume() const;
+
+    // The other grid is translated by the given number of voxels, both grids are assumed to share the same voxel size
+    [[nodiscard]] size_t getOverlapCount(const VoxelGrid& other, const glm::ivec3& otherOffset) const;
+    [[nodiscard]] bool intersects(const VoxelGrid& other, const glm::ivec3& otherOffset) const;
+
+    // True if each occupied voxel of this grid, translated by the given number of voxels, is occupied in the container
+    [[nodiscard]] bool isContainedIn(const VoxelGrid& container, const glm::ivec3& offset) const;
+
+private:
+    [[nodiscard]] const uint64_t* getRow(unsigned int y, unsigned int z) const;
+    [[nodiscard]] uint64_t* getRow(unsigned int y, unsigned int z);
+    [[nodiscard]] uint64_t extractBits(unsigned int y, unsigned int z, long long firstBit) const;
+
+    template<bool stopAtFirstOverlap>
+    [[nodiscard]] size_t countOverlap(const VoxelGrid& other, const glm::ivec3& otherOffset) const;
+};
+
+#endif //MESHCORE_VOXELGRID_H
@@ -7,7 +7,10 @@
 
 #include "ModelSpaceMesh.h"
 #include "Transformation.h"
+#include "OBB.h"
 #include <memory>
+#include <array>
+#include <atomic>
 
 class WorldSpaceMesh: public GJKConvexShape {
 
@@ -16,6 +19,16 @@ class WorldSpaceMesh: public GJKConvexShape {
     Transformation modelTransformation;
     std::shared_ptr<ModelSpaceMesh> modelSpaceMesh;
 
+    // Convex hull vertices found by the last tight AABB query, per axis maximum and minimum. They only serve as the start
+    // of the next query, so concurrent queries may overwrite each other's indices, the atomics keep this race benign
+    struct WarmStart {
+        std::array<std::atomic<size_t>, 6> indices{};
+        WarmStart() = default;
+        WarmStart(const WarmStart& other);
+        WarmStart& operator=(const WarmStart& other);
+    };
+    mutable WarmStart extremeHullVertexIndices;
+
 public:
     WorldSpaceMesh();
     explicit WorldSpaceMesh(const std::shared_ptr<ModelSpaceMesh>& modelSpaceMesh);
@@ -35,6 +48,8 @@ public:
     [[nodiscard]] std::shared_ptr<ModelSpaceMesh> getTransformedModelSpaceMesh() const;
 
     [[nodiscard]] AABB computeWorldSpaceAABB() const;
+    [[nodiscard]] AABB computeTightWorldSpaceAABB() const; // Same result, using support queries on the convex hull
+    [[nodiscard]] AABB computeConservativeWorldSpaceAABB() const; // Encloses the mesh, derived from its model space OBB
 
     [[nodiscard]] Transformation& getModelTransformation();
     [[nodiscard]] const Transformation& getModelTransformation() const;
@@ -122,7 +122,11 @@ public:
     }
 
     static OBB createOBB(const std::shared_ptr<ModelSpaceMesh>& modelSpaceMesh){
-        auto vertices = modelSpaceMesh->getVertices();
+        return createOBB(*modelSpaceMesh);
+    }
+
+    static OBB createOBB(const ModelSpaceMesh& modelSpaceMesh){
+        const auto& vertices = modelSpaceMesh.getVertices();
 
         // TODO
         // Try to create an optimal OBB if the number of vertices is limited
@@ -140,10 +144,10 @@ public:
         // TODO test if we can improve heuristically
 
         // Compare with the AABB of the model space mesh that is present anyway, use it if the OBB is worse
-        if(pcaOBB.getVolume() <= modelSpaceMesh->getBounds().getVolume()){
+        if(pcaOBB.getVolume() <= modelSpaceMesh.getBounds().getVolume()){
             return pcaOBB;
         }
-        else return {modelSpaceMesh->getBounds(), Quaternion()};
+        else return {modelSpaceMesh.getBounds(), Quaternion()};
     }
 
 private:
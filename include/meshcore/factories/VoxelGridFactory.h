@@ -0,0 +1,35 @@
+#ifndef MESHCORE_VOXELGRIDFACTORY_H
+#define MESHCORE_VOXELGRIDFACTORY_H
+
+#include <memory>
+#include <vector>
+#include "meshcore/core/ModelSpaceMesh.h"
+#include "meshcore/core/VoxelGrid.h"
+
+/**
+ * Voxelisation of meshes in their model space, with cubic voxels aligned to multiples of the voxel size.
+ *
+ * Grids of meshes voxelised with the same voxel size therefore share their lattice, so their overlap under integer voxel
+ * translations is meaningful. The surface grid marks each voxel crossed by a triangle, exactly with the box-triangle test.
+ * The solid grid marks each voxel whose center lies inside the mesh, by casting one ray per row of voxels through the
+ * mesh's cached bounding volume hierarchy and filling the spans where the winding number is positive. The ray enters
+ * the mesh through front faces and leaves through back faces, so overlapping closed parts fill their union.
+ * Both work in parallel over slabs of rows along the z-axis, which never share words of the grid.
+ */
+class VoxelGridFactory {
+public:
+    static std::shared_ptr<VoxelGrid> createSurfaceVoxelGrid(const std::shared_ptr<ModelSpaceMesh>& modelSpaceMesh, float voxelSize);
+
+    // The solid voxelisation of a mesh that's not closed is undefined, including the surface also marks each voxel crossed by a triangle
+    static std::shared_ptr<VoxelGrid> createSolidVoxelGrid(const std::shared_ptr<ModelSpaceMesh>& modelSpaceMesh, float voxelSize, bool includeSurface=false);
+    static std::vector<std::shared_ptr<VoxelGrid>> createSolidVoxelGrids(const std::vector<std::shared_ptr<ModelSpaceMesh>>& modelSpaceMeshes, float voxelSize, bool includeSurface=false);
+
+    // Voxel size that spans the longest side of the mesh's bounds with the given number of voxels
+    static float computeVoxelSize(const ModelSpaceMesh& modelSpaceMesh, unsigned int resolution);
+
+private:
+    static std::shared_ptr<VoxelGrid> createEmptyVoxelGrid(const ModelSpaceMesh& modelSpaceMesh, float voxelSize);
+    static void addSurfaceVoxels(const ModelSpaceMesh& modelSpaceMesh, VoxelGrid& voxelGrid);
+};
+
+#endif //MESHCORE_VOXELGRIDFACTORY_H
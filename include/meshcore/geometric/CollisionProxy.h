@@ -0,0 +1,46 @@
+#ifndef MESHCORE_COLLISIONPROXY_H
+#define MESHCORE_COLLISIONPROXY_H
+
+#include <atomic>
+#include <memory>
+#include "meshcore/core/ModelSpaceMesh.h"
+
+struct CollisionProxyParameters {
+    size_t targetTriangles = 300; // Meshes with at most this many triangles are their own proxy
+    float minimumInflation = 0.0f; // Absolute offset the proxy keeps at least from the mesh
+    unsigned int maximumAttempts = 8; // The inflation grows by half after each attempt that doesn't enclose the mesh, the convex hull is used after the last one
+};
+
+/**
+ * Simplified closed mesh that encloses a (detailed) mesh, to reject collisions early.
+ *
+ * The mesh, or its convex hull if the mesh isn't closed and manifold, is simplified with quadric error edge collapses
+ * down to the target number of triangles. The simplified mesh is then offset along its vertex normals until no
+ * triangle of the mesh crosses its surface and all vertices of the mesh lie inside, which is verified exactly.
+ * If the mesh can't be enclosed this way, the convex hull of the mesh is used as its proxy.
+ */
+class CollisionProxy {
+    std::shared_ptr<ModelSpaceMesh> mesh;
+    float inflation = 0.0f;
+    bool simplified = false;
+
+public:
+    explicit CollisionProxy(const ModelSpaceMesh& modelSpaceMesh, const CollisionProxyParameters& parameters={});
+
+    [[nodiscard]] const std::shared_ptr<ModelSpaceMesh>& getMesh() const;
+    [[nodiscard]] float getInflation() const; // Offset of the simplified mesh along its vertex normals
+    [[nodiscard]] bool isSimplified() const; // False if the proxy is a copy of the mesh or its convex hull
+};
+
+/** Counters of proxy-first collision tests, can be shared between threads **/
+struct CollisionProxyStatistics {
+    std::atomic<size_t> boundsRejections{0}; // Pairs separated by their conservative AABBs, before testing the proxies
+    std::atomic<size_t> proxyTests{0}; // Pairs tested on their proxies first
+    std::atomic<size_t> rejections{0}; // Pairs separated by their proxies, for which the full test was avoided
+    std::atomic<size_t> fullTests{0}; // Pairs tested on the full meshes
+
+    [[nodiscard]] float getRejectionRate() const; // Fraction of the proxy tests that avoided the full test
+    void reset();
+};
+
+#endif //MESHCORE_COLLISIONPROXY_H
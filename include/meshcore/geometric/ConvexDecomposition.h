@@ -0,0 +1,51 @@
+#ifndef MESHCORE_CONVEXDECOMPOSITION_H
+#define MESHCORE_CONVEXDECOMPOSITION_H
+
+#include <memory>
+#include <vector>
+#include "meshcore/core/ModelSpaceMesh.h"
+#include "meshcore/core/Transformation.h"
+
+struct ConvexDecompositionParameters {
+    float concavityTolerance = 0.02f; // Volume of the pieces' hulls in excess of the mesh, relative to the mesh's volume, that is accepted per piece
+    size_t maximumPieces = 32;
+    unsigned int volumeResolution = 32; // Voxels along the longest side of the solid voxelisation used to estimate the mesh's volume inside each region
+};
+
+/**
+ * Approximate convex decomposition of a closed mesh, for GJK-based collision and distance queries.
+ *
+ * The mesh's bounding box is split recursively by axis aligned planes, each time splitting the region whose convex hull
+ * exceeds the mesh the most, at the plane that minimises the volume of the two resulting hulls. Each piece is the
+ * convex hull of the mesh clipped to its region, so the pieces together enclose the mesh. Splitting stops when each
+ * piece is within the concavity tolerance or when the maximum number of pieces is reached.
+ * The pieces are organised in a small bounding volume hierarchy, with a single piece per leaf.
+ */
+class ConvexDecomposition {
+public:
+    struct Node {
+        AABB bounds;
+        bool split = false;
+        unsigned int firstChildOrPieceIndex = 0;
+    };
+
+private:
+    std::vector<std::shared_ptr<ModelSpaceMesh>> pieces;
+    std::vector<Node> nodes;
+    float concavity = 0.0f;
+
+    void buildTree();
+    void computeWorldSpaceBounds(const Transformation& transformation, std::vector<AABB>& worldSpaceBounds) const;
+
+public:
+    explicit ConvexDecomposition(const ModelSpaceMesh& modelSpaceMesh, const ConvexDecompositionParameters& parameters={});
+
+    [[nodiscard]] const std::vector<std::shared_ptr<ModelSpaceMesh>>& getPieces() const;
+    [[nodiscard]] const std::vector<Node>& getNodes() const;
+    [[nodiscard]] float getConcavity() const; // Largest concavity of a piece, relative to the mesh's volume
+
+    [[nodiscard]] bool intersects(const Transformation& transformation, const ConvexDecomposition& other, const Transformation& otherTransformation) const;
+    [[nodiscard]] float computeDistance(const Transformation& transformation, const ConvexDecomposition& other, const Transformation& otherTransformation) const; // Zero if the pieces intersect
+};
+
+#endif //MESHCORE_CONVEXDECOMPOSITION_H
@@ -35,6 +35,8 @@ namespace Distance {
 
     float distance(const WorldSpaceMesh& worldSpaceMeshA, const WorldSpaceMesh& worldSpaceMeshB, Vertex* closestVertexA, Vertex* closestVertexB);
 
+    float distanceConvexDecompositions(const WorldSpaceMesh& worldSpaceMeshA, const WorldSpaceMesh& worldSpaceMeshB); // Approximate, using the cached convex decompositions of both meshes
+
 }
 
 #endif //MESHCORE_DISTANCE_H
\ No newline at end of file
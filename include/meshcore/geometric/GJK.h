@@ -37,6 +37,7 @@ public:
     static std::optional<float> computeDistanceSqr(const GJKConvexShape &shapeA, const GJKConvexShape &shapeB);
     static bool hasSeparation(const GJKConvexShape &shapeA, const GJKConvexShape &shapeB, float minimumSeparationDistanceSqr=0.0f);
     static std::optional<std::pair<Vertex,Vertex>> computeClosestPoints(const GJKConvexShape &shapeA, const GJKConvexShape &shapeB);
+    static float computePenetrationDepth(const GJKConvexShape &shapeA, const GJKConvexShape &shapeB, glm::vec3* penetrationNormal=nullptr); // Implemented in EPA.cpp
 
 private:
 
@@ -150,6 +151,20 @@ public:
     [[nodiscard]] glm::vec3 getCenter() const override;
 };
 
+class ModelSpaceMesh;
+class Transformation;
+
+/** Convex mesh under a transformation, with support queries warm-started from the previous result. Both are referenced, not copied **/
+class GJKTransformedMesh: public GJKConvexShape {
+    const ModelSpaceMesh& mesh;
+    const Transformation& transformation;
+    mutable size_t supportIndex = 0;
+public:
+    GJKTransformedMesh(const ModelSpaceMesh& mesh, const Transformation& transformation);
+    [[nodiscard]] glm::vec3 computeSupport(const glm::vec3 &direction) const override;
+    [[nodiscard]] glm::vec3 getCenter() const override;
+};
+
 class GJKSphere: public GJKConvexShape {
     Vertex center;
     float radius;
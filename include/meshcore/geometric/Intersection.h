@@ -14,12 +14,15 @@
 #include "meshcore/core/Plane.h"
 
 struct AABBTriangleData; // Forward declaration for TriangleAABBData
+struct OrientedMesh;
+struct CollisionProxyStatistics;
 
 namespace Intersection{
 
     // Ray-Triangle
     bool intersect(const Ray& ray, const VertexTriangle& triangle);
     float intersectionDistance(const Ray& ray, const VertexTriangle& triangle);
+    float intersectionDistance(const Ray& ray, const VertexTriangle& triangle, glm::vec2& barycentricCoordinates); // Also the weights of the second and third vertex, set only on a hit
 
     // Triangle-Triangle
     bool intersect(const VertexTriangle& triangleA, const VertexTriangle& triangleB);
@@ -64,7 +67,11 @@ namespace Intersection{
     // Mesh-Mesh
     bool debugIntersects(const WorldSpaceMesh& worldSpaceMeshA, const WorldSpaceMesh& worldSpaceMeshB);
     bool intersect(const WorldSpaceMesh& worldSpaceMeshA, const WorldSpaceMesh& worldSpaceMeshB);
+    bool intersect(const std::shared_ptr<ModelSpaceMesh>& modelSpaceMeshA, const Transformation& transformationA, const std::shared_ptr<ModelSpaceMesh>& modelSpaceMeshB, const Transformation& transformationB);
+    bool intersectProxyFirst(const WorldSpaceMesh& worldSpaceMeshA, const WorldSpaceMesh& worldSpaceMeshB, CollisionProxyStatistics* statistics=nullptr); // Exact, rejects early using the conservative AABBs and the cached collision proxies of both meshes
     bool inside(const WorldSpaceMesh& worldSpaceMeshA, const WorldSpaceMesh& worldSpaceMeshB);
+    bool intersectConvexDecompositions(const WorldSpaceMesh& worldSpaceMeshA, const WorldSpaceMesh& worldSpaceMeshB); // Approximate, using the cached convex decompositions of both meshes
+    bool intersect(const OrientedMesh& orientedMeshA, const glm::vec3& positionA, const OrientedMesh& orientedMeshB, const glm::vec3& positionB, float scale=1.0f);
 
     // Plane
     std::optional<Line> intersect(const Plane& planeA, const Plane& planeB);
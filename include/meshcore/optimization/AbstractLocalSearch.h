@@ -8,17 +8,15 @@
 #include <memory>
 #include <type_traits>
 #include <functional>
+#include <stdexcept>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include "meshcore/utility/random.h"
 #include "meshcore/optimization/AbstractSolution.h"
 
-template <class Solution>
-class ObjectiveFunction {
-    static_assert(std::is_base_of_v<AbstractSolution, Solution>, "ObjectiveFunction template type should be a solution derived from AbstractSolution class");
-public:
-    virtual ~ObjectiveFunction() = default;
-    [[nodiscard]] virtual float evaluate(std::shared_ptr<const Solution> s) const = 0;
-};
-
 template <class Solution>
 class Move {
     static_assert(std::is_base_of_v<AbstractSolution, Solution>, "Move template type should be a solution derived from AbstractSolution class");
@@ -26,6 +24,28 @@ public:
 	virtual ~Move()= default;
 	virtual void doMove(std::shared_ptr<Solution> solution) = 0;
 	virtual void undoMove(std::shared_ptr<Solution> solution) = 0;
+
+    // Appends the indices of the items changed by this move, returns false if they aren't known. Callers can reuse
+    // the vector between moves, so collecting the items doesn't allocate once it has grown large enough
+    virtual bool appendAffectedItems(std::vector<size_t>& /*affectedItems*/) const {
+        return false;
+    }
+};
+
+template <class Solution>
+class ObjectiveFunction {
+    static_assert(std::is_base_of_v<AbstractSolution, Solution>, "ObjectiveFunction template type should be a solution derived from AbstractSolution class");
+public:
+    virtual ~ObjectiveFunction() = default;
+    [[nodiscard]] virtual float evaluate(std::shared_ptr<const Solution> s) const = 0;
+
+    // Optional incremental evaluation, returning the change in score caused by a move that was just applied to the solution
+    [[nodiscard]] virtual bool supportsDeltaEvaluation() const {
+        return false;
+    }
+    [[nodiscard]] virtual float evaluateDelta(const Solution& /*solution*/, const Move<Solution>& /*move*/, float /*previousScore*/) const {
+        throw std::runtime_error("Objective function does not support delta evaluation");
+    }
 };
 
 template <class S>
@@ -34,7 +54,12 @@ class MoveFactory {
 public:
 	virtual ~MoveFactory()= default;
     [[nodiscard]] virtual std::shared_ptr<Move<S>> sample(const std::shared_ptr<const S>& s, const Random& random, float stepSize) const = 0;
-    virtual std::vector<std::shared_ptr<Move<S>>> listMoves(const std::shared_ptr<const S>& s, float stepSize) const {
+
+    // Sample a move into the given one, factories can override this to reuse its allocation when they created it
+    virtual void sampleInto(std::shared_ptr<Move<S>>& move, const std::shared_ptr<const S>& s, const Random& random, float stepSize) const {
+        move = this->sample(s, random, stepSize);
+    }
+    virtual std::vector<std::shared_ptr<Move<S>>> listMoves(const std::shared_ptr<const S>& /*s*/, float /*stepSize*/) const {
         return {};
     };
 };
@@ -94,17 +119,39 @@ public:
     }
 };
 
+/** When listeners are told about the current solution, new best solutions are always reported **/
+enum class ListenerNotification {
+    EveryIteration,
+    IterationInterval,  // Every N iterations
+    TimeInterval,       // At most once per time interval
+    OnlyImprovements    // Never report the current solution
+};
+
 template <class S>
 class AbstractLocalSearch {
     static_assert(std::is_base_of_v<AbstractSolution, S>, "AbstractLocalSearch template type should be a solution derived from AbstractSolution class");
     std::vector<std::shared_ptr<AbstractLocalSearchListener<S>>> listeners;
+
+    // Additional termination criteria, a value of zero disables them
+    std::chrono::milliseconds timeBudget{0};
+    unsigned int maximumIterationsWithoutImprovement = 0;
+    unsigned int checkInterval = 64; // Clock based criteria are only evaluated every checkInterval iterations
+
+    ListenerNotification listenerNotification = ListenerNotification::EveryIteration;
+    unsigned int notificationIterationInterval = 1;
+    std::chrono::milliseconds notificationTimeInterval{0};
+
 protected:
-    bool stopped = false;
+    std::atomic<bool> stopped{false};
     const unsigned int maximumIterations;
     const ObjectiveFunction<S>& objectiveFunction;
     const MoveFactory<S>& moveFactory;
     const Random& random;
 
+    // Current solution at the moment the last search ended, so a search can be resumed from it
+    std::shared_ptr<S> finalSolution;
+    float finalScore = 0.0f;
+
 public:
     AbstractLocalSearch(MoveFactory<S>& moveFactory, const ObjectiveFunction<S>& objectiveFunction, unsigned int maximumIterations, const Random& random):
     maximumIterations(maximumIterations),
@@ -117,6 +164,60 @@ public:
         this->stopped = true;
     }
 
+    void setTimeBudget(std::chrono::milliseconds budget) {
+        this->timeBudget = budget;
+    }
+
+    [[nodiscard]] std::chrono::milliseconds getTimeBudget() const {
+        return timeBudget;
+    }
+
+    void setMaximumIterationsWithoutImprovement(unsigned int iterations) {
+        this->maximumIterationsWithoutImprovement = iterations;
+    }
+
+    void setCheckInterval(unsigned int iterations) {
+        this->checkInterval = std::max(1u, iterations);
+    }
+
+    [[nodiscard]] unsigned int getCheckInterval() const {
+        return checkInterval;
+    }
+
+    void notifyEveryIteration() {
+        this->listenerNotification = ListenerNotification::EveryIteration;
+    }
+
+    void notifyEveryIterations(unsigned int iterations) {
+        this->listenerNotification = ListenerNotification::IterationInterval;
+        this->notificationIterationInterval = std::max(1u, iterations);
+    }
+
+    void notifyEveryInterval(std::chrono::milliseconds interval) {
+        this->listenerNotification = ListenerNotification::TimeInterval;
+        this->notificationTimeInterval = interval;
+    }
+
+    void notifyOnlyImprovements() {
+        this->listenerNotification = ListenerNotification::OnlyImprovements;
+    }
+
+    [[nodiscard]] unsigned int getMaximumIterations() const {
+        return maximumIterations;
+    }
+
+    [[nodiscard]] const ObjectiveFunction<S>& getObjectiveFunction() const {
+        return objectiveFunction;
+    }
+
+    [[nodiscard]] const std::shared_ptr<S>& getFinalSolution() const {
+        return finalSolution;
+    }
+
+    [[nodiscard]] float getFinalScore() const {
+        return finalScore;
+    }
+
     std::shared_ptr<S> executeSearch(std::shared_ptr<S> initialSolution){
 
         // Initialize algorithm specific data structures
@@ -132,22 +233,43 @@ public:
 
         // Notify listeners and start optimization loop
         this->notifyListenersStarted(currentSolution, currentScore);
-        for (int currentIteration=0; currentIteration < maximumIterations; ++currentIteration){
+        using Clock = std::chrono::steady_clock;
+        const auto startTime = Clock::now();
+        auto lastNotificationTime = startTime;
+        unsigned int lastImprovementIteration = 0;
+        for (unsigned int currentIteration=0; currentIteration < maximumIterations; ++currentIteration){
 
             if(stopped) break;
+            if(maximumIterationsWithoutImprovement > 0 && currentIteration - lastImprovementIteration >= maximumIterationsWithoutImprovement) break;
+
+            // Only read the clock every few iterations
+            const bool checkClock = currentIteration % checkInterval == 0;
+            const auto now = checkClock ? Clock::now() : Clock::time_point();
+            if(checkClock && timeBudget.count() > 0 && now - startTime >= timeBudget) break;
 
             currentScore = performIteration(currentIteration, currentSolution, currentScore);
-            assert(currentScore == objectiveFunction.evaluate(currentSolution));
-            this->notifyListenersFoundNewCurrentSolution(currentSolution, currentScore, bestSolution, bestScore, currentIteration);
+            assert(scoresMatch(currentScore, objectiveFunction.evaluate(currentSolution)) && "Incrementally maintained score should match a full evaluation");
 
-            // Check if we improved on the best solution
+            if(!listeners.empty() && this->shouldNotifyCurrentSolution(currentIteration, checkClock, now, lastNotificationTime)){
+                this->notifyListenersFoundNewCurrentSolution(currentSolution, currentScore, bestSolution, bestScore, currentIteration);
+            }
+
+            // Check if we improved on the best solution, overwriting the preallocated best solution if possible
+            // Listeners that keep the best solution beyond the callback should therefore clone it
             if(currentScore<bestScore){
                 bestScore = currentScore;
-                bestSolution = std::static_pointer_cast<S>(currentSolution->clone());
-                this->notifyListenersFoundNewBestSolution(bestSolution, bestScore, currentIteration);
+                lastImprovementIteration = currentIteration;
+                if(!bestSolution->copyStateFrom(*currentSolution)){
+                    bestSolution = std::static_pointer_cast<S>(currentSolution->clone());
+                }
+                if(!listeners.empty()){
+                    this->notifyListenersFoundNewBestSolution(bestSolution, bestScore, currentIteration);
+                }
             }
         }
 
+        this->finalSolution = currentSolution;
+        this->finalScore = currentScore;
         this->notifyListenersFinished(bestSolution, bestScore);
         return bestSolution;
     }
@@ -157,10 +279,48 @@ public:
         this->listeners.emplace_back(listener);
     }
 private:
+    bool shouldNotifyCurrentSolution(unsigned int currentIteration, bool checkedClock, std::chrono::steady_clock::time_point now, std::chrono::steady_clock::time_point& lastNotificationTime) const {
+        switch (listenerNotification) {
+            case ListenerNotification::EveryIteration:
+                return true;
+            case ListenerNotification::IterationInterval:
+                return currentIteration % notificationIterationInterval == 0;
+            case ListenerNotification::TimeInterval:
+                if(checkedClock && now - lastNotificationTime >= notificationTimeInterval){
+                    lastNotificationTime = now;
+                    return true;
+                }
+                return false;
+            case ListenerNotification::OnlyImprovements:
+            default:
+                return false;
+        }
+    }
+
     virtual float performIteration(unsigned int currentIteration, std::shared_ptr<S>& currentSolution, float currentScore) = 0;
     virtual void initialize(const std::shared_ptr<S>& initialSolution, float initialScore) = 0;
 
 protected:
+
+    /**
+     * @brief Score of a solution to which the given move was just applied.
+     *
+     * Uses the objective's delta evaluation when supported, falling back to a full evaluation otherwise.
+     */
+    float evaluateMove(const std::shared_ptr<S>& solution, const Move<S>& move, float previousScore) const {
+        if(objectiveFunction.supportsDeltaEvaluation()){
+            const auto score = previousScore + objectiveFunction.evaluateDelta(*solution, move, previousScore);
+            assert(scoresMatch(score, objectiveFunction.evaluate(solution)) && "Delta evaluation should match a full evaluation");
+            return score;
+        }
+        return objectiveFunction.evaluate(solution);
+    }
+
+    // Scores maintained by delta evaluation can drift slightly from a full evaluation due to rounding
+    static bool scoresMatch(float score, float evaluatedScore){
+        return std::abs(score - evaluatedScore) <= 1e-4f * std::max(1.0f, std::abs(evaluatedScore));
+    }
+
     void notifyListenersFinished(std::shared_ptr<const S> solution, float score){
         for(const auto& listener: listeners){
             listener->finished(solution, score);
@@ -202,6 +362,13 @@ public:
             (*it)->undoMove(solution);
         }
     }
+
+    bool appendAffectedItems(std::vector<size_t>& affectedItems) const override {
+        for(const auto& move : moves){
+            if(!move->appendAffectedItems(affectedItems)) return false; // Unknown for one of the moves, so unknown for the composite
+        }
+        return true;
+    }
 };
 
 template <class S>
@@ -225,16 +392,13 @@ public:
 
 //    [[nodiscard]] virtual std::shared_ptr<Move<S>> sample(std::shared_ptr<const S> s, const Random& random) const = 0;
     std::shared_ptr<Move<S>> sample(const std::shared_ptr<const S>& s, const Random& random, float stepSize) const override {
-		int idx;
-		if(probabilities.empty()){
-            idx = random.nextInteger(0, moveFactories.size()-1);
-		}
-		else{
-			idx = rouletteWheel(probabilities, random);
-		}
-		return moveFactories.at(idx)->sample(s, random, stepSize);
+		return moveFactories.at(selectFactory(random))->sample(s, random, stepSize);
 	}
 
+    void sampleInto(std::shared_ptr<Move<S>>& move, const std::shared_ptr<const S>& s, const Random& random, float stepSize) const override {
+        moveFactories.at(selectFactory(random))->sampleInto(move, s, random, stepSize);
+    }
+
     std::vector<std::shared_ptr<Move<S>>>
     listMoves(const std::shared_ptr<const S>& s, float stepSize) const override {
         std::vector<std::shared_ptr<Move<S>>> moves;
@@ -246,6 +410,13 @@ public:
     }
 
 private:
+    int selectFactory(const Random& random) const {
+        if(probabilities.empty()){
+            return random.nextInteger(0, moveFactories.size()-1);
+        }
+        return rouletteWheel(probabilities, random);
+    }
+
     /** Returns a random index with given probabilities **/
     static int rouletteWheel(const std::vector<float>& probabilities, const Random& random){
         float rnd = random.nextFloat();
@@ -0,0 +1,158 @@
+#ifndef MESHCORE_ABSTRACTSAMPLINGSEARCH_H
+#define MESHCORE_ABSTRACTSAMPLINGSEARCH_H
+
+#include <chrono>
+#include "AbstractLocalSearch.h"
+
+/**
+ * Step size adaptation and reheating shared by the sampling searches.
+ *
+ * Every adaptationInterval iterations, the step size is multiplied by adaptationFactor when more moves than the target
+ * acceptance rate were accepted and divided by it otherwise, within [minimumStepSize, maximumStepSize].
+ * After reheatAfter iterations without improving the best score (0 disables it), the search is reheated.
+ */
+struct SamplingSearchParameters {
+    float initialStepSize = 1.0f;
+    float minimumStepSize = 1e-3f;
+    float maximumStepSize = 10.0f;
+    float targetAcceptanceRate = 0.3f;
+    float adaptationFactor = 1.1f;
+    unsigned int adaptationInterval = 100;
+    unsigned int reheatAfter = 0;
+    std::chrono::milliseconds scheduleDuration{0}; // Cooling schedules follow wall-clock time instead of iterations when positive, defaults to the search's time budget
+    bool requireFeasibility = true; // Reject moves that make the solution infeasible
+};
+
+/**
+ * Base class for searches that sample a single move per iteration and decide whether to keep it.
+ *
+ * Extended classes only implement the acceptance criterion, as a function of the schedule's progress in [0, 1].
+ */
+template <class S>
+class AbstractSamplingSearch: public AbstractLocalSearch<S> {
+
+    const SamplingSearchParameters parameters;
+    std::shared_ptr<const S> constCurrentSolution; // Avoids converting the current solution's shared_ptr for each sample
+    std::shared_ptr<Move<S>> move; // Sampled into each iteration, so factories supporting it don't allocate a new move
+    std::chrono::steady_clock::time_point startTime;
+    float elapsedProgress = 0.0f; // Fraction of a time-based schedule that elapsed, refreshed every checkInterval iterations
+    float stepSize = 1.0f;
+    float bestScore = 0.0f;
+    float reheatProgress = 0.0f;
+    unsigned int acceptedMoves = 0;
+    unsigned int sampledMoves = 0;
+    unsigned int lastImprovementIteration = 0;
+    unsigned int reheats = 0;
+
+public:
+    AbstractSamplingSearch(MoveFactory<S>& moveFactory, const ObjectiveFunction<S>& objectiveFunction, unsigned int maximumIterations, const Random& random, const SamplingSearchParameters& parameters):
+    AbstractLocalSearch<S>(moveFactory, objectiveFunction, maximumIterations, random),
+    parameters(parameters){}
+
+    [[nodiscard]] float getStepSize() const {
+        return stepSize;
+    }
+
+    [[nodiscard]] unsigned int getReheats() const {
+        return reheats;
+    }
+
+protected:
+    /** Decides whether a move that changes the score from currentScore to newScore is kept **/
+    virtual bool accept(float newScore, float currentScore, unsigned int currentIteration, float progress) = 0;
+    virtual void initializeAcceptance(float /*initialScore*/) {}
+    virtual void moveAccepted(float /*newScore*/, float /*previousScore*/, unsigned int /*currentIteration*/) {}
+    virtual void moveRejected(float /*currentScore*/, unsigned int /*currentIteration*/) {}
+    virtual void reheat(float /*currentScore*/) {}
+
+    /**
+     * @brief Progress of the schedule since the last reheat, in [0, 1].
+     *
+     * Time-based schedules only read the clock every checkInterval iterations, like the clock based termination criteria.
+     */
+    [[nodiscard]] float computeProgress(unsigned int currentIteration) {
+        float progress;
+        const auto scheduleDuration = parameters.scheduleDuration.count() > 0 ? parameters.scheduleDuration : this->getTimeBudget();
+        if(scheduleDuration.count() > 0){
+            if(currentIteration % this->getCheckInterval() == 0){
+                const std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+                elapsedProgress = elapsed.count() / static_cast<float>(scheduleDuration.count());
+            }
+            progress = elapsedProgress;
+        }
+        else {
+            progress = static_cast<float>(currentIteration) / static_cast<float>(std::max(1u, this->maximumIterations));
+        }
+        progress = std::min(1.0f, progress);
+        return reheatProgress < 1.0f ? std::max(0.0f, (progress - reheatProgress) / (1.0f - reheatProgress)) : 1.0f;
+    }
+
+private:
+    void initialize(const std::shared_ptr<S>& /*initialSolution*/, float initialScore) override {
+        startTime = std::chrono::steady_clock::now();
+        elapsedProgress = 0.0f;
+        stepSize = parameters.initialStepSize;
+        bestScore = initialScore;
+        reheatProgress = 0.0f;
+        acceptedMoves = 0;
+        sampledMoves = 0;
+        lastImprovementIteration = 0;
+        reheats = 0;
+        constCurrentSolution.reset();
+        initializeAcceptance(initialScore);
+    }
+
+    float performIteration(unsigned int currentIteration, std::shared_ptr<S>& currentSolution, float currentScore) override {
+        if(constCurrentSolution != currentSolution){
+            constCurrentSolution = currentSolution;
+        }
+
+        const auto progress = computeProgress(currentIteration);
+        this->moveFactory.sampleInto(move, constCurrentSolution, this->random, stepSize);
+        move->doMove(currentSolution);
+        const auto newScore = this->evaluateMove(currentSolution, *move, currentScore);
+
+        sampledMoves++;
+        if(accept(newScore, currentScore, currentIteration, progress) && (!parameters.requireFeasibility || currentSolution->isFeasible())){
+            acceptedMoves++;
+            moveAccepted(newScore, currentScore, currentIteration);
+            currentScore = newScore;
+            if(currentScore < bestScore){
+                bestScore = currentScore;
+                lastImprovementIteration = currentIteration;
+            }
+        }
+        else {
+            move->undoMove(currentSolution);
+            moveRejected(currentScore, currentIteration);
+        }
+
+        if(sampledMoves == parameters.adaptationInterval){
+            adaptStepSize();
+        }
+
+        if(parameters.reheatAfter > 0 && currentIteration - lastImprovementIteration >= parameters.reheatAfter){
+            lastImprovementIteration = currentIteration;
+            reheatProgress = computeProgress(currentIteration) * (1.0f - reheatProgress) + reheatProgress;
+            stepSize = parameters.initialStepSize;
+            reheats++;
+            reheat(currentScore);
+        }
+
+        return currentScore;
+    }
+
+    void adaptStepSize() {
+        const auto acceptanceRate = static_cast<float>(acceptedMoves) / static_cast<float>(sampledMoves);
+        if(acceptanceRate > parameters.targetAcceptanceRate){
+            stepSize = std::min(parameters.maximumStepSize, stepSize * parameters.adaptationFactor);
+        }
+        else {
+            stepSize = std::max(parameters.minimumStepSize, stepSize / parameters.adaptationFactor);
+        }
+        acceptedMoves = 0;
+        sampledMoves = 0;
+    }
+};
+
+#endif //MESHCORE_ABSTRACTSAMPLINGSEARCH_H
@@ -11,6 +11,12 @@ struct AbstractSolution{
     virtual ~AbstractSolution() = default;
     [[nodiscard]] virtual bool isFeasible() const = 0;
     [[nodiscard]] virtual std::shared_ptr<AbstractSolution> clone() const = 0;
+
+    // Overwrite the state of this solution with that of a solution of the same type in place, without allocating
+    // Returns false if not supported for the given solution, callers should clone instead
+    virtual bool copyStateFrom(const AbstractSolution& /*other*/) {
+        return false;
+    }
 };
 
 #endif //MESHCORE_ABSTRACTSOLUTION_H
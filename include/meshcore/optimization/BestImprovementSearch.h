@@ -0,0 +1,97 @@
+#ifndef MESHCORE_BESTIMPROVEMENTSEARCH_H
+#define MESHCORE_BESTIMPROVEMENTSEARCH_H
+
+#include <limits>
+#include <tbb/parallel_reduce.h>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/task_arena.h>
+#include "AbstractLocalSearch.h"
+
+/**
+ * Steepest descent over the full neighbourhood given by MoveFactory::listMoves.
+ *
+ * The listed moves are evaluated concurrently, each thread applying them to its own replica of the current solution,
+ * which is synchronised through AbstractSolution::copyStateFrom at the start of each iteration. The best move is
+ * then applied to the current solution. Ties are broken on the position in the move list, so the result does not
+ * depend on the number of threads. The search stops in a local optimum, when no listed move improves the score.
+ * Each range of moves is evaluated in an isolated task region: objectives may run parallel loops themselves, and a
+ * thread waiting on those must not pick up another range that would use its replica while a move is applied to it.
+ */
+template <class S>
+class BestImprovementSearch: public AbstractLocalSearch<S> {
+
+    struct Replica {
+        std::shared_ptr<S> solution;
+        unsigned int version = 0;
+    };
+
+    struct Candidate {
+        float score = std::numeric_limits<float>::infinity();
+        size_t moveIndex = std::numeric_limits<size_t>::max();
+
+        [[nodiscard]] bool isBetterThan(const Candidate& other) const {
+            return score < other.score || (score == other.score && moveIndex < other.moveIndex);
+        }
+    };
+
+    const float stepSize;
+    const bool requireFeasibility;
+    tbb::enumerable_thread_specific<Replica> replicas;
+    unsigned int currentVersion = 0;
+
+public:
+    BestImprovementSearch(MoveFactory<S>& moveFactory, const ObjectiveFunction<S>& objectiveFunction, unsigned int maximumIterations, const Random& random, float stepSize, bool requireFeasibility=true):
+    AbstractLocalSearch<S>(moveFactory, objectiveFunction, maximumIterations, random),
+    stepSize(stepSize),
+    requireFeasibility(requireFeasibility){}
+
+private:
+    void initialize(const std::shared_ptr<S>& /*initialSolution*/, float /*initialScore*/) override {
+        replicas.clear();
+    }
+
+    float performIteration(unsigned int /*currentIteration*/, std::shared_ptr<S>& currentSolution, float currentScore) override {
+        const auto moves = this->moveFactory.listMoves(currentSolution, stepSize);
+        currentVersion++;
+
+        const auto best = tbb::parallel_reduce(tbb::blocked_range<size_t>(0, moves.size()), Candidate(),
+            [&](const tbb::blocked_range<size_t>& range, Candidate candidate){
+                return tbb::this_task_arena::isolate([&]{
+                    auto& replica = replicas.local();
+                    if(!replica.solution){
+                        replica.solution = std::static_pointer_cast<S>(currentSolution->clone());
+                    }
+                    else if(replica.version != currentVersion && !replica.solution->copyStateFrom(*currentSolution)){
+                        replica.solution = std::static_pointer_cast<S>(currentSolution->clone());
+                    }
+                    replica.version = currentVersion;
+
+                    for(size_t moveIndex = range.begin(); moveIndex < range.end(); ++moveIndex){
+                        const auto& move = moves[moveIndex];
+                        move->doMove(replica.solution);
+                        const Candidate moveCandidate{this->evaluateMove(replica.solution, *move, currentScore), moveIndex};
+                        if(moveCandidate.isBetterThan(candidate) && (!requireFeasibility || replica.solution->isFeasible())){
+                            candidate = moveCandidate;
+                        }
+                        move->undoMove(replica.solution);
+                    }
+                    return candidate;
+                });
+            },
+            [](const Candidate& first, const Candidate& second){
+                return first.isBetterThan(second) ? first : second;
+            });
+
+        if(!(best.score < currentScore)){
+            this->stop(); // Local optimum reached
+            return currentScore;
+        }
+
+        const auto& bestMove = moves[best.moveIndex];
+        bestMove->doMove(currentSolution);
+        return this->evaluateMove(currentSolution, *bestMove, currentScore);
+    }
+};
+
+#endif //MESHCORE_BESTIMPROVEMENTSEARCH_H
@@ -0,0 +1,46 @@
+#ifndef MESHCORE_BOTTOMLEFTFILL_H
+#define MESHCORE_BOTTOMLEFTFILL_H
+
+#include "StripPackingSolution.h"
+
+/** Order in which the items are inserted, ties are broken on the item index **/
+enum class ItemOrder {
+    AsGiven,
+    DecreasingVolume,
+    DecreasingHeight, // Height of the item's AABB in its original orientation
+    DecreasingBaseArea // Area of the item's AABB in the xy-plane, in its original orientation
+};
+
+struct BottomLeftFillParameters {
+    ItemOrder itemOrder = ItemOrder::DecreasingVolume;
+    std::vector<Quaternion> orientations = {Quaternion()}; // Rotations an item can be placed in, those equivalent due to symmetry are only tried once
+    float clearance = 1e-4f; // Gap left between an item and the AABBs it is placed against, as touching meshes count as intersecting
+    unsigned int dropIterations = 8; // Bisection steps lowering an item below the top of the AABBs it rests on
+    float heightmapCellSize = 0.0f; // Resolution of the heightmap that bounds the drop height of each candidate, chosen automatically when not positive
+    bool useOrientationCache = true; // Attach an orientation cache of the orientation set to the solution if it has none, collision tests between items then only involve a translation
+};
+
+/**
+ * Constructive heuristic for the strip packing problem, producing a compact feasible start for local searches.
+ *
+ * Items are inserted one by one. Candidate positions in the xy-plane are the container's corner and the points right
+ * of and behind the AABBs of the items placed so far. For each candidate position and orientation, the item is dropped
+ * to the lowest height where it doesn't intersect the placed items, checked against the tops of the AABBs below it
+ * and then refined through bisection. A heightmap of the placed items gives a height at which the item certainly fits,
+ * so the exact intersection tests are limited to the levels below it. The candidate with the lowest item, then lowest y and x, is kept.
+ * Candidates are evaluated in parallel, the result doesn't depend on the number of threads.
+ */
+class BottomLeftFill {
+    const BottomLeftFillParameters parameters;
+
+public:
+    explicit BottomLeftFill(BottomLeftFillParameters parameters={});
+
+    [[nodiscard]] std::shared_ptr<StripPackingSolution> construct(const std::shared_ptr<StripPackingProblem>& problem) const;
+    void construct(StripPackingSolution& solution) const; // Overwrites the transformations of all items in the solution
+
+    [[nodiscard]] std::vector<size_t> computeItemOrder(const StripPackingSolution& solution) const;
+    [[nodiscard]] static std::vector<Quaternion> getAxisAlignedOrientations(); // The 24 rotations mapping the axes onto each other
+};
+
+#endif //MESHCORE_BOTTOMLEFTFILL_H
@@ -0,0 +1,50 @@
+#ifndef MESHCORE_LATEACCEPTANCEHILLCLIMBING_H
+#define MESHCORE_LATEACCEPTANCEHILLCLIMBING_H
+
+#include "AbstractSamplingSearch.h"
+
+/**
+ * Late acceptance hill climbing (Burke and Bykov), keeping a move if it is no worse than the current score
+ * or than the current score of historyLength iterations ago.
+ * A reheat refills the history with the initial score, which relaxes the acceptance criterion like a restarted schedule.
+ */
+template <class S>
+class LateAcceptanceHillClimbing: public AbstractSamplingSearch<S> {
+
+    std::vector<float> history;
+    float initialScore = 0.0f;
+
+public:
+    LateAcceptanceHillClimbing(MoveFactory<S>& moveFactory, const ObjectiveFunction<S>& objectiveFunction, unsigned int maximumIterations, const Random& random,
+                               size_t historyLength, const SamplingSearchParameters& parameters = {}):
+    AbstractSamplingSearch<S>(moveFactory, objectiveFunction, maximumIterations, random, parameters),
+    history(historyLength){
+        if(historyLength == 0){
+            throw std::invalid_argument("Late acceptance hill climbing requires a history of at least one iteration");
+        }
+    }
+
+protected:
+    void initializeAcceptance(float score) override {
+        initialScore = score;
+        std::fill(history.begin(), history.end(), initialScore);
+    }
+
+    bool accept(float newScore, float currentScore, unsigned int currentIteration, float /*progress*/) override {
+        return newScore <= currentScore || newScore <= history[currentIteration % history.size()];
+    }
+
+    void moveAccepted(float newScore, float /*previousScore*/, unsigned int currentIteration) override {
+        history[currentIteration % history.size()] = newScore;
+    }
+
+    void moveRejected(float currentScore, unsigned int currentIteration) override {
+        history[currentIteration % history.size()] = currentScore;
+    }
+
+    void reheat(float currentScore) override {
+        std::fill(history.begin(), history.end(), std::max(currentScore, initialScore));
+    }
+};
+
+#endif //MESHCORE_LATEACCEPTANCEHILLCLIMBING_H
@@ -0,0 +1,198 @@
+#ifndef MESHCORE_PARALLELLOCALSEARCH_H
+#define MESHCORE_PARALLELLOCALSEARCH_H
+
+#include <atomic>
+#include <mutex>
+#include <tuple>
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
+#include "AbstractLocalSearch.h"
+
+/**
+ * Runs several independent local searches (replicas) concurrently on a TBB arena.
+ *
+ * Each replica owns its search, its own Random stream (split from the seed) and its own copy of the solution. Replicas run for a number of
+ * epochs, each epoch being one executeSearch call that resumes from the state the replica ended the previous epoch in.
+ * Without temperatures this is a plain multi-start search. When a temperature is given for each replica, adjacent
+ * replicas exchange their states between epochs following the parallel tempering acceptance criterion, the searches
+ * created by the factory are expected to use the temperature of their replica.
+ *
+ * The best solution over all replicas is published without locks. Listeners receive started and finished events of
+ * the whole run and every improvement of the global best, serialised over the replicas. Per-replica current solution
+ * events are not forwarded.
+ */
+template <class S>
+class ParallelLocalSearch {
+    static_assert(std::is_base_of_v<AbstractSolution, S>, "ParallelLocalSearch template type should be a solution derived from AbstractSolution class");
+public:
+    using SearchFactory = std::function<std::shared_ptr<AbstractLocalSearch<S>>(size_t replicaIndex, const Random& random)>;
+
+private:
+    struct BestEntry {
+        std::shared_ptr<const S> solution;
+        float score;
+        unsigned int epoch;
+        size_t replicaIndex;
+
+        // Ties are broken on epoch and replica, so the published best doesn't depend on the order in which replicas finish
+        [[nodiscard]] bool isBetterThan(const BestEntry& other) const {
+            return std::tie(score, epoch, replicaIndex) < std::tie(other.score, other.epoch, other.replicaIndex);
+        }
+    };
+
+    struct Replica {
+        std::unique_ptr<Random> random;
+        std::shared_ptr<AbstractLocalSearch<S>> search;
+        std::shared_ptr<S> solution;
+        float score = 0.0f;
+    };
+
+    const SearchFactory searchFactory;
+    const size_t numberOfReplicas;
+    const unsigned int numberOfEpochs;
+    const std::vector<float> temperatures;
+    const int seed;
+    const int maximumConcurrency;
+
+    std::vector<std::shared_ptr<AbstractLocalSearchListener<S>>> listeners;
+    std::mutex listenerMutex;
+    std::shared_ptr<const BestEntry> globalBest; // Only accessed through std::atomic_load and std::atomic_compare_exchange_strong
+    std::atomic<bool> stopped{false};
+    std::vector<Replica> replicas;
+    unsigned int currentEpoch = 0;
+    size_t acceptedExchanges = 0;
+
+public:
+    /**
+     * @param searchFactory Creates the search of a replica, the given Random outlives the search
+     * @param temperatures Empty for independent multi-start, otherwise one temperature per replica, enabling state exchanges
+     * @param maximumConcurrency Number of threads of the arena, tbb::task_arena::automatic uses all available cores
+     */
+    ParallelLocalSearch(SearchFactory searchFactory, size_t numberOfReplicas, unsigned int numberOfEpochs=1, std::vector<float> temperatures={}, int seed=0, int maximumConcurrency=tbb::task_arena::automatic):
+    searchFactory(std::move(searchFactory)),
+    numberOfReplicas(numberOfReplicas),
+    numberOfEpochs(numberOfEpochs),
+    temperatures(std::move(temperatures)),
+    seed(seed),
+    maximumConcurrency(maximumConcurrency){
+        if(!this->temperatures.empty() && this->temperatures.size() != numberOfReplicas){
+            throw std::invalid_argument("ParallelLocalSearch requires either no temperatures or one temperature per replica");
+        }
+    }
+
+    void stop() {
+        this->stopped = true;
+        for(const auto& replica: replicas){
+            replica.search->stop();
+        }
+    }
+
+    void addListener(std::shared_ptr<AbstractLocalSearchListener<S>> listener){
+        this->listeners.emplace_back(listener);
+    }
+
+    [[nodiscard]] size_t getAcceptedExchanges() const {
+        return acceptedExchanges;
+    }
+
+    std::shared_ptr<S> executeSearch(const std::shared_ptr<S>& initialSolution){
+        this->stopped = false;
+        this->acceptedExchanges = 0;
+        this->initializeReplicas(initialSolution);
+
+        const auto initialScore = replicas.front().score;
+        std::atomic_store(&globalBest, std::make_shared<const BestEntry>(BestEntry{std::static_pointer_cast<const S>(initialSolution->clone()), initialScore, 0, 0}));
+        for(const auto& listener: listeners){
+            listener->started(initialSolution, initialScore);
+        }
+
+        Random exchangeRandom(seed);
+        tbb::task_arena arena(maximumConcurrency);
+        for(currentEpoch = 0; currentEpoch < numberOfEpochs && !stopped; ++currentEpoch){
+            arena.execute([&](){
+                tbb::parallel_for(size_t(0), numberOfReplicas, [&](size_t replicaIndex){
+                    auto& replica = replicas[replicaIndex];
+                    replica.search->executeSearch(replica.solution);
+                    replica.solution = replica.search->getFinalSolution();
+                    replica.score = replica.search->getFinalScore();
+                });
+            });
+            if(!temperatures.empty()){
+                this->exchangeStates(currentEpoch, exchangeRandom);
+            }
+        }
+
+        const auto best = std::atomic_load(&globalBest);
+        auto bestSolution = std::static_pointer_cast<S>(best->solution->clone());
+        for(const auto& listener: listeners){
+            listener->finished(bestSolution, best->score);
+        }
+        return bestSolution;
+    }
+
+private:
+    void initializeReplicas(const std::shared_ptr<S>& initialSolution){
+        replicas.clear();
+        replicas.resize(numberOfReplicas);
+
+        // Replica streams are split sequentially from the seed, independent of the number of threads
+        Random seedRandom(seed);
+        for(size_t replicaIndex = 0; replicaIndex < numberOfReplicas; ++replicaIndex){
+            auto& replica = replicas[replicaIndex];
+            replica.random = std::make_unique<Random>(seedRandom.split());
+            replica.search = searchFactory(replicaIndex, *replica.random);
+            replica.solution = std::static_pointer_cast<S>(initialSolution->clone());
+
+            // Publish improvements of this replica, clones are only made when the global best improves
+            auto listener = std::make_shared<LocalSearchListener<S>>();
+            const auto epochLength = replica.search->getMaximumIterations();
+            listener->setOnNewBestSolutionFound([this, epochLength, replicaIndex](std::shared_ptr<const S> solution, float score, unsigned int iteration){
+                this->publish(solution, score, replicaIndex, currentEpoch * epochLength + iteration);
+            });
+            replica.search->addListener(listener);
+        }
+
+        const auto initialScore = replicas.front().search->getObjectiveFunction().evaluate(initialSolution);
+        for(auto& replica: replicas){
+            replica.score = initialScore;
+        }
+    }
+
+    void publish(const std::shared_ptr<const S>& solution, float score, size_t replicaIndex, unsigned int iteration){
+        auto current = std::atomic_load(&globalBest);
+        const BestEntry key{nullptr, score, currentEpoch + 1, replicaIndex}; // The initial solution is published as epoch 0
+        if(!key.isBetterThan(*current)){
+            return;
+        }
+        const auto candidate = std::make_shared<const BestEntry>(BestEntry{std::static_pointer_cast<const S>(solution->clone()), score, key.epoch, replicaIndex});
+        while(candidate->isBetterThan(*current)){
+            if(std::atomic_compare_exchange_strong(&globalBest, &current, candidate)){
+                std::lock_guard<std::mutex> lock(listenerMutex);
+
+                // Another replica may have published an even better solution meanwhile, listeners only see improvements
+                if(std::atomic_load(&globalBest) == candidate){
+                    for(const auto& listener: listeners){
+                        listener->foundNewBestSolution(candidate->solution, score, iteration);
+                    }
+                }
+                return;
+            }
+        }
+    }
+
+    /** Metropolis exchange between adjacent temperatures, alternating even and odd pairs over the epochs **/
+    void exchangeStates(unsigned int epoch, const Random& exchangeRandom){
+        for(size_t first = epoch % 2; first + 1 < numberOfReplicas; first += 2){
+            auto& firstReplica = replicas[first];
+            auto& secondReplica = replicas[first + 1];
+            const auto exponent = (1.0f / temperatures[first] - 1.0f / temperatures[first + 1]) * (firstReplica.score - secondReplica.score);
+            if(exponent >= 0.0f || exchangeRandom.nextFloat() < std::exp(exponent)){
+                std::swap(firstReplica.solution, secondReplica.solution);
+                std::swap(firstReplica.score, secondReplica.score);
+                acceptedExchanges++;
+            }
+        }
+    }
+};
+
+#endif //MESHCORE_PARALLELLOCALSEARCH_H
@@ -0,0 +1,41 @@
+#ifndef MESHCORE_SIMULATEDANNEALING_H
+#define MESHCORE_SIMULATEDANNEALING_H
+
+#include "AbstractSamplingSearch.h"
+
+/**
+ * Simulated annealing with a geometric cooling schedule from the initial to the final temperature.
+ * Worse moves are accepted with probability exp(-delta / temperature), a reheat restarts the schedule.
+ */
+template <class S>
+class SimulatedAnnealing: public AbstractSamplingSearch<S> {
+
+    const float initialTemperature;
+    const float finalTemperature;
+    float temperature;
+
+public:
+    SimulatedAnnealing(MoveFactory<S>& moveFactory, const ObjectiveFunction<S>& objectiveFunction, unsigned int maximumIterations, const Random& random,
+                       float initialTemperature, float finalTemperature, const SamplingSearchParameters& parameters = {}):
+    AbstractSamplingSearch<S>(moveFactory, objectiveFunction, maximumIterations, random, parameters),
+    initialTemperature(initialTemperature),
+    finalTemperature(finalTemperature),
+    temperature(initialTemperature){
+        if(initialTemperature <= 0.0f || finalTemperature <= 0.0f){
+            throw std::invalid_argument("Simulated annealing temperatures should be positive");
+        }
+    }
+
+    [[nodiscard]] float getTemperature() const {
+        return temperature;
+    }
+
+protected:
+    bool accept(float newScore, float currentScore, unsigned int /*currentIteration*/, float progress) override {
+        temperature = initialTemperature * std::pow(finalTemperature / initialTemperature, progress);
+        const auto delta = newScore - currentScore;
+        return delta <= 0.0f || this->random.nextFloat() < std::exp(-delta / temperature);
+    }
+};
+
+#endif //MESHCORE_SIMULATEDANNEALING_H
@@ -5,12 +5,17 @@
 #ifndef SINGLEVOLUMEMAXIMISATIONPROBLEM_H
 #define SINGLEVOLUMEMAXIMISATIONPROBLEM_H
 
+#include <optional>
 #include "AbstractSolution.h"
 #include "meshcore/core/WorldSpaceMesh.h"
+#include "meshcore/acceleration/SignedDistanceField.h"
 
 class SingleVolumeMaximisationSolution: public AbstractSolution {
     std::shared_ptr<WorldSpaceMesh> itemWorldSpaceMesh;
     std::shared_ptr<WorldSpaceMesh> containerWorldSpaceMesh;
+    std::shared_ptr<const SignedDistanceField> containerDistanceField; // Optional, in the container's model space, shared between clones
+
+    [[nodiscard]] std::optional<bool> isContainedByDistanceField() const; // Empty if the field's bounds aren't decisive
 
 public:
     SingleVolumeMaximisationSolution(const std::shared_ptr<WorldSpaceMesh>& itemWorldSpaceMesh,
@@ -18,9 +23,12 @@ public:
 
     [[nodiscard]] const std::shared_ptr<WorldSpaceMesh>& getItemWorldSpaceMesh() const;
     [[nodiscard]] const std::shared_ptr<WorldSpaceMesh>& getContainerWorldSpaceMesh() const;
+    [[nodiscard]] const std::shared_ptr<const SignedDistanceField>& getContainerDistanceField() const;
+    void setContainerDistanceField(const std::shared_ptr<const SignedDistanceField>& distanceField); // Feasibility checks skip the container's tree when the field decides them, e.g. the container mesh's getSignedDistanceField()
 
     [[nodiscard]] bool isFeasible() const override;
     [[nodiscard]] std::shared_ptr<AbstractSolution> clone() const override;
+    bool copyStateFrom(const AbstractSolution& other) override; // Copies the transformations and the distance field
 };
 
 
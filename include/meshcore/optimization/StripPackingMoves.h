@@ -0,0 +1,37 @@
+#ifndef MESHCORE_STRIPPACKINGMOVES_H
+#define MESHCORE_STRIPPACKINGMOVES_H
+
+#include "AbstractLocalSearch.h"
+#include "StripPackingSolution.h"
+
+/** Replaces the transformation of a single item **/
+class StripPackingItemTransformationMove: public Move<StripPackingSolution> {
+    size_t itemIndex;
+    Transformation newTransformation;
+    Transformation oldTransformation;
+
+public:
+    StripPackingItemTransformationMove(size_t itemIndex, const Transformation& newTransformation);
+
+    void doMove(std::shared_ptr<StripPackingSolution> solution) override;
+    void undoMove(std::shared_ptr<StripPackingSolution> solution) override;
+    bool appendAffectedItems(std::vector<size_t>& affectedItems) const override;
+
+    void assign(size_t newItemIndex, const Transformation& transformation); // Reuse this move for another item or transformation
+
+    [[nodiscard]] size_t getItemIndex() const;
+    [[nodiscard]] const Transformation& getNewTransformation() const;
+    [[nodiscard]] const Transformation& getOldTransformation() const; // Only valid after doMove
+};
+
+/** Translates a single item, by a random offset of at most stepSize along each axis when sampled **/
+class StripPackingTranslationMoveFactory: public MoveFactory<StripPackingSolution> {
+public:
+    [[nodiscard]] std::shared_ptr<Move<StripPackingSolution>> sample(const std::shared_ptr<const StripPackingSolution>& solution, const Random& random, float stepSize) const override;
+    void sampleInto(std::shared_ptr<Move<StripPackingSolution>>& move, const std::shared_ptr<const StripPackingSolution>& solution, const Random& random, float stepSize) const override;
+
+    // Translations of each item by stepSize along the positive and negative axes
+    std::vector<std::shared_ptr<Move<StripPackingSolution>>> listMoves(const std::shared_ptr<const StripPackingSolution>& solution, float stepSize) const override;
+};
+
+#endif //MESHCORE_STRIPPACKINGMOVES_H
@@ -0,0 +1,41 @@
+#ifndef MESHCORE_STRIPPACKINGOBJECTIVES_H
+#define MESHCORE_STRIPPACKINGOBJECTIVES_H
+
+#include "AbstractLocalSearch.h"
+#include "StripPackingSolution.h"
+
+/** Minimise the height of the packing, i.e. the highest point of the items' AABBs **/
+class StripPackingHeightObjective: public ObjectiveFunction<StripPackingSolution> {
+public:
+    [[nodiscard]] float evaluate(std::shared_ptr<const StripPackingSolution> solution) const override;
+
+    // Only the AABBs of the items affected by the move are queried, unless the top item was lowered
+    [[nodiscard]] bool supportsDeltaEvaluation() const override;
+    [[nodiscard]] float evaluateDelta(const StripPackingSolution& solution, const Move<StripPackingSolution>& move, float previousScore) const override;
+};
+
+/**
+ * Height of the packing plus a weighted penalty for infeasibility, allowing searches to move through infeasible solutions.
+ *
+ * The penalty sums the penetration depth (GJK + EPA on the convex hulls) of each pair of items with overlapping AABBs,
+ * and the distance each item's AABB protrudes from the container. Pairs are evaluated in parallel.
+ * A feasible solution with non-convex items can still have a positive penalty, as the hulls of its items may overlap.
+ */
+class StripPackingOverlapObjective: public ObjectiveFunction<StripPackingSolution> {
+    float overlapWeight;
+
+public:
+    explicit StripPackingOverlapObjective(float overlapWeight=10.0f);
+
+    [[nodiscard]] float evaluate(std::shared_ptr<const StripPackingSolution> solution) const override;
+    [[nodiscard]] float computePenalty(const StripPackingSolution& solution) const;
+
+    // Moves of a single item only reevaluate the pairs containing that item, other moves fall back to a full evaluation
+    [[nodiscard]] bool supportsDeltaEvaluation() const override;
+    [[nodiscard]] float evaluateDelta(const StripPackingSolution& solution, const Move<StripPackingSolution>& move, float previousScore) const override;
+
+private:
+    [[nodiscard]] static float computeItemPenalty(const StripPackingSolution& solution, size_t itemIndex, const Transformation& transformation);
+};
+
+#endif //MESHCORE_STRIPPACKINGOBJECTIVES_H
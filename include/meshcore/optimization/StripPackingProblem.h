@@ -46,6 +46,10 @@ public:
     static std::shared_ptr<StripPackingProblem> fromFilePath(const std::string& instancePath, ObjectOrigin itemOrigin=ObjectOrigin::AlignToCenter);
     static Color getItemColor(const std::string& itemName);
 
+    // Precompiled binary bundle containing the meshes and their derived data (convex hulls, bounds, volumes, BVHs)
+    void saveBundle(const std::string& bundlePath) const;
+    static std::shared_ptr<StripPackingProblem> loadBundle(const std::string& bundlePath);
+
     [[nodiscard]] const AABB &getContainer() const;
     [[nodiscard]] const std::vector<std::shared_ptr<ModelSpaceMesh>>& getRequiredItems() const;
     [[nodiscard]] const std::vector<size_t>& getRequiredItemCounts() const;
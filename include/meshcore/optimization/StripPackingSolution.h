@@ -9,42 +9,83 @@
 #include "StripPackingProblem.h"
 #include "meshcore/core/WorldSpaceMesh.h"
 #include "meshcore/factories/AABBFactory.h"
+#include "meshcore/acceleration/Heightmap.h"
+#include "meshcore/acceleration/OrientationCache.h"
+#include "meshcore/geometric/CollisionProxy.h"
+#include <array>
 
 /*
  * Simple solution class for the strip packing problem.
  * Contains basic reference feasibility check, but should be overridden by more specific solutions.
+ *
+ * Item state is stored as contiguous arrays (type, position, rotation, scale and world space AABB per item),
+ * which keeps clones small and feasibility sweeps cache friendly. WorldSpaceMesh views of the items are only
+ * created when requested through getItem(s), and are kept in sync with the item transformations afterwards.
+ *
+ * The const queries fill the AABBs, views and total height lazily, so they must not run concurrently on the same solution.
+ * After prepareCaches (and getItems for the views), the queries only read until the next transformation is set.
  */
 class StripPackingSolution: public AbstractSolution {
 
     std::shared_ptr<StripPackingProblem> problem;
-    std::vector<std::shared_ptr<WorldSpaceMesh>> items;
-    std::vector<std::string> itemNames;
-    mutable std::vector<std::optional<AABB>> cachedAABBs;
+    std::shared_ptr<const std::vector<size_t>> itemTypes; // Index of each item in problem->getRequiredItems(), shared between clones
+    std::shared_ptr<const std::vector<std::shared_ptr<WorldSpaceMesh>>> itemPrototypes; // Shared between clones, so item ids remain the same
+
+    std::vector<glm::vec3> positions;
+    std::vector<Quaternion> rotations;
+    std::vector<float> scales;
+
+    mutable std::vector<AABB> itemAABBs;
+    mutable std::vector<unsigned char> validItemAABBs;
+    mutable std::vector<std::array<size_t, 6>> extremeHullVertexIndices; // Warm start for the support queries of each item's AABB
+    mutable std::vector<std::shared_ptr<WorldSpaceMesh>> itemViews; // Created on demand, never copied between solutions
+    mutable std::optional<float> cachedTotalHeight; // Running maximum of the items' AABBs, kept up to date as long as the top item doesn't move
+    mutable std::shared_ptr<Heightmap> heightmap; // Created on demand, never copied between solutions
+    std::shared_ptr<OrientationCache> orientationCache; // Optional, shared between clones
+    bool useCollisionProxies = false; // Collision tests go through the items' proxies first
+    std::shared_ptr<CollisionProxyStatistics> collisionProxyStatistics; // Optional, shared between clones, only gathered while the proxies are used
     /**
      * Precomputed maximum height of all items stacked vertically.
      */
-    float maxHeight;
-//test
+    float maxHeight = 0.0f;
+
+    [[nodiscard]] AABB computeItemAABB(size_t itemIndex) const;
+    void synchroniseItemView(size_t itemIndex) const;
+
+protected:
+    void copyStripPackingStateFrom(const StripPackingSolution& other); // Copies the item transformations and cached data
 
 public:
     explicit StripPackingSolution(const std::shared_ptr<StripPackingProblem>& problem);
     StripPackingSolution(const StripPackingSolution& other);
 
-    [[nodiscard]] const std::vector<std::shared_ptr<WorldSpaceMesh>>& getItems() const;
-    [[nodiscard]] const std::shared_ptr<WorldSpaceMesh>& getItem(size_t itemIndex) const;
+    [[nodiscard]] size_t getNumberOfItems() const;
+    [[nodiscard]] const std::vector<std::shared_ptr<WorldSpaceMesh>>& getItems() const; // Creates the views of all items
+    [[nodiscard]] const std::shared_ptr<WorldSpaceMesh>& getItem(size_t itemIndex) const; // View of the item, only modify it through setItemTransformation
+    [[nodiscard]] size_t getItemType(size_t itemIndex) const;
+    [[nodiscard]] const std::shared_ptr<ModelSpaceMesh>& getItemModelSpaceMesh(size_t itemIndex) const;
     [[nodiscard]] const std::string& getItemName(size_t itemIndex) const;
-    [[nodiscard]] const size_t getItemIndexByName(const std::string& name) const;
-    [[nodiscard]] const size_t getItemIndexByID(const std::string& id) const;
+    [[nodiscard]] size_t getItemIndexByName(const std::string& name) const;
+    [[nodiscard]] size_t getItemIndexByID(const std::string& id) const;
     [[nodiscard]] const AABB& getItemAABB(size_t itemIndex) const;
     [[nodiscard]] const std::shared_ptr<StripPackingProblem>& getProblem() const;
-    [[nodiscard]] const Transformation& getItemTransformation(size_t itemIndex) const;
-    [[nodiscard]] const float getMaxHeight() const;
+    [[nodiscard]] Transformation getItemTransformation(size_t itemIndex) const;
+    [[nodiscard]] float getMaxHeight() const;
+    [[nodiscard]] const Heightmap& getHeightmap() const; // Top surface of all items, kept in sync with the item transformations once created
+    [[nodiscard]] const std::shared_ptr<OrientationCache>& getOrientationCache() const;
+    void setOrientationCache(const std::shared_ptr<OrientationCache>& cache); // Item AABBs and collision tests use the orientations prepared in the cache, other orientations aren't added to it
+    [[nodiscard]] const std::shared_ptr<CollisionProxyStatistics>& getCollisionProxyStatistics() const;
+    void setCollisionProxyStatistics(const std::shared_ptr<CollisionProxyStatistics>& statistics);
+    [[nodiscard]] bool isUsingCollisionProxies() const;
+    void setUseCollisionProxies(bool use); // Tests collisions against the items' proxies first, rejecting most separated pairs early
 
     [[nodiscard]] float computeTotalHeight() const;
+    void prepareCaches() const; // Computes all item AABBs and the total height, e.g. before querying them from multiple threads
 
     // Inherited from AbstractSolution
     [[nodiscard]] bool isFeasible() const override;
     [[nodiscard]] std::shared_ptr<AbstractSolution> clone() const override;
+    bool copyStateFrom(const AbstractSolution& other) override; // Only for solutions of exactly this type, extended classes should override it
 
     // Functions that can be overridden in extended classes
     virtual void setItemTransformation(size_t itemIndex, const Transformation& transformation);
@@ -0,0 +1,34 @@
+#ifndef MESHCORE_THRESHOLDACCEPTING_H
+#define MESHCORE_THRESHOLDACCEPTING_H
+
+#include "AbstractSamplingSearch.h"
+
+/**
+ * Threshold accepting (Dueck and Scheuer), keeping any move that worsens the score by at most the current threshold.
+ * The threshold decreases linearly from its initial value to zero, a reheat restarts the schedule.
+ */
+template <class S>
+class ThresholdAccepting: public AbstractSamplingSearch<S> {
+
+    const float initialThreshold;
+    float threshold;
+
+public:
+    ThresholdAccepting(MoveFactory<S>& moveFactory, const ObjectiveFunction<S>& objectiveFunction, unsigned int maximumIterations, const Random& random,
+                       float initialThreshold, const SamplingSearchParameters& parameters = {}):
+    AbstractSamplingSearch<S>(moveFactory, objectiveFunction, maximumIterations, random, parameters),
+    initialThreshold(initialThreshold),
+    threshold(initialThreshold){}
+
+    [[nodiscard]] float getThreshold() const {
+        return threshold;
+    }
+
+protected:
+    bool accept(float newScore, float currentScore, unsigned int /*currentIteration*/, float progress) override {
+        threshold = initialThreshold * (1.0f - progress);
+        return newScore - currentScore <= threshold;
+    }
+};
+
+#endif //MESHCORE_THRESHOLDACCEPTING_H
@@ -10,11 +10,14 @@
 #include <memory>
 
 #include "meshcore/core/ModelSpaceMesh.h"
+#include "meshcore/core/VoxelGrid.h"
 
 class FileParser {
 public:
     static std::shared_ptr<ModelSpaceMesh> loadMeshFile(const std::string& filePath);
     static void saveFile(const std::string& filePath, const std::shared_ptr<ModelSpaceMesh>&);
+    static std::shared_ptr<VoxelGrid> loadVoxelFile(const std::string& filePath); // Occupancy grid of a .binvox file, without triangulating it
+    static void saveVoxelFile(const std::string& filePath, const VoxelGrid& voxelGrid); // As a .binvox file, padded to a cube
 
     static void clearCache();
 
@@ -27,7 +30,9 @@ private:
     static std::shared_ptr<ModelSpaceMesh> parseFileSTL(const std::string& filePath);
     static std::shared_ptr<ModelSpaceMesh> parseFileOBJ(const std::string& filePath);
     static std::shared_ptr<ModelSpaceMesh> parseFileBinvox(const std::string& filePath);
+    static std::shared_ptr<VoxelGrid> parseVoxelGridBinvox(const std::string& filePath);
     static void saveFileOBJ(const std::string& filePath, const std::shared_ptr<ModelSpaceMesh>& mesh);
+    static void saveFileBinvox(const std::string& filePath, const VoxelGrid& voxelGrid);
     static std::shared_ptr<ModelSpaceMesh> parseFileBinarySTL(const std::string &filePath);
 };
 
@@ -0,0 +1,36 @@
+#ifndef MESHCORE_MEMORYMAPPEDFILE_H
+#define MESHCORE_MEMORYMAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+/**
+ * @brief Read-only memory mapping of a complete file.
+ *
+ * The mapping is released when the object goes out of scope.
+ * Multiple processes mapping the same file share the pages in the operating system's page cache.
+ */
+class MemoryMappedFile {
+
+    const char* data = nullptr;
+    size_t size = 0;
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fileDescriptor = -1;
+#endif
+
+public:
+    explicit MemoryMappedFile(const std::string& filePath);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile& other) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile& other) = delete;
+
+    [[nodiscard]] const char* getData() const;
+    [[nodiscard]] size_t getSize() const;
+};
+
+#endif //MESHCORE_MEMORYMAPPEDFILE_H
@@ -0,0 +1,52 @@
+#ifndef MESHCORE_SLICER_H
+#define MESHCORE_SLICER_H
+
+#include <memory>
+#include <vector>
+#include "meshcore/core/WorldSpaceMesh.h"
+#include "meshcore/core/IndexTriangle.h"
+
+class StripPackingSolution;
+
+/** Polyline in the xy-plane of a layer, outer boundaries run counter-clockwise and holes clockwise **/
+struct SliceContour {
+    std::vector<glm::vec2> points; // The closing segment from the last point back to the first isn't repeated
+    bool closed = true; // Only open where the mesh isn't closed
+
+    [[nodiscard]] float computeSignedArea() const; // Positive for counter-clockwise contours
+};
+
+struct SliceLayer {
+    float height = 0.0f;
+    std::vector<SliceContour> contours;
+
+    [[nodiscard]] float computeArea() const; // Of the cross-section, holes subtracted
+};
+
+/**
+ * Cuts meshes with horizontal planes into the contours of their cross-sections.
+ *
+ * The meshes are transformed to world space once and the triangles are binned per plane they cross, found from the
+ * sorted plane heights with a binary search on each triangle's z-interval. Layers are then processed in parallel.
+ * Vertices exactly on a plane are considered above it, so each edge either crosses the plane or not, consistently for
+ * all its triangles. Contour segments are linked through the edges they cross rather than by comparing their endpoints,
+ * which keeps the contours of closed meshes closed regardless of rounding.
+ */
+class Slicer {
+    std::vector<Vertex> vertices; // Of all meshes, in world space
+    std::vector<IndexTriangle> triangles; // Indices into the combined vertices
+    AABB bounds;
+
+public:
+    explicit Slicer(const WorldSpaceMesh& worldSpaceMesh);
+    explicit Slicer(const std::vector<std::shared_ptr<WorldSpaceMesh>>& worldSpaceMeshes);
+    explicit Slicer(const StripPackingSolution& solution); // All items of the solution
+
+    [[nodiscard]] const AABB& getBounds() const;
+
+    [[nodiscard]] std::vector<SliceLayer> slice(float layerHeight) const; // Planes through the middle of each layer, starting at the bottom of the bounds
+    [[nodiscard]] std::vector<SliceLayer> slice(const std::vector<float>& heights) const; // Heights in ascending order
+    [[nodiscard]] SliceLayer sliceAt(float height) const;
+};
+
+#endif //MESHCORE_SLICER_H
@@ -5,34 +5,151 @@
 #ifndef MESHCORE_RANDOM_H
 #define MESHCORE_RANDOM_H
 
-#include <boost/random.hpp>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
 
+/**
+ * Pseudo random number generator based on xoshiro256** (Blackman and Vigna), with 32 bytes of state.
+ *
+ * A single instance is not synchronised, each thread should use its own stream. Independent streams are obtained
+ * through split(), which hands out the current stream and jumps this generator 2^128 draws ahead. Streams derived
+ * this way from a seeded generator are reproducible, regardless of the thread that ends up using them.
+ */
 class Random{
-    mutable boost::random::mt19937 randomEngine;
-    const boost::random::uniform_real_distribution<double> uniformDoubleDistribution{};
-    const boost::random::uniform_real_distribution<float> uniformFloatDistribution{};
+    mutable std::array<uint64_t, 4> state{};
+
+    static uint64_t rotateLeft(uint64_t value, int shift) {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+    static uint64_t splitMix64(uint64_t& value) {
+        uint64_t z = (value += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
 
 public:
-    explicit Random(int seed=0): randomEngine(seed){}
+    using result_type = uint64_t; // Satisfies UniformRandomBitGenerator, so it can be passed to std::shuffle and the like
+
+    explicit Random(uint64_t seed=0){
+        for(auto& word: state){
+            word = splitMix64(seed);
+        }
+    }
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()() const {
+        return nextBits();
+    }
+
+    uint64_t nextBits() const {
+        const uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotateLeft(state[3], 45);
+        return result;
+    }
+
+    /** Advances the generator by 2^128 draws **/
+    void jump() {
+        static constexpr uint64_t polynomial[] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+        std::array<uint64_t, 4> jumped{};
+        for(const auto word: polynomial){
+            for(int bit = 0; bit < 64; ++bit){
+                if(word & (uint64_t(1) << bit)){
+                    for(int i = 0; i < 4; ++i){
+                        jumped[i] ^= state[i];
+                    }
+                }
+                nextBits();
+            }
+        }
+        state = jumped;
+    }
+
+    /** Returns an independent generator continuing the current stream, this generator jumps ahead to a new stream **/
+    [[nodiscard]] Random split() {
+        Random result(*this);
+        jump();
+        return result;
+    }
 
     int nextInteger(int lowerBoundInclusive=0, int upperBoundInclusive=std::numeric_limits<int>::max()) const {
         assert(lowerBoundInclusive <= upperBoundInclusive && "The upper bound should be at least as great as the lower bound");
-        return boost::random::uniform_int_distribution<int>(lowerBoundInclusive, upperBoundInclusive)(randomEngine);
+        const auto range = static_cast<uint64_t>(static_cast<int64_t>(upperBoundInclusive) - lowerBoundInclusive) + 1;
+        return static_cast<int>(static_cast<int64_t>(lowerBoundInclusive) + static_cast<int64_t>(nextBounded(range)));
     }
 
     unsigned int nextUnsignedInteger(unsigned int lowerBoundInclusive=0u, unsigned int upperBoundInclusive=std::numeric_limits<unsigned int>::max()) const {
         assert(lowerBoundInclusive <= upperBoundInclusive && "The upper bound should be at least as great as the lower bound");
-        return boost::random::uniform_int_distribution<unsigned int>(lowerBoundInclusive, upperBoundInclusive)(randomEngine);
+        const auto range = static_cast<uint64_t>(upperBoundInclusive - lowerBoundInclusive) + 1;
+        return lowerBoundInclusive + static_cast<unsigned int>(nextBounded(range));
     }
 
     double nextDouble(double lowerBoundInclusive=0.0, double upperBoundExclusive=1.0) const {
         assert(lowerBoundInclusive < upperBoundExclusive && "The upper bound is exclusive and therefore must be greater than the lower bound");
-        return boost::random::uniform_real_distribution<double>(lowerBoundInclusive, upperBoundExclusive)(randomEngine);
+        const auto result = lowerBoundInclusive + toUnitDouble(nextBits()) * (upperBoundExclusive - lowerBoundInclusive);
+        return result < upperBoundExclusive ? result : std::nextafter(upperBoundExclusive, lowerBoundInclusive); // Guard against rounding up
     }
 
     float nextFloat(float lowerBoundInclusive=0.0f, float upperBoundExclusive=1.0f) const{
         assert(lowerBoundInclusive < upperBoundExclusive && "The upper bound is exclusive and therefore must be greater than the lower bound");
-        return boost::random::uniform_real_distribution<float>(lowerBoundInclusive, upperBoundExclusive)(randomEngine);
+        const auto result = lowerBoundInclusive + toUnitFloat(nextBits()) * (upperBoundExclusive - lowerBoundInclusive);
+        return result < upperBoundExclusive ? result : std::nextafter(upperBoundExclusive, lowerBoundInclusive); // Guard against rounding up
+    }
+
+    /** Fills the array with uniform floats, taking two floats from each 64-bit draw **/
+    void nextFloats(float* values, size_t count, float lowerBoundInclusive=0.0f, float upperBoundExclusive=1.0f) const {
+        assert(lowerBoundInclusive < upperBoundExclusive && "The upper bound is exclusive and therefore must be greater than the lower bound");
+        const auto width = upperBoundExclusive - lowerBoundInclusive;
+        const auto largest = std::nextafter(upperBoundExclusive, lowerBoundInclusive);
+        for(size_t i = 0; i < count; i += 2){
+            const auto bits = nextBits();
+            values[i] = std::min(largest, lowerBoundInclusive + toUnitFloat(bits) * width);
+            if(i + 1 < count){
+                values[i + 1] = std::min(largest, lowerBoundInclusive + toUnitFloat(bits << 32) * width);
+            }
+        }
+    }
+
+private:
+    /** Uniform value in [0, range), without modulo bias **/
+    uint64_t nextBounded(uint64_t range) const {
+        if(range == 0){
+            return nextBits(); // The full 64-bit range
+        }
+        const uint64_t threshold = (0 - range) % range; // 2^64 mod range
+        while(true){
+            const auto bits = nextBits();
+            if(bits >= threshold){
+                return bits % range;
+            }
+        }
+    }
+
+    // Only the upper bits are used, which are of the highest quality
+    static double toUnitDouble(uint64_t bits) {
+        return static_cast<double>(bits >> 11) * 0x1.0p-53;
+    }
+
+    static float toUnitFloat(uint64_t bits) {
+        return static_cast<float>(bits >> 40) * 0x1.0p-24f;
     }
 };
 
@@ -5,7 +5,10 @@
 #include "meshcore/acceleration/BoundingVolumeHierarchy.h"
 
 #include <numeric>
+#include <optional>
 #include <stack>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
 
 #include "meshcore/acceleration/CachingBoundsTreeFactory.h"
 #include "meshcore/acceleration/AABBVolumeHierarchy.h"
@@ -13,6 +16,42 @@
 
 #define STACK_DEPTH 128
 
+namespace {
+
+    // Inverse direction with infinite components replaced by large finite ones. Rays parallel to a slab and starting exactly
+    // on one of its planes would otherwise evaluate 0 * infinity, which makes them miss the bounds. The slab tests below
+    // are free of NaNs this way, so they don't need the NaN handling of fmin and fmax
+    glm::vec3 computeSafeInverseDirection(const Ray& ray) {
+        return glm::clamp(ray.inverseDirection, glm::vec3(-1e30f), glm::vec3(1e30f));
+    }
+
+    // Spreads the lowest 10 bits of the value to every third bit
+    uint32_t expandBits(uint32_t value) {
+        value = (value * 0x00010001u) & 0xFF0000FFu;
+        value = (value * 0x00000101u) & 0x0F00F00Fu;
+        value = (value * 0x00000011u) & 0xC30C30C3u;
+        value = (value * 0x00000005u) & 0x49249249u;
+        return value;
+    }
+
+    // Position of the point along a Morton curve through the bounds, 10 bits per axis
+    uint32_t computeMortonCode(const Vertex& point, const Vertex& minimum, const Vertex& inverseSize) {
+        const auto cell = glm::clamp((point - minimum) * inverseSize * 1024.0f, glm::vec3(0.0f), glm::vec3(1023.0f));
+        return (expandBits(static_cast<uint32_t>(cell.x)) << 2) | (expandBits(static_cast<uint32_t>(cell.y)) << 1) | expandBits(static_cast<uint32_t>(cell.z));
+    }
+
+    // Distance along the ray where it enters the bounds, clamped to zero, or infinity if it misses them before the maximum distance
+    float computeEntryDistance(const AABB& bounds, const Vertex& origin, const glm::vec3& inverseDirection, float maximumDistance) {
+        const auto t1 = (bounds.getMinimum() - origin) * inverseDirection;
+        const auto t2 = (bounds.getMaximum() - origin) * inverseDirection;
+        const auto entries = glm::min(t1, t2);
+        const auto exits = glm::max(t1, t2);
+        const auto tMin = std::max(std::max(0.0f, entries.x), std::max(entries.y, entries.z));
+        const auto tMax = std::min(std::min(maximumDistance, exits.x), std::min(exits.y, exits.z));
+        return tMax >= tMin ? tMin : std::numeric_limits<float>::infinity();
+    }
+}
+
 BoundingVolumeHierarchy::BoundingVolumeHierarchy(const std::shared_ptr<ModelSpaceMesh> &mesh) {
 
     // We use the default MeshCore BVH to construct this performance oriented one
@@ -49,39 +88,214 @@ BoundingVolumeHierarchy::BoundingVolumeHierarchy(const std::shared_ptr<ModelSpac
             }
         }
     }
+    initialiseTriangleBoundComponents();
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(std::vector<Node> nodes, std::vector<VertexTriangle> triangles):
+    triangles(std::move(triangles)), nodes(std::move(nodes)) {
+    assert(!this->nodes.empty() && "A bounding volume hierarchy should contain at least a root node");
+    initialiseTriangleBoundComponents();
+}
+
+void BoundingVolumeHierarchy::initialiseTriangleBoundComponents() {
+    const auto triangleCount = triangles.size();
+    triangleBoundComponents.resize(6 * triangleCount);
+    for (size_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex) {
+        for (int axis = 0; axis < 3; ++axis) {
+            triangleBoundComponents[axis * triangleCount + triangleIndex] = triangles[triangleIndex].bounds.getMinimum()[axis];
+            triangleBoundComponents[(3 + axis) * triangleCount + triangleIndex] = triangles[triangleIndex].bounds.getMaximum()[axis];
+        }
+    }
 }
 
 bool BoundingVolumeHierarchy::hitsBacksideFirst(const Ray &ray) const {
+    const auto hit = queryClosestHit(ray);
+    return hit && glm::dot(ray.direction, triangles[hit->triangleIndex].normal) > 0;
+}
+
+std::optional<BoundingVolumeHierarchy::RayHit> BoundingVolumeHierarchy::queryClosestHit(const Ray &ray, float maximumDistance) const {
 
+    unsigned int nodeIndexStack[STACK_DEPTH];
+    float entryDistanceStack[STACK_DEPTH];
+    int stackIndex = 0;
+    std::optional<RayHit> closestHit;
+    auto closestDistance = maximumDistance;
+    const auto inverseDirection = computeSafeInverseDirection(ray);
+
+    if (const auto rootEntry = computeEntryDistance(nodes[0].bounds, ray.origin, inverseDirection, closestDistance); rootEntry <= closestDistance) {
+        nodeIndexStack[stackIndex] = 0;
+        entryDistanceStack[stackIndex++] = rootEntry;
+    }
+    while (stackIndex > 0) {
+        --stackIndex;
+        if (entryDistanceStack[stackIndex] > closestDistance) {
+            continue; // A closer hit was found since the node was put on the stack
+        }
+        const auto& node = nodes[nodeIndexStack[stackIndex]];
+        if (node.split) {
+
+            // Visit the nearest child first, so hits found in it can cull the other one
+            const auto first = node.firstChildOrTriangleIndex;
+            float entries[2];
+            for (int i = 0; i < 2; ++i) {
+                entries[i] = computeEntryDistance(nodes[first + i].bounds, ray.origin, inverseDirection, closestDistance);
+            }
+            const int nearest = entries[1] < entries[0] ? 1 : 0;
+            for (const int i: {1 - nearest, nearest}) {
+                if (entries[i] <= closestDistance) {
+                    nodeIndexStack[stackIndex] = first + i;
+                    entryDistanceStack[stackIndex++] = entries[i];
+                }
+            }
+        }
+        else {
+            for (int i = 0; i < node.triangleCount; ++i) {
+                const auto triangleIndex = node.firstChildOrTriangleIndex + i;
+                glm::vec2 barycentricCoordinates;
+                const auto t = Intersection::intersectionDistance(ray, triangles[triangleIndex], barycentricCoordinates);
+                if (t > 0 && t < closestDistance) {
+                    closestDistance = t;
+                    closestHit = RayHit{t, barycentricCoordinates, triangleIndex};
+                }
+            }
+        }
+    }
+    return closestHit;
+}
+
+bool BoundingVolumeHierarchy::isOccluded(const Ray &ray, float maximumDistance) const {
+
+    const auto inverseDirection = computeSafeInverseDirection(ray);
     unsigned int stack[STACK_DEPTH];
     int stackIndex = 0;
     stack[stackIndex++] = 0; // Start with the root node
-    float closest_t = std::numeric_limits<float>::max();
-    bool closest_backside = false;
     while (stackIndex > 0) {
-        const auto nodeIndex = stack[--stackIndex];
-        const auto& node = nodes[nodeIndex];
-        if (Intersection::intersect(node.bounds, ray, 0.0f, closest_t)) {
+        const auto& node = nodes[stack[--stackIndex]];
+        if (computeEntryDistance(node.bounds, ray.origin, inverseDirection, maximumDistance) <= maximumDistance) {
             if (node.split) {
-                // Add its children to the stack
                 for (int i = 0; i < 2; ++i) {
                     stack[stackIndex++] = node.firstChildOrTriangleIndex + i;
                 }
             }
             else {
                 for (int i = 0; i < node.triangleCount; ++i) {
-                    const auto& triangle = triangles[node.firstChildOrTriangleIndex + i];
-                    if (const auto t = Intersection::intersectionDistance(ray, triangle); t > 0) {
-                        if (t < closest_t) {
-                            closest_t = t;
-                            closest_backside = glm::dot(ray.direction, triangle.normal) > 0;
+                    const auto t = Intersection::intersectionDistance(ray, triangles[node.firstChildOrTriangleIndex + i]);
+                    if (t > 0 && t < maximumDistance) {
+                        return true; // Any hit will do
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void BoundingVolumeHierarchy::queryClosestHits(const std::vector<Ray> &rays, std::vector<std::optional<RayHit>> &hits, float maximumDistance) const {
+
+    hits.assign(rays.size(), std::nullopt);
+    for (size_t packetStart = 0; packetStart < rays.size(); packetStart += PACKET_SIZE) {
+        const auto packetSize = static_cast<unsigned int>(std::min<size_t>(PACKET_SIZE, rays.size() - packetStart));
+
+        // Rays of the packet as structure of arrays, inactive lanes never hit anything
+        float originX[PACKET_SIZE], originY[PACKET_SIZE], originZ[PACKET_SIZE];
+        float inverseX[PACKET_SIZE], inverseY[PACKET_SIZE], inverseZ[PACKET_SIZE];
+        float closestDistances[PACKET_SIZE];
+        for (unsigned int lane = 0; lane < PACKET_SIZE; ++lane) {
+            const auto& ray = rays[packetStart + std::min(lane, packetSize - 1)];
+            const auto inverseDirection = computeSafeInverseDirection(ray);
+            originX[lane] = ray.origin.x;
+            originY[lane] = ray.origin.y;
+            originZ[lane] = ray.origin.z;
+            inverseX[lane] = inverseDirection.x;
+            inverseY[lane] = inverseDirection.y;
+            inverseZ[lane] = inverseDirection.z;
+            closestDistances[lane] = lane < packetSize ? maximumDistance : -1.0f;
+        }
+
+        glm::vec3 packetDirection(0.0f);
+        for (unsigned int lane = 0; lane < packetSize; ++lane) {
+            packetDirection += rays[packetStart + lane].direction;
+        }
+
+        // All rays of the packet descend together, a node is visited if it's hit by any of them
+        unsigned int stack[STACK_DEPTH];
+        int stackIndex = 0;
+        stack[stackIndex++] = 0;
+        while (stackIndex > 0) {
+            const auto& node = nodes[stack[--stackIndex]];
+            const auto& minimum = node.bounds.getMinimum();
+            const auto& maximum = node.bounds.getMaximum();
+            unsigned int mask = 0;
+            for (unsigned int lane = 0; lane < PACKET_SIZE; ++lane) {
+                const auto tx1 = (minimum.x - originX[lane]) * inverseX[lane];
+                const auto tx2 = (maximum.x - originX[lane]) * inverseX[lane];
+                const auto ty1 = (minimum.y - originY[lane]) * inverseY[lane];
+                const auto ty2 = (maximum.y - originY[lane]) * inverseY[lane];
+                const auto tz1 = (minimum.z - originZ[lane]) * inverseZ[lane];
+                const auto tz2 = (maximum.z - originZ[lane]) * inverseZ[lane];
+                const auto tMin = std::max(std::max(0.0f, std::min(tx1, tx2)), std::max(std::min(ty1, ty2), std::min(tz1, tz2)));
+                const auto tMax = std::min(std::min(closestDistances[lane], std::max(tx1, tx2)), std::min(std::max(ty1, ty2), std::max(tz1, tz2)));
+                mask |= static_cast<unsigned int>(tMax >= tMin) << lane;
+            }
+            if (mask == 0) {
+                continue;
+            }
+            if (node.split) {
+
+                // Visit the child nearest along the rays' common direction first, so its hits can cull the other one
+                const auto first = node.firstChildOrTriangleIndex;
+                const auto offset = nodes[first + 1].bounds.getCenter() - nodes[first].bounds.getCenter();
+                const int nearest = glm::dot(offset, packetDirection) < 0.0f ? 1 : 0;
+                stack[stackIndex++] = first + 1 - nearest;
+                stack[stackIndex++] = first + nearest;
+            }
+            else {
+                for (int i = 0; i < node.triangleCount; ++i) {
+                    const auto triangleIndex = node.firstChildOrTriangleIndex + i;
+                    for (unsigned int lane = 0; lane < packetSize; ++lane) {
+                        if (!(mask & (1u << lane))) {
+                            continue;
+                        }
+                        const auto& ray = rays[packetStart + lane];
+                        glm::vec2 barycentricCoordinates;
+                        const auto t = Intersection::intersectionDistance(ray, triangles[triangleIndex], barycentricCoordinates);
+                        if (t > 0 && t < closestDistances[lane]) {
+                            closestDistances[lane] = t;
+                            hits[packetStart + lane] = RayHit{t, barycentricCoordinates, triangleIndex};
                         }
                     }
                 }
             }
         }
     }
-    return closest_backside;
+}
+
+void BoundingVolumeHierarchy::queryRayHits(const Ray &ray, std::vector<RayHit>& hits) const {
+
+    const auto inverseDirection = computeSafeInverseDirection(ray);
+    unsigned int stack[STACK_DEPTH];
+    int stackIndex = 0;
+    stack[stackIndex++] = 0; // Start with the root node
+    while (stackIndex > 0) {
+        const auto& node = nodes[stack[--stackIndex]];
+        if (computeEntryDistance(node.bounds, ray.origin, inverseDirection, std::numeric_limits<float>::max()) < std::numeric_limits<float>::infinity()) {
+            if (node.split) {
+                for (int i = 0; i < 2; ++i) {
+                    stack[stackIndex++] = node.firstChildOrTriangleIndex + i;
+                }
+            }
+            else {
+                for (int i = 0; i < node.triangleCount; ++i) {
+                    const auto triangleIndex = node.firstChildOrTriangleIndex + i;
+                    glm::vec2 barycentricCoordinates;
+                    const auto t = Intersection::intersectionDistance(ray, triangles[triangleIndex], barycentricCoordinates);
+                    if (t > 0) {
+                        hits.push_back({t, barycentricCoordinates, triangleIndex});
+                    }
+                }
+            }
+        }
+    }
 }
 
 
@@ -168,6 +382,54 @@ void BoundingVolumeHierarchy::queryClosestTriangle(const Vertex &vertex, Closest
     }
 }
 
+void BoundingVolumeHierarchy::queryClosestPoints(const std::vector<Vertex> &points, std::vector<ClosestPointQueryResult> &results) const {
+
+    results.assign(points.size(), ClosestPointQueryResult{});
+    if (points.empty() || triangles.empty()) {
+        return;
+    }
+
+    // Order the points along a Morton curve, so consecutive queries are close to each other
+    Vertex minimum(std::numeric_limits<float>::max());
+    Vertex maximum(-std::numeric_limits<float>::max());
+    for (const auto& point: points) {
+        minimum = glm::min(minimum, point);
+        maximum = glm::max(maximum, point);
+    }
+    const auto size = maximum - minimum;
+    const Vertex inverseSize(size.x > 0.0f ? 1.0f / size.x : 0.0f, size.y > 0.0f ? 1.0f / size.y : 0.0f, size.z > 0.0f ? 1.0f / size.z : 0.0f);
+    std::vector<std::pair<uint32_t, size_t>> order(points.size());
+    tbb::parallel_for(size_t(0), points.size(), [&](size_t pointIndex) {
+        order[pointIndex] = {computeMortonCode(points[pointIndex], minimum, inverseSize), pointIndex};
+    });
+    tbb::parallel_sort(order.begin(), order.end());
+
+    // Each chunk of the curve is processed sequentially, seeding each query with the previous point's closest triangle.
+    // The simple partitioner always splits the curve into the same chunks, so the results don't depend on the scheduling
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, order.size(), 256), [&](const tbb::blocked_range<size_t>& range) {
+        const VertexTriangle* previousTriangle = nullptr;
+        for (auto orderIndex = range.begin(); orderIndex < range.end(); ++orderIndex) {
+            const auto& point = points[order[orderIndex].second];
+            ClosestTriangleQueryResult result;
+            if (previousTriangle) {
+                result.closestTriangle = previousTriangle;
+                result.closestVertex = previousTriangle->getClosestPoint(point);
+                const auto delta = result.closestVertex - point;
+                result.lowerDistanceBoundSquared = glm::dot(delta, delta);
+            }
+            if (result.lowerDistanceBoundSquared > 0.0f) {
+                queryClosestTriangle(point, &result);
+            }
+            previousTriangle = result.closestTriangle;
+
+            auto& pointResult = results[order[orderIndex].second];
+            pointResult.distanceSquared = result.lowerDistanceBoundSquared;
+            pointResult.closestPoint = result.closestVertex;
+            pointResult.triangleIndex = static_cast<unsigned int>(result.closestTriangle - triangles.data());
+        }
+    }, tbb::simple_partitioner());
+}
+
 void BoundingVolumeHierarchy::queryClosestTriangle(const VertexTriangle &triangle, ClosestTriangleQueryResult* result) const {
 
     size_t nodeIndexStack[STACK_DEPTH];
@@ -303,6 +565,83 @@ bool BoundingVolumeHierarchy::intersectsTriangle(const VertexTriangle &triangle)
     return false;
 }
 
+/**
+ * @brief Dual traversal of two hierarchies that only differ by a translation.
+ *
+ * Node pairs are compared as offset boxes, descending into the larger node of each overlapping pair. For a pair of
+ * leaves, the bounds of this leaf's triangles are tested against each translated triangle of the other leaf in a
+ * branch-free loop over contiguous components, which the compiler vectorises, before the exact triangle tests.
+ */
+bool BoundingVolumeHierarchy::intersectsTranslated(const BoundingVolumeHierarchy &other, const glm::vec3 &translation) const {
+
+    constexpr int BATCH_SIZE = 64;
+    const auto triangleCount = triangles.size();
+    const float* minimumX = triangleBoundComponents.data();
+    const float* minimumY = minimumX + triangleCount;
+    const float* minimumZ = minimumY + triangleCount;
+    const float* maximumX = minimumZ + triangleCount;
+    const float* maximumY = maximumX + triangleCount;
+    const float* maximumZ = maximumY + triangleCount;
+
+    std::pair<unsigned int, unsigned int> stack[2 * STACK_DEPTH];
+    int stackIndex = 0;
+    stack[stackIndex++] = {0, 0}; // Start with both root nodes
+    while (stackIndex > 0) {
+        const auto [nodeIndex, otherNodeIndex] = stack[--stackIndex];
+        const auto& node = nodes[nodeIndex];
+        const auto& otherNode = other.nodes[otherNodeIndex];
+
+        const auto otherMinimum = otherNode.bounds.getMinimum() + translation;
+        const auto otherMaximum = otherNode.bounds.getMaximum() + translation;
+        if (glm::any(glm::lessThan(otherMaximum, node.bounds.getMinimum())) || glm::any(glm::greaterThan(otherMinimum, node.bounds.getMaximum()))) {
+            continue;
+        }
+
+        if (node.split || otherNode.split) {
+
+            // Descend into the larger node, or the only one that is split
+            const auto extent = node.bounds.getMaximum() - node.bounds.getMinimum();
+            const auto otherExtent = otherNode.bounds.getMaximum() - otherNode.bounds.getMinimum();
+            const bool descendOther = otherNode.split && (!node.split || otherExtent.x + otherExtent.y + otherExtent.z > extent.x + extent.y + extent.z);
+            for (unsigned int i = 0; i < 2; ++i) {
+                assert(stackIndex < 2 * STACK_DEPTH);
+                stack[stackIndex++] = descendOther ? std::make_pair(nodeIndex, otherNode.firstChildOrTriangleIndex + i) : std::make_pair(node.firstChildOrTriangleIndex + i, otherNodeIndex);
+            }
+            continue;
+        }
+
+        // Two leaves, batch the bounds tests of this leaf's triangles against each translated triangle of the other leaf
+        for (unsigned int j = 0; j < otherNode.triangleCount; ++j) {
+            const auto& otherTriangle = other.triangles[otherNode.firstChildOrTriangleIndex + j];
+            const auto minimum = otherTriangle.bounds.getMinimum() + translation;
+            const auto maximum = otherTriangle.bounds.getMaximum() + translation;
+            std::optional<VertexTriangle> translatedTriangle;
+
+            for (unsigned int batchStart = 0; batchStart < node.triangleCount; batchStart += BATCH_SIZE) {
+                const auto first = node.firstChildOrTriangleIndex + batchStart;
+                const auto count = std::min<unsigned int>(BATCH_SIZE, node.triangleCount - batchStart);
+                bool overlaps[BATCH_SIZE];
+                for (unsigned int i = 0; i < count; ++i) {
+                    overlaps[i] = (minimumX[first + i] <= maximum.x) & (maximumX[first + i] >= minimum.x) &
+                                  (minimumY[first + i] <= maximum.y) & (maximumY[first + i] >= minimum.y) &
+                                  (minimumZ[first + i] <= maximum.z) & (maximumZ[first + i] >= minimum.z);
+                }
+                for (unsigned int i = 0; i < count; ++i) {
+                    if (overlaps[i]) {
+                        if (!translatedTriangle.has_value()) {
+                            translatedTriangle.emplace(otherTriangle.getTranslated(translation));
+                        }
+                        if (Intersection::intersect(translatedTriangle.value(), triangles[first + i])) {
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
 float BoundingVolumeHierarchy::getShortestDistanceSquared(const glm::vec3 &point) const {
     unsigned int stack[STACK_DEPTH];
     int stackIndex = 0;
@@ -0,0 +1,201 @@
+#include "meshcore/acceleration/Heightmap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+DepthMap::DepthMap(const ModelSpaceMesh &modelSpaceMesh, const Quaternion &rotation, float scale, float cellSize): cellSize(cellSize) {
+    if(cellSize <= 0.0f){
+        throw std::invalid_argument("The cell size of a depth map should be positive");
+    }
+
+    std::vector<Vertex> vertices;
+    vertices.reserve(modelSpaceMesh.getVertices().size());
+    Vertex minimum(std::numeric_limits<float>::max());
+    Vertex maximum(-std::numeric_limits<float>::max());
+    for (const auto& vertex: modelSpaceMesh.getVertices()){
+        vertices.push_back(scale * rotation.rotateVertex(vertex));
+        minimum = glm::min(minimum, vertices.back());
+        maximum = glm::max(maximum, vertices.back());
+    }
+    bounds = AABB(minimum, maximum);
+    for (auto& vertex: vertices){
+        vertex -= minimum;
+    }
+
+    const auto extent = maximum - minimum;
+    const auto rasterColumns = std::max(1, static_cast<int>(std::ceil(extent.x / cellSize)));
+    const auto rasterRows = std::max(1, static_cast<int>(std::ceil(extent.y / cellSize)));
+    std::vector<float> rasterTops(rasterColumns * rasterRows, -std::numeric_limits<float>::infinity());
+    std::vector<float> rasterBottoms(rasterColumns * rasterRows, std::numeric_limits<float>::infinity());
+
+    // Each triangle bounds the surface in the cells its xy-projection overlaps, using the extremes of its plane over the cell
+    for (const auto& triangle: modelSpaceMesh.getTriangles()){
+        const auto& v0 = vertices[triangle.vertexIndex0];
+        const auto& v1 = vertices[triangle.vertexIndex1];
+        const auto& v2 = vertices[triangle.vertexIndex2];
+        const auto triangleMinimum = glm::min(v0, glm::min(v1, v2));
+        const auto triangleMaximum = glm::max(v0, glm::max(v1, v2));
+        const auto normal = glm::cross(v1 - v0, v2 - v0);
+        const bool vertical = std::abs(normal.z) <= 1e-6f * glm::length(normal);
+
+        const auto firstColumn = std::clamp(static_cast<int>(triangleMinimum.x / cellSize), 0, rasterColumns - 1);
+        const auto lastColumn = std::clamp(static_cast<int>(triangleMaximum.x / cellSize), 0, rasterColumns - 1);
+        const auto firstRow = std::clamp(static_cast<int>(triangleMinimum.y / cellSize), 0, rasterRows - 1);
+        const auto lastRow = std::clamp(static_cast<int>(triangleMaximum.y / cellSize), 0, rasterRows - 1);
+        for (int row = firstRow; row <= lastRow; ++row){
+            for (int column = firstColumn; column <= lastColumn; ++column){
+                float top = triangleMaximum.z;
+                float bottom = triangleMinimum.z;
+                if(!vertical){
+                    float planeMinimum = std::numeric_limits<float>::infinity();
+                    float planeMaximum = -std::numeric_limits<float>::infinity();
+                    for (int corner = 0; corner < 4; ++corner){
+                        const auto x = static_cast<float>(column + (corner & 1)) * cellSize;
+                        const auto y = static_cast<float>(row + (corner >> 1)) * cellSize;
+                        const auto z = v0.z - (normal.x * (x - v0.x) + normal.y * (y - v0.y)) / normal.z;
+                        planeMinimum = std::min(planeMinimum, z);
+                        planeMaximum = std::max(planeMaximum, z);
+                    }
+                    top = std::min(top, planeMaximum);
+                    bottom = std::max(bottom, planeMinimum);
+                }
+                auto& cellTop = rasterTops[row * rasterColumns + column];
+                auto& cellBottom = rasterBottoms[row * rasterColumns + column];
+                cellTop = std::max(cellTop, top);
+                cellBottom = std::min(cellBottom, bottom);
+            }
+        }
+    }
+
+    // Dilate, a cell of a grid with an arbitrary offset overlaps at most two raster cells along each axis
+    columns = rasterColumns + 1;
+    rows = rasterRows + 1;
+    tops.assign(columns * rows, -std::numeric_limits<float>::infinity());
+    bottoms.assign(columns * rows, std::numeric_limits<float>::infinity());
+    for (int row = 0; row < rows; ++row){
+        for (int column = 0; column < columns; ++column){
+            for (int rasterRow = std::max(0, row - 1); rasterRow <= std::min(row, rasterRows - 1); ++rasterRow){
+                for (int rasterColumn = std::max(0, column - 1); rasterColumn <= std::min(column, rasterColumns - 1); ++rasterColumn){
+                    tops[row * columns + column] = std::max(tops[row * columns + column], rasterTops[rasterRow * rasterColumns + rasterColumn]);
+                    bottoms[row * columns + column] = std::min(bottoms[row * columns + column], rasterBottoms[rasterRow * rasterColumns + rasterColumn]);
+                }
+            }
+        }
+    }
+}
+
+Heightmap::Heightmap(const AABB &container, float cellSize): footprint(container), cellSize(cellSize) {
+    if(cellSize <= 0.0f){
+        throw std::invalid_argument("The cell size of a heightmap should be positive");
+    }
+    const auto extent = container.getMaximum() - container.getMinimum();
+    columns = std::max(1, static_cast<int>(std::ceil(extent.x / cellSize)));
+    rows = std::max(1, static_cast<int>(std::ceil(extent.y / cellSize)));
+    heights.assign(columns * rows, container.getMinimum().z);
+    cellItems.resize(columns * rows);
+}
+
+float Heightmap::computeDefaultCellSize(const AABB &container, const std::vector<std::shared_ptr<ModelSpaceMesh>> &modelSpaceMeshes) {
+    constexpr int maximumCells = 512;
+    const auto extent = container.getMaximum() - container.getMinimum();
+    auto cellSize = std::numeric_limits<float>::max();
+    for (const auto& modelSpaceMesh: modelSpaceMeshes){
+        const auto meshExtent = modelSpaceMesh->getBounds().getMaximum() - modelSpaceMesh->getBounds().getMinimum();
+        cellSize = std::min(cellSize, 0.25f * std::min(meshExtent.x, meshExtent.y));
+    }
+    return std::max({cellSize == std::numeric_limits<float>::max() ? 0.0f : cellSize, extent.x / maximumCells, extent.y / maximumCells, 1e-6f});
+}
+
+int Heightmap::computeColumn(float x) const {
+    return static_cast<int>(std::floor((x - footprint.getMinimum().x) / cellSize));
+}
+
+int Heightmap::computeRow(float y) const {
+    return static_cast<int>(std::floor((y - footprint.getMinimum().y) / cellSize));
+}
+
+float Heightmap::computeContribution(const Placement &placement, int column, int row) {
+    return placement.z + placement.depthMap->getTop(column - placement.column, row - placement.row);
+}
+
+const std::shared_ptr<const DepthMap> &Heightmap::getDepthMap(const std::shared_ptr<ModelSpaceMesh> &modelSpaceMesh, const Quaternion &rotation, float scale) {
+    const DepthMapKey key{modelSpaceMesh.get(), rotation.w, rotation.x, rotation.y, rotation.z, scale};
+    auto iterator = depthMaps.find(key);
+    if(iterator == depthMaps.end()){
+        // The mesh is kept alive, so its address can't be reused by another mesh
+        iterator = depthMaps.emplace(key, std::make_pair(modelSpaceMesh, std::make_shared<const DepthMap>(*modelSpaceMesh, rotation, scale, cellSize))).first;
+    }
+    return iterator->second.second;
+}
+
+void Heightmap::setItem(size_t itemIndex, const std::shared_ptr<ModelSpaceMesh> &modelSpaceMesh, const Transformation &transformation) {
+    const auto& depthMap = getDepthMap(modelSpaceMesh, transformation.getRotation(), transformation.getScale());
+    setItem(itemIndex, depthMap, transformation.getPosition() + depthMap->getBounds().getMinimum());
+}
+
+void Heightmap::setItem(size_t itemIndex, const std::shared_ptr<const DepthMap> &depthMap, const Vertex &minimum) {
+    removeItem(itemIndex);
+    if(itemIndex >= placements.size()){
+        placements.resize(itemIndex + 1);
+    }
+    auto& placement = placements[itemIndex];
+    placement = Placement{depthMap, computeColumn(minimum.x), computeRow(minimum.y), minimum.z};
+
+    for (int row = std::max(0, placement->row); row < std::min(rows, placement->row + depthMap->getRows()); ++row){
+        for (int column = std::max(0, placement->column); column < std::min(columns, placement->column + depthMap->getColumns()); ++column){
+            const auto cellIndex = row * columns + column;
+            cellItems[cellIndex].push_back(itemIndex);
+            heights[cellIndex] = std::max(heights[cellIndex], computeContribution(*placement, column, row));
+        }
+    }
+}
+
+void Heightmap::removeItem(size_t itemIndex) {
+    if(itemIndex >= placements.size() || !placements[itemIndex]){
+        return;
+    }
+    const auto placement = *placements[itemIndex];
+    placements[itemIndex].reset();
+
+    for (int row = std::max(0, placement.row); row < std::min(rows, placement.row + placement.depthMap->getRows()); ++row){
+        for (int column = std::max(0, placement.column); column < std::min(columns, placement.column + placement.depthMap->getColumns()); ++column){
+            const auto cellIndex = row * columns + column;
+            auto& items = cellItems[cellIndex];
+            items.erase(std::find(items.begin(), items.end(), itemIndex));
+            auto height = footprint.getMinimum().z;
+            for (const auto otherIndex: items){
+                height = std::max(height, computeContribution(*placements[otherIndex], column, row));
+            }
+            heights[cellIndex] = height;
+        }
+    }
+}
+
+void Heightmap::clear() {
+    placements.clear();
+    std::fill(heights.begin(), heights.end(), footprint.getMinimum().z);
+    for (auto& items: cellItems){
+        items.clear();
+    }
+}
+
+float Heightmap::computeLowestPlacement(const DepthMap &depthMap, float x, float y) const {
+    const auto firstColumn = computeColumn(x);
+    const auto firstRow = computeRow(y);
+    const auto columnBegin = std::max(0, firstColumn);
+    const auto columnEnd = std::min(columns, firstColumn + depthMap.getColumns());
+
+    // Branch-free max-reduction over contiguous rows of both maps, which the compiler can vectorise
+    auto result = footprint.getMinimum().z;
+    for (int row = std::max(0, firstRow); row < std::min(rows, firstRow + depthMap.getRows()); ++row){
+        const auto* cellHeights = heights.data() + row * columns;
+        const auto* bottoms = depthMap.getBottomRow(row - firstRow) - firstColumn;
+        for (int column = columnBegin; column < columnEnd; ++column){
+            const auto required = cellHeights[column] - bottoms[column];
+            result = required > result ? required : result;
+        }
+    }
+    return result;
+}
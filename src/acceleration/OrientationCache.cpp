@@ -0,0 +1,155 @@
+#include "meshcore/acceleration/OrientationCache.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+size_t OrientedMesh::computeMemoryUsage() const {
+    size_t memoryUsage = sizeof(OrientedMesh);
+    for (const auto& modelSpaceMesh: {mesh, convexHull}){
+        if(modelSpaceMesh){
+            memoryUsage += sizeof(ModelSpaceMesh) + modelSpaceMesh->getVertices().size() * sizeof(Vertex) + modelSpaceMesh->getTriangles().size() * sizeof(IndexTriangle);
+        }
+    }
+    if(tree){
+        memoryUsage += sizeof(BoundingVolumeHierarchy) + tree->getNodes().size() * sizeof(BoundingVolumeHierarchy::Node) + tree->getTriangles().size() * sizeof(VertexTriangle);
+    }
+    return memoryUsage;
+}
+
+OrientationCache::OrientationCache(OrientationCacheParameters parameters): parameters(parameters) {
+    if(parameters.quantisation <= 0.0f){
+        throw std::invalid_argument("The quantisation of an orientation cache should be positive");
+    }
+}
+
+OrientationCache::Key OrientationCache::computeKey(const std::shared_ptr<ModelSpaceMesh>& modelSpaceMesh, const Quaternion &rotation) const {
+    std::array<long, 4> quantised = {std::lround(rotation.w / parameters.quantisation),
+                                     std::lround(rotation.x / parameters.quantisation),
+                                     std::lround(rotation.y / parameters.quantisation),
+                                     std::lround(rotation.z / parameters.quantisation)};
+
+    // q and -q represent the same rotation, make the first non-zero component positive
+    for (const auto component: quantised){
+        if(component != 0){
+            if(component < 0){
+                for (auto& value: quantised){
+                    value = -value;
+                }
+            }
+            break;
+        }
+    }
+    return {modelSpaceMesh.get(), quantised};
+}
+
+std::shared_ptr<const OrientedMesh> OrientationCache::build(const ModelSpaceMesh &modelSpaceMesh, const Quaternion &rotation) const {
+    auto orientedMesh = std::make_shared<OrientedMesh>();
+    orientedMesh->rotation = rotation;
+
+    std::vector<Vertex> vertices;
+    vertices.reserve(modelSpaceMesh.getVertices().size());
+    for (const auto& vertex: modelSpaceMesh.getVertices()){
+        vertices.push_back(rotation.rotateVertex(vertex));
+    }
+    orientedMesh->mesh = std::make_shared<ModelSpaceMesh>(std::move(vertices), modelSpaceMesh.getTriangles());
+    orientedMesh->mesh->setName(modelSpaceMesh.getName());
+
+    const auto& convexHull = modelSpaceMesh.getConvexHull();
+    std::vector<Vertex> hullVertices;
+    hullVertices.reserve(convexHull->getVertices().size());
+    Vertex minimum(std::numeric_limits<float>::max());
+    Vertex maximum(-std::numeric_limits<float>::max());
+    for (const auto& vertex: convexHull->getVertices()){
+        hullVertices.push_back(rotation.rotateVertex(vertex));
+        minimum = glm::min(minimum, hullVertices.back());
+        maximum = glm::max(maximum, hullVertices.back());
+    }
+    orientedMesh->convexHull = std::make_shared<ModelSpaceMesh>(std::move(hullVertices), convexHull->getTriangles());
+    orientedMesh->bounds = AABB(minimum, maximum);
+
+    if(parameters.buildTrees){
+        // Isolated, get() may be called while the caller holds a lock that other tasks in the arena wait for
+        orientedMesh->tree = tbb::this_task_arena::isolate([&]{ return std::make_shared<BoundingVolumeHierarchy>(orientedMesh->mesh); });
+    }
+    return orientedMesh;
+}
+
+std::shared_ptr<const OrientedMesh> OrientationCache::insert(const Key &key, const std::shared_ptr<ModelSpaceMesh>& modelSpaceMesh, std::shared_ptr<const OrientedMesh> orientedMesh) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Another thread may have built the same entry in the meantime
+    const auto existing = entries.find(key);
+    if(existing != entries.end()){
+        return existing->second.orientedMesh;
+    }
+
+    insertionOrder.push_back(key);
+    memoryUsage += orientedMesh->computeMemoryUsage();
+    entries.emplace(key, Entry{modelSpaceMesh, orientedMesh, std::prev(insertionOrder.end())});
+
+    // Evict the oldest entries, references handed out before remain valid
+    while(parameters.maximumMemory > 0 && memoryUsage > parameters.maximumMemory && entries.size() > 1){
+        const auto oldest = entries.find(insertionOrder.front());
+        memoryUsage -= oldest->second.orientedMesh->computeMemoryUsage();
+        entries.erase(oldest);
+        insertionOrder.pop_front();
+    }
+    return orientedMesh;
+}
+
+std::shared_ptr<const OrientedMesh> OrientationCache::find(const std::shared_ptr<ModelSpaceMesh> &modelSpaceMesh, const Quaternion &rotation) const {
+    const auto key = computeKey(modelSpaceMesh, rotation);
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto iterator = entries.find(key);
+    return iterator != entries.end() ? iterator->second.orientedMesh : nullptr;
+}
+
+std::shared_ptr<const OrientedMesh> OrientationCache::get(const std::shared_ptr<ModelSpaceMesh> &modelSpaceMesh, const Quaternion &rotation) {
+    auto orientedMesh = find(modelSpaceMesh, rotation);
+    if(orientedMesh || !parameters.lazyBuild){
+        return orientedMesh;
+    }
+    return insert(computeKey(modelSpaceMesh, rotation), modelSpaceMesh, build(*modelSpaceMesh, rotation));
+}
+
+void OrientationCache::prepare(const std::vector<std::shared_ptr<ModelSpaceMesh>> &modelSpaceMeshes, const std::vector<Quaternion> &rotations) {
+    std::vector<std::pair<std::shared_ptr<ModelSpaceMesh>, Quaternion>> missing;
+    for (const auto& modelSpaceMesh: modelSpaceMeshes){
+        for (const auto& rotation: rotations){
+            if(!find(modelSpaceMesh, rotation)){
+                missing.emplace_back(modelSpaceMesh, rotation);
+            }
+        }
+    }
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, missing.size(), 1), [&](const tbb::blocked_range<size_t>& range){
+        for (size_t index = range.begin(); index < range.end(); ++index){
+            const auto& [modelSpaceMesh, rotation] = missing[index];
+            insert(computeKey(modelSpaceMesh, rotation), modelSpaceMesh, build(*modelSpaceMesh, rotation));
+        }
+    });
+}
+
+const OrientationCacheParameters &OrientationCache::getParameters() const {
+    return parameters;
+}
+
+size_t OrientationCache::getNumberOfEntries() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+size_t OrientationCache::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return memoryUsage;
+}
+
+void OrientationCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    insertionOrder.clear();
+    memoryUsage = 0;
+}
@@ -0,0 +1,206 @@
+#include "meshcore/acceleration/SignedDistanceField.h"
+#include "meshcore/acceleration/BoundingVolumeHierarchy.h"
+#include "meshcore/acceleration/CachingBoundsTreeFactory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <tbb/parallel_for.h>
+
+namespace {
+    constexpr char SIGNED_DISTANCE_FIELD_MAGIC[8] = {'M','C','S','D','F','\0','\0','\0'};
+    constexpr uint32_t SIGNED_DISTANCE_FIELD_VERSION = 1;
+
+    struct SignedDistanceFieldHeader {
+        char magic[8];
+        uint32_t version;
+        float origin[3];
+        float cellSize;
+        uint32_t dimensions[3];
+        float bandWidth;
+        uint64_t sampleCount;
+    };
+
+    constexpr int PADDING_CELLS = 2; // Around the mesh's bounds, so points near the surface always lie inside the grid
+}
+
+SignedDistanceField::SignedDistanceField(const std::shared_ptr<ModelSpaceMesh> &modelSpaceMesh, const SignedDistanceFieldParameters &parameters) {
+
+    if(parameters.resolution == 0){
+        throw std::invalid_argument("The resolution of a signed distance field should be positive");
+    }
+    const auto& bounds = modelSpaceMesh->getBounds();
+    const auto size = bounds.getMaximum() - bounds.getMinimum();
+    const auto longestSide = std::max(size.x, std::max(size.y, size.z));
+    cellSize = longestSide > 0.0f ? longestSide / static_cast<float>(parameters.resolution) : 1.0f;
+    bandWidth = parameters.bandWidth > 0.0f ? parameters.bandWidth * longestSide : std::numeric_limits<float>::infinity();
+    origin = bounds.getMinimum() - Vertex(PADDING_CELLS * cellSize);
+    for (int axis = 0; axis < 3; ++axis){
+        dimensions[axis] = static_cast<unsigned int>(std::ceil(size[axis] / cellSize)) + 1 + 2 * PADDING_CELLS;
+    }
+    samples.resize(static_cast<size_t>(dimensions.x) * dimensions.y * dimensions.z);
+
+    const auto& tree = CachingBoundsTreeFactory<BoundingVolumeHierarchy>::getBoundsTree(modelSpaceMesh);
+    const auto maximumDistanceSquared = std::isinf(bandWidth) ? std::numeric_limits<float>::max() : bandWidth * bandWidth;
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, dimensions.y * dimensions.z), [&](const tbb::blocked_range<unsigned int>& range){
+        for (auto row = range.begin(); row < range.end(); ++row){
+            const auto y = row % dimensions.y;
+            const auto z = row / dimensions.y;
+            for (unsigned int x = 0; x < dimensions.x; ++x){
+                const auto point = origin + cellSize * Vertex(x, y, z);
+                BoundingVolumeHierarchy::ClosestTriangleQueryResult result;
+                result.lowerDistanceBoundSquared = maximumDistanceSquared;
+                tree->queryClosestTriangle(point, &result);
+                const auto distance = result.closestTriangle ? std::sqrt(result.lowerDistanceBoundSquared) : bandWidth;
+                samples[computeSampleIndex(x, y, z)] = tree->containsPoint(point) ? -distance : distance;
+            }
+        }
+    });
+}
+
+SignedDistanceField::SignedDistanceField(const Vertex &origin, float cellSize, const glm::uvec3 &dimensions, float bandWidth, std::vector<float> samples):
+    origin(origin), cellSize(cellSize), dimensions(dimensions), bandWidth(bandWidth), samples(std::move(samples)) {
+    if(this->samples.size() != static_cast<size_t>(dimensions.x) * dimensions.y * dimensions.z || dimensions.x < 2 || dimensions.y < 2 || dimensions.z < 2){
+        throw std::invalid_argument("The number of samples doesn't match the dimensions of the signed distance field");
+    }
+}
+
+size_t SignedDistanceField::computeSampleIndex(unsigned int x, unsigned int y, unsigned int z) const {
+    return (static_cast<size_t>(z) * dimensions.y + y) * dimensions.x + x;
+}
+
+const Vertex &SignedDistanceField::getOrigin() const {
+    return origin;
+}
+
+float SignedDistanceField::getCellSize() const {
+    return cellSize;
+}
+
+const glm::uvec3 &SignedDistanceField::getDimensions() const {
+    return dimensions;
+}
+
+float SignedDistanceField::getBandWidth() const {
+    return bandWidth;
+}
+
+const std::vector<float> &SignedDistanceField::getSamples() const {
+    return samples;
+}
+
+AABB SignedDistanceField::getBounds() const {
+    return {origin, origin + cellSize * Vertex(dimensions - glm::uvec3(1))};
+}
+
+float SignedDistanceField::getSignedDistance(const Vertex &point) const {
+    const auto local = glm::clamp((point - origin) / cellSize, Vertex(0.0f), Vertex(dimensions - glm::uvec3(1)));
+    const auto cell = glm::min(glm::uvec3(local), dimensions - glm::uvec3(2));
+    const auto fraction = local - Vertex(cell);
+
+    float result = 0.0f;
+    for (unsigned int corner = 0; corner < 8; ++corner){
+        const glm::uvec3 offset(corner & 1u, (corner >> 1) & 1u, (corner >> 2) & 1u);
+        float weight = 1.0f;
+        for (int axis = 0; axis < 3; ++axis){
+            weight *= offset[axis] ? fraction[axis] : 1.0f - fraction[axis];
+        }
+        result += weight * samples[computeSampleIndex(cell.x + offset.x, cell.y + offset.y, cell.z + offset.z)];
+    }
+    return result;
+}
+
+std::pair<float, float> SignedDistanceField::getSignedDistanceBounds(const Vertex &point) const {
+    const auto local = glm::clamp((point - origin) / cellSize, Vertex(0.0f), Vertex(dimensions - glm::uvec3(1)));
+    const auto cell = glm::min(glm::uvec3(local), dimensions - glm::uvec3(2));
+
+    // The signed distance is 1-Lipschitz, so each sample bounds it from both sides, up to the distance between the points
+    auto lower = -std::numeric_limits<float>::infinity();
+    auto upper = std::numeric_limits<float>::infinity();
+    for (unsigned int corner = 0; corner < 8; ++corner){
+        const glm::uvec3 sampleCoordinates = cell + glm::uvec3(corner & 1u, (corner >> 1) & 1u, (corner >> 2) & 1u);
+        const auto sample = samples[computeSampleIndex(sampleCoordinates.x, sampleCoordinates.y, sampleCoordinates.z)];
+        const auto distance = glm::length(point - (origin + cellSize * Vertex(sampleCoordinates)));
+        if(sample < bandWidth){ // A clamped positive sample only tells the exact value is larger
+            upper = std::min(upper, sample + distance);
+        }
+        if(sample > -bandWidth){
+            lower = std::max(lower, sample - distance);
+        }
+    }
+
+    // The mesh lies inside the grid, points outside of the grid are at least as far from the surface as from the grid
+    const auto bounds = getBounds();
+    const auto outsideDistance = glm::length(point - glm::clamp(point, bounds.getMinimum(), bounds.getMaximum()));
+    if(outsideDistance > 0.0f){
+        lower = std::max(lower, outsideDistance);
+    }
+
+    // Slack for the rounding errors of the samples
+    const auto tolerance = 1e-4f * cellSize;
+    return {lower - tolerance, upper + tolerance};
+}
+
+bool SignedDistanceField::isWithinDistance(const Vertex &point, float distance, const BoundingVolumeHierarchy &tree) const {
+    const auto [lower, upper] = getSignedDistanceBounds(point);
+    if(lower >= distance || upper <= -distance){
+        return false;
+    }
+    if((lower >= 0.0f && upper < distance) || (upper <= 0.0f && lower > -distance)){
+        return true;
+    }
+    return tree.getShortestDistanceSquared(point) < distance * distance;
+}
+
+float SignedDistanceField::estimatePenetrationDepth(const ModelSpaceMesh &other, const Transformation &otherToThisTransformation) const {
+    float depth = 0.0f;
+    for (const auto& vertex: other.getVertices()){
+        depth = std::max(depth, -getSignedDistance(otherToThisTransformation.transformVertex(vertex)));
+    }
+    return depth;
+}
+
+void SignedDistanceField::save(const std::string &path) const {
+    SignedDistanceFieldHeader header{};
+    std::memcpy(header.magic, SIGNED_DISTANCE_FIELD_MAGIC, sizeof(SIGNED_DISTANCE_FIELD_MAGIC));
+    header.version = SIGNED_DISTANCE_FIELD_VERSION;
+    for (int axis = 0; axis < 3; ++axis){
+        header.origin[axis] = origin[axis];
+        header.dimensions[axis] = dimensions[axis];
+    }
+    header.cellSize = cellSize;
+    header.bandWidth = bandWidth;
+    header.sampleCount = samples.size();
+
+    std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!stream.is_open()){
+        throw std::runtime_error("Could not open file " + path);
+    }
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream.write(reinterpret_cast<const char*>(samples.data()), static_cast<std::streamsize>(samples.size() * sizeof(float)));
+}
+
+std::shared_ptr<SignedDistanceField> SignedDistanceField::load(const std::string &path) {
+    std::ifstream stream(path, std::ios::in | std::ios::binary);
+    if(!stream.is_open()){
+        throw std::runtime_error("Could not open file " + path);
+    }
+    SignedDistanceFieldHeader header{};
+    stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if(!stream || std::memcmp(header.magic, SIGNED_DISTANCE_FIELD_MAGIC, sizeof(SIGNED_DISTANCE_FIELD_MAGIC)) != 0){
+        throw std::runtime_error("File " + path + " is not a valid signed distance field");
+    }
+    if(header.version != SIGNED_DISTANCE_FIELD_VERSION){
+        throw std::runtime_error("Signed distance field " + path + " has version " + std::to_string(header.version) + ", expected version " + std::to_string(SIGNED_DISTANCE_FIELD_VERSION));
+    }
+    std::vector<float> samples(header.sampleCount);
+    stream.read(reinterpret_cast<char*>(samples.data()), static_cast<std::streamsize>(samples.size() * sizeof(float)));
+    if(!stream){
+        throw std::runtime_error("Signed distance field " + path + " is truncated");
+    }
+    return std::make_shared<SignedDistanceField>(Vertex(header.origin[0], header.origin[1], header.origin[2]), header.cellSize,
+                                                 glm::uvec3(header.dimensions[0], header.dimensions[1], header.dimensions[2]), header.bandWidth, std::move(samples));
+}
@@ -6,10 +6,19 @@
 
 #include <utility>
 #include <unordered_set>
+#include <functional>
+#include <numeric>
+#include <unordered_map>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 #include "meshcore/factories/AABBFactory.h"
+#include "meshcore/factories/OBBFactory.h"
 #include "src/external/quickhull/QuickHull.hpp"
 #include "src/external/mapbox/earcut.hpp"
 #include "meshcore/core/Plane.h"
+#include "meshcore/geometric/ConvexDecomposition.h"
+#include "meshcore/geometric/CollisionProxy.h"
+#include "meshcore/acceleration/SignedDistanceField.h"
 
 #define EPSILON 1e-4
 
@@ -20,6 +29,9 @@ ModelSpaceMesh::ModelSpaceMesh(std::vector<Vertex> vertices) {
 ModelSpaceMesh::ModelSpaceMesh(std::vector<Vertex> mVertices, std::vector<IndexTriangle> moveableTriangles):
 vertices(std::move(mVertices)), triangles(std::move(moveableTriangles)){}
 
+ModelSpaceMesh::ModelSpaceMesh(const ModelSpaceMesh &other):
+GJKConvexShape(other), std::enable_shared_from_this<ModelSpaceMesh>(), name(other.name), vertices(other.vertices), triangles(other.triangles){}
+
 const std::vector<Vertex>& ModelSpaceMesh::getVertices() const {
     return vertices;
 }
@@ -29,15 +41,15 @@ const std::vector<IndexTriangle>& ModelSpaceMesh::getTriangles() const {
 }
 
 const std::vector<IndexFace>& ModelSpaceMesh::getFaces() const {
-    if(!faces.has_value()){
+    std::call_once(facesFlag, [this]{
         computeFaces();
         assert(faces.has_value());
-    }
+    });
     return faces.value();
 }
 
 const std::vector<IndexEdge>& ModelSpaceMesh::getEdges() const {
-    if(!triangleEdges.has_value()){
+    std::call_once(triangleEdgesFlag, [this]{
         // Set up the hash and equals in a way that the order of vertexIndex0 and vertexIndex1 doesn't matter
         auto hash = [](const IndexEdge& edge) { return std::hash<unsigned int>()(edge.vertexIndex0 + edge.vertexIndex1); }; // Hashes should remain equal if vertices are swapped
         auto equal = [](const IndexEdge& edge1, const IndexEdge& edge2) {
@@ -51,16 +63,14 @@ const std::vector<IndexEdge>& ModelSpaceMesh::getEdges() const {
         }
 
         this->triangleEdges = std::vector<IndexEdge>(edgeSet.begin(), edgeSet.end());
-    }
+    });
     return triangleEdges.value();
 }
 
 
 const std::vector<IndexEdge>& ModelSpaceMesh::getFaceEdges() const {
-    if(!faceEdges.has_value()){
-        if(!faces.has_value()){
-            computeFaces();
-        }
+    std::call_once(faceEdgesFlag, [this]{
+        const auto& meshFaces = getFaces();
 
         // Determine unique edges
         {
@@ -70,7 +80,7 @@ const std::vector<IndexEdge>& ModelSpaceMesh::getFaceEdges() const {
                 return (edge1.vertexIndex0 == edge2.vertexIndex0 && edge1.vertexIndex1 == edge2.vertexIndex1) ||
                        (edge1.vertexIndex1 == edge2.vertexIndex0 && edge1.vertexIndex0 == edge2.vertexIndex1); };
             std::unordered_set<IndexEdge, decltype(hash), decltype(equal)> edgeSet(8, hash, equal);
-            for(const IndexFace& face: this->faces.value()){
+            for(const IndexFace& face: meshFaces){
                 for (int i = 0; i < face.vertexIndices.size(); ++i){
                     edgeSet.insert(IndexEdge{face.vertexIndices[i], face.vertexIndices[(i + 1)%face.vertexIndices.size()]});
                 }
@@ -78,7 +88,7 @@ const std::vector<IndexEdge>& ModelSpaceMesh::getFaceEdges() const {
             this->faceEdges = std::vector<IndexEdge>(edgeSet.begin(), edgeSet.end());
         }
         assert(faceEdges.has_value());
-    }
+    });
     return faceEdges.value();
 }
 
@@ -180,13 +190,54 @@ std::vector<IndexEdge> ModelSpaceMesh::getSufficientIntersectionEdges() const {
 }
 
 const std::shared_ptr<ModelSpaceMesh>& ModelSpaceMesh::getConvexHull() const {
+    std::call_once(convexHullFlag, [this]{
+        if(convexHull == nullptr){
+            computeConvexHull();
+        }
+    });
+    return convexHull;
+}
 
-    // Return the value if already calculated before
-    if(convexHull != nullptr){
-        return convexHull;
-    }
+// The builds below run parallel loops inside call_once. Without isolation, a thread waiting for its loop could pick up
+// an unrelated task that asks for the same property of this mesh and block on the flag it already holds itself.
+const std::shared_ptr<const ConvexDecomposition>& ModelSpaceMesh::getConvexDecomposition() const {
+    std::call_once(convexDecompositionFlag, [this]{
+        convexDecomposition = tbb::this_task_arena::isolate([this]{ return std::make_shared<ConvexDecomposition>(*this); });
+    });
+    return convexDecomposition;
+}
+
+void ModelSpaceMesh::setPrecomputedConvexDecomposition(const std::shared_ptr<const ConvexDecomposition> &precomputedConvexDecomposition) const {
+    std::call_once(convexDecompositionFlag, [&]{ this->convexDecomposition = precomputedConvexDecomposition; });
+}
+
+const std::shared_ptr<const CollisionProxy>& ModelSpaceMesh::getCollisionProxy() const {
+    std::call_once(collisionProxyFlag, [this]{
+        collisionProxy = tbb::this_task_arena::isolate([this]{ return std::make_shared<CollisionProxy>(*this); });
+    });
+    return collisionProxy;
+}
+
+void ModelSpaceMesh::setPrecomputedCollisionProxy(const std::shared_ptr<const CollisionProxy> &precomputedCollisionProxy) const {
+    std::call_once(collisionProxyFlag, [&]{ this->collisionProxy = precomputedCollisionProxy; });
+}
 
-    // Otherwise, use the quickhull library to calculate the convex hull
+const std::shared_ptr<const SignedDistanceField>& ModelSpaceMesh::getSignedDistanceField() const {
+    std::call_once(signedDistanceFieldFlag, [this]{
+        // Shares the tree that the cache holds for this mesh, which is keyed by a non-const pointer
+        const auto self = std::const_pointer_cast<ModelSpaceMesh>(shared_from_this());
+        signedDistanceField = tbb::this_task_arena::isolate([&]{ return std::make_shared<SignedDistanceField>(self); });
+    });
+    return signedDistanceField;
+}
+
+void ModelSpaceMesh::setPrecomputedSignedDistanceField(const std::shared_ptr<const SignedDistanceField> &precomputedSignedDistanceField) const {
+    std::call_once(signedDistanceFieldFlag, [&]{ this->signedDistanceField = precomputedSignedDistanceField; });
+}
+
+void ModelSpaceMesh::computeConvexHull() const {
+
+    // Use the quickhull library to calculate the convex hull
     quickhull::QuickHull<float> qh;
     std::vector<quickhull::Vector3<float>> qhVertices;
 
@@ -264,7 +315,6 @@ const std::shared_ptr<ModelSpaceMesh>& ModelSpaceMesh::getConvexHull() const {
     assert(glm::all(glm::epsilonEqual(hull->getBounds().getMaximum(), this->getBounds().getMaximum(), 1e-4f)) && "The convex hull should have the same bounding box as the original mesh");
     hull->setName("Convex hull of " + this->getName());
     this->convexHull = std::move(hull);
-    return this->convexHull;
 }
 
 const std::string &ModelSpaceMesh::getName() const {
@@ -275,20 +325,23 @@ void ModelSpaceMesh::setName(const std::string &newName) {
     ModelSpaceMesh::name = newName;
 }
 
+void ModelSpaceMesh::setPrecomputedProperties(const AABB &precomputedBounds, float precomputedVolume, const Vertex &precomputedVolumeCentroid, const std::shared_ptr<ModelSpaceMesh> &precomputedConvexHull) const {
+    std::call_once(boundsFlag, [&]{ this->bounds = precomputedBounds; });
+    std::call_once(volumeFlag, [&]{
+        this->volume = precomputedVolume;
+        this->volumeCentroid = precomputedVolumeCentroid;
+    });
+    std::call_once(convexHullFlag, [&]{ this->convexHull = precomputedConvexHull; });
+}
+
 float ModelSpaceMesh::getVolume() const {
-    if(!volume.has_value()){
-        computeVolumeAndCentroid();
-    }
+    std::call_once(volumeFlag, [this]{ computeVolumeAndCentroid(); });
     return volume.value();
 }
 
 bool ModelSpaceMesh::isConvex() const{
 
-    // Return the value if already calculated before
-    if(!convex.has_value()){
-        computeConvexity();
-    }
-
+    std::call_once(convexFlag, [this]{ computeConvexity(); });
     return convex.value();
 }
 
@@ -341,18 +394,14 @@ void ModelSpaceMesh::computeSurfaceAreaAndCentroid() const {
 }
 
 Vertex ModelSpaceMesh::getVolumeCentroid() const {
-    if(!volumeCentroid.has_value()){
-        computeVolumeAndCentroid();
-        assert(volumeCentroid.has_value());
-    }
+    std::call_once(volumeFlag, [this]{ computeVolumeAndCentroid(); });
+    assert(volumeCentroid.has_value());
     return volumeCentroid.value();
 }
 
 Vertex ModelSpaceMesh::getSurfaceCentroid() const {
-    if(!surfaceCentroid.has_value()){
-        computeSurfaceAreaAndCentroid();
-        assert(surfaceCentroid.has_value());
-    }
+    std::call_once(surfaceAreaFlag, [this]{ computeSurfaceAreaAndCentroid(); });
+    assert(surfaceCentroid.has_value());
     return surfaceCentroid.value();
 }
 
@@ -362,18 +411,19 @@ Vertex ModelSpaceMesh::getSurfaceCentroid() const {
  * @return The axis-aligned bounding box of the mesh
  */
 const AABB &ModelSpaceMesh::getBounds() const {
-    if(!this->bounds.has_value()){
-        this->bounds = AABBFactory::createAABB(this->vertices);
-        assert(this->bounds.has_value());
-    }
+    std::call_once(boundsFlag, [this]{ this->bounds = AABBFactory::createAABB(this->vertices); });
+    assert(this->bounds.has_value());
     return this->bounds.value();
 }
 
+const OBB &ModelSpaceMesh::getOBB() const {
+    std::call_once(orientedBoundsFlag, [this]{ this->orientedBounds = OBBFactory::createOBB(*this); });
+    return this->orientedBounds.value();
+}
+
 float ModelSpaceMesh::getSurfaceArea() const {
-    if(!surfaceArea.has_value()){
-        computeSurfaceAreaAndCentroid();
-        assert(surfaceArea.has_value());
-    }
+    std::call_once(surfaceAreaFlag, [this]{ computeSurfaceAreaAndCentroid(); });
+    assert(surfaceArea.has_value());
     return surfaceArea.value();
 }
 
@@ -399,7 +449,7 @@ void ModelSpaceMesh::computeVolumeAndCentroid() const {
 }
 
 const std::vector<std::vector<size_t>>& ModelSpaceMesh::getConnectedVertexIndices() const {
-    if(!connectedVertexIndices.has_value()){
+    std::call_once(connectedVertexIndicesFlag, [this]{
         std::vector<std::unordered_set<size_t>> connectedVertexIndicesSet;
         connectedVertexIndicesSet.resize(vertices.size());
         for(size_t i = 0; i < vertices.size(); i++){
@@ -418,10 +468,31 @@ const std::vector<std::vector<size_t>>& ModelSpaceMesh::getConnectedVertexIndice
         for(size_t i = 0; i < vertices.size(); i++){
             connectedVertexIndices->emplace_back(connectedVertexIndicesSet.at(i).begin(), connectedVertexIndicesSet.at(i).end());
         }
-    }
+    });
     return connectedVertexIndices.value();
 }
 
+void ModelSpaceMesh::precomputeAll(bool parallel) const {
+    const std::vector<std::function<void()>> tasks = {
+            [this]{ static_cast<void>(getBounds()); },
+            [this]{ static_cast<void>(getVolume()); },
+            [this]{ static_cast<void>(getSurfaceArea()); },
+            [this]{ static_cast<void>(isConvex()); },
+            [this]{ static_cast<void>(getConvexHull()); },
+            [this]{ static_cast<void>(getEdges()); },
+            [this]{ static_cast<void>(getFaceEdges()); }, // Also computes the faces
+            [this]{ static_cast<void>(getConnectedVertexIndices()); }
+    };
+    if(parallel){
+        tbb::parallel_for(size_t(0), tasks.size(), [&](size_t taskIndex){ tasks[taskIndex](); });
+    }
+    else{
+        for (const auto &task: tasks){
+            task();
+        }
+    }
+}
+
 glm::vec3 ModelSpaceMesh::computeSupport(const glm::vec3 &direction) const {
     auto bestSupport = -std::numeric_limits<float>::max();
     auto bestVertex = glm::vec3(0.0f);
@@ -435,144 +506,200 @@ glm::vec3 ModelSpaceMesh::computeSupport(const glm::vec3 &direction) const {
     return bestVertex;
 }
 
+/**
+ * @brief Find the vertex with the highest support in the given direction by walking to better connected vertices.
+ *
+ * On a convex mesh every local maximum of the support is a global one, so the walk ends at a support vertex.
+ * Starting from the support vertex of a nearby direction, only a few vertices have to be visited.
+ *
+ * @param direction The direction in which the support is maximised
+ * @param startIndex Index of the vertex where the walk starts
+ * @return Index of the vertex with the highest support
+ */
+size_t ModelSpaceMesh::computeSupportIndex(const glm::vec3 &direction, size_t startIndex) const {
+    assert(!vertices.empty());
+    const auto& connectedIndices = getConnectedVertexIndices();
+    size_t currentIndex = startIndex < vertices.size() ? startIndex : 0;
+    auto currentSupport = glm::dot(vertices[currentIndex], direction);
+    while(true){
+        auto bestIndex = currentIndex;
+        for (const auto &connectedIndex: connectedIndices[currentIndex]){
+            const auto support = glm::dot(vertices[connectedIndex], direction);
+            if(support > currentSupport){
+                currentSupport = support;
+                bestIndex = connectedIndex;
+            }
+        }
+        if(bestIndex == currentIndex){
+            return currentIndex;
+        }
+        currentIndex = bestIndex;
+    }
+}
+
+/**
+ * @brief Compute the AABB of the scaled, rotated and translated mesh with six support queries, one per axis direction.
+ *
+ * The queries start from the extreme vertices of a previous call, which are updated in place. After a small change
+ * of the rotation, only a few vertices are visited.
+ *
+ * @param extremeVertexIndices Per axis, the vertices with the maximum and minimum coordinate
+ */
+AABB ModelSpaceMesh::computeSupportAABB(const glm::vec3 &position, const Quaternion &rotation, float scale, std::array<size_t, 6> &extremeVertexIndices) const {
+    Vertex minimum;
+    Vertex maximum;
+    for (int axis = 0; axis < 3; ++axis){
+        glm::vec3 worldSpaceDirection(0.0f);
+        worldSpaceDirection[axis] = 1.0f;
+        const auto modelSpaceDirection = rotation.inverseRotateVertex(worldSpaceDirection);
+
+        auto& maximumIndex = extremeVertexIndices[2 * axis];
+        auto& minimumIndex = extremeVertexIndices[2 * axis + 1];
+        maximumIndex = computeSupportIndex(modelSpaceDirection, maximumIndex);
+        minimumIndex = computeSupportIndex(-modelSpaceDirection, minimumIndex);
+
+        maximum[axis] = position[axis] + scale * rotation.rotateVertex(vertices[maximumIndex])[axis];
+        minimum[axis] = position[axis] + scale * rotation.rotateVertex(vertices[minimumIndex])[axis];
+    }
+    return {minimum, maximum};
+}
+
 glm::vec3 ModelSpaceMesh::getCenter() const {
     return getBounds().getCenter(); // Alternatively, we could use something like the volume centroid here
 }
 
+/**
+ * @brief Merge coplanar triangles into faces.
+ *
+ * Each face is grown from a seed triangle (largest area first) by a flood fill over edge-adjacent triangles that lie
+ * in the plane of the seed. The boundary of the face is kept as a linked list, a neighbouring triangle being merged by
+ * inserting its third vertex in the boundary edge it shares with the face. Adjacency is looked up in a map of directed
+ * edges, so the whole procedure takes O(n log n) time for n triangles.
+ */
 void ModelSpaceMesh::computeFaces() const {
 
-    // 0. Sort triangles by area
-    auto sortedTriangles = this->triangles;
-    std::sort(sortedTriangles.begin(), sortedTriangles.end(), [&](const IndexTriangle& a, const IndexTriangle& b) {
-        auto areaA = glm::length(glm::cross(vertices[a.vertexIndex1] - vertices[a.vertexIndex0], vertices[a.vertexIndex2] - vertices[a.vertexIndex0]));
-        auto areaB = glm::length(glm::cross(vertices[b.vertexIndex1] - vertices[b.vertexIndex0], vertices[b.vertexIndex2] - vertices[b.vertexIndex0]));
-        return areaA > areaB;
+    // 0. Order the triangles by decreasing area, the largest triangles are the most reliable seeds for a face plane
+    std::vector<glm::vec3> triangleNormals;
+    triangleNormals.reserve(triangles.size());
+    std::vector<float> triangleAreas;
+    triangleAreas.reserve(triangles.size());
+    for (const auto &triangle: triangles){
+        auto normal = glm::cross(vertices[triangle.vertexIndex1] - vertices[triangle.vertexIndex0], vertices[triangle.vertexIndex2] - vertices[triangle.vertexIndex0]);
+        triangleAreas.emplace_back(glm::length(normal));
+        triangleNormals.emplace_back(triangleAreas.back() > 0.0f ? normal / triangleAreas.back() : normal);
+    }
+    std::vector<size_t> sortedTriangleIndices(triangles.size());
+    std::iota(sortedTriangleIndices.begin(), sortedTriangleIndices.end(), 0);
+    std::stable_sort(sortedTriangleIndices.begin(), sortedTriangleIndices.end(), [&](size_t a, size_t b) {
+        return triangleAreas[a] > triangleAreas[b];
     });
 
-    // 1. Determine faces by merging triangles
-    {
-        // a. Keep track of which triangles are already included in a face
-        std::vector<IndexFace> createdFaces;
-        std::vector<bool> triangleIncluded(sortedTriangles.size(), false);
-
-        // b. Merge triangles into createdFaces
-        for (size_t t = 0; t < sortedTriangles.size(); ++t){
-
-            // Continue to the next triangle if already marked as included ...
-            if(triangleIncluded[t]) continue;
-
-            // ... otherwise mark it as included and create a new face
-            triangleIncluded[t] = true;
-            std::vector<size_t> currentFaceIndices = {sortedTriangles[t].vertexIndex0, sortedTriangles[t].vertexIndex1, sortedTriangles[t].vertexIndex2};
-
-            // Keep looking for triangles that can be merged with the current face as long as we find them
-            bool mergeFound;
-            do{
-                mergeFound = false;
-
-                // Compute the current plane of the face
-                // Compute the normal using Newell's method
-                glm::vec3 normal(0.0f);
-                glm::vec3 centroid(0.0f);
-                for (int i = 0; i < currentFaceIndices.size(); ++i){
-                    auto j = (i + 1)%currentFaceIndices.size();
-                    normal.x += (vertices[currentFaceIndices[i]].y - vertices[currentFaceIndices[j]].y) * (vertices[currentFaceIndices[i]].z + vertices[currentFaceIndices[j]].z);
-                    normal.y += (vertices[currentFaceIndices[i]].z - vertices[currentFaceIndices[j]].z) * (vertices[currentFaceIndices[i]].x + vertices[currentFaceIndices[j]].x);
-                    normal.z += (vertices[currentFaceIndices[i]].x - vertices[currentFaceIndices[j]].x) * (vertices[currentFaceIndices[i]].y + vertices[currentFaceIndices[j]].y);
-                    centroid += vertices[currentFaceIndices[i]];
-                }
-                normal = glm::normalize(normal);
-                centroid /= currentFaceIndices.size();
-
-                Plane currentPlane(normal, centroid);
-
-                for (size_t t2 = t+1; t2 < sortedTriangles.size(); ++t2){
-
-                    // Check if the triangle is already included in the list of createdFaces
-                    if(triangleIncluded[t2]) continue;
-
-                    auto distance0 = currentPlane.distance(vertices[sortedTriangles[t2].vertexIndex0]);
-                    auto distance1 = currentPlane.distance(vertices[sortedTriangles[t2].vertexIndex1]);
-                    auto distance2 = currentPlane.distance(vertices[sortedTriangles[t2].vertexIndex2]);
-
-                    float eps = 1e-3f;
-                    if(distance0 > eps || distance1 > eps || distance2 > eps){
-                        continue; // Triangle is not in the same plane
-                    }
-
-                    // Look for an edge that match one of the edges of the face
-                    auto &triangle = sortedTriangles[t2];
-                    for (int fi = 0; fi < currentFaceIndices.size(); ++fi){
-
-                        // fi-th edge of the face
-                        size_t vertexIndexA = currentFaceIndices[fi];
-                        size_t vertexIndexB = currentFaceIndices[(fi + 1)%currentFaceIndices.size()];
-
-                        // We can assume the winding order is correct, therefore matching indices as follows
-                        if(triangle.vertexIndex0 == vertexIndexB && triangle.vertexIndex1 == vertexIndexA){
-                            currentFaceIndices.insert(currentFaceIndices.begin() + fi + 1, triangle.vertexIndex2);
-                            triangleIncluded[t2] = true;
-                            mergeFound = true;
-                            break;
-                        }
-                        else if(triangle.vertexIndex1 == vertexIndexB && triangle.vertexIndex2 == vertexIndexA){
-                            currentFaceIndices.insert(currentFaceIndices.begin() + fi + 1, triangle.vertexIndex0);
-                            triangleIncluded[t2] = true;
-                            mergeFound = true;
-                            break;
-                        }
-                        else if(triangle.vertexIndex2 == vertexIndexB && triangle.vertexIndex0 == vertexIndexA){
-                            currentFaceIndices.insert(currentFaceIndices.begin() + fi + 1, triangle.vertexIndex1);
-                            triangleIncluded[t2] = true;
-                            mergeFound = true;
-                            break;
-                        }
-                    }
-
-                    if(mergeFound) break;
-                }
+    // 1. Map each directed edge to the triangle it belongs to
+    auto edgeKey = [](size_t vertexIndexA, size_t vertexIndexB){ return std::make_pair(vertexIndexA, vertexIndexB); };
+    auto edgeHash = [](const std::pair<size_t, size_t>& edge){
+        return std::hash<size_t>()(edge.first) ^ (std::hash<size_t>()(edge.second) + 0x9e3779b9 + (edge.first << 6) + (edge.first >> 2));
+    };
+    std::unordered_map<std::pair<size_t, size_t>, size_t, decltype(edgeHash)> halfEdgeTriangles(3 * triangles.size(), edgeHash);
+    for (size_t t = 0; t < triangles.size(); ++t){
+        const auto& triangle = triangles[t];
+        halfEdgeTriangles.emplace(edgeKey(triangle.vertexIndex0, triangle.vertexIndex1), t);
+        halfEdgeTriangles.emplace(edgeKey(triangle.vertexIndex1, triangle.vertexIndex2), t);
+        halfEdgeTriangles.emplace(edgeKey(triangle.vertexIndex2, triangle.vertexIndex0), t);
+    }
 
-            } while(mergeFound);
-
-
-            // Postprocess: Remove unnecessary vertices
-            bool duplicateRemoved;
-            do{
-                duplicateRemoved = false;
-                for (auto i = 0; i < currentFaceIndices.size(); ++i){
-                    auto j = (i + 2)%currentFaceIndices.size();
-
-                    if(currentFaceIndices[i] == currentFaceIndices[j]){
-                        // Remove indices in between
-                        if(j > i){
-                            currentFaceIndices.erase(currentFaceIndices.begin() + i, currentFaceIndices.begin() + j);
-                        }
-                        else {
-                            // Remove ones at the back first
-                            currentFaceIndices.erase(currentFaceIndices.begin() + i, currentFaceIndices.begin() + currentFaceIndices.size());
-                            // Then at the front
-                            currentFaceIndices.erase(currentFaceIndices.begin(), currentFaceIndices.begin() + j);
-                        }
-                        duplicateRemoved = true;
-                        break;
-                    }
-                }
-            } while(duplicateRemoved);
-
-            // Compute the normal using Newell's method again and check if the face is facing the right direction
-            glm::vec3 normal(0.0f);
-            for (int i = 0; i < currentFaceIndices.size(); ++i){
-                auto j = (i + 1)%currentFaceIndices.size();
-                normal.x += (vertices[currentFaceIndices[i]].y - vertices[currentFaceIndices[j]].y) * (vertices[currentFaceIndices[i]].z + vertices[currentFaceIndices[j]].z);
-                normal.y += (vertices[currentFaceIndices[i]].z - vertices[currentFaceIndices[j]].z) * (vertices[currentFaceIndices[i]].x + vertices[currentFaceIndices[j]].x);
-                normal.z += (vertices[currentFaceIndices[i]].x - vertices[currentFaceIndices[j]].x) * (vertices[currentFaceIndices[i]].y + vertices[currentFaceIndices[j]].y);
+    // 2. Grow faces from the seeds
+    std::vector<IndexFace> createdFaces;
+    std::vector<bool> triangleIncluded(triangles.size(), false);
+
+    // Boundary of the current face as a linked list, edge i runs from boundaryVertices[i] to boundaryVertices[boundaryNext[i]]
+    std::vector<size_t> boundaryVertices;
+    std::vector<size_t> boundaryNext;
+    std::vector<size_t> openEdges;
+
+    for (const auto seed: sortedTriangleIndices){
+
+        // Continue to the next triangle if already included in a face
+        if(triangleIncluded[seed]) continue;
+        triangleIncluded[seed] = true;
+
+        const auto& seedTriangle = triangles[seed];
+        boundaryVertices = {seedTriangle.vertexIndex0, seedTriangle.vertexIndex1, seedTriangle.vertexIndex2};
+        boundaryNext = {1, 2, 0};
+        openEdges = {0, 1, 2};
+
+        const glm::vec3 seedNormal = triangleNormals[seed];
+        const bool degenerateSeed = triangleAreas[seed] <= 0.0f;
+        const Plane seedPlane(degenerateSeed ? glm::vec3(0, 0, 1) : seedNormal, vertices[seedTriangle.vertexIndex0]);
+
+        while(!degenerateSeed && !openEdges.empty()){
+            const auto edge = openEdges.back();
+            openEdges.pop_back();
+
+            // The neighbouring triangle across this boundary edge has the same edge in the opposite direction
+            const auto vertexIndexA = boundaryVertices[edge];
+            const auto vertexIndexB = boundaryVertices[boundaryNext[edge]];
+            const auto neighbour = halfEdgeTriangles.find(edgeKey(vertexIndexB, vertexIndexA));
+            if(neighbour == halfEdgeTriangles.end() || triangleIncluded[neighbour->second]) continue;
+
+            // Only merge triangles that lie in the plane of the seed and face the same direction
+            const auto& triangle = triangles[neighbour->second];
+            float eps = 1e-3f;
+            if(seedPlane.distance(vertices[triangle.vertexIndex0]) > eps ||
+               seedPlane.distance(vertices[triangle.vertexIndex1]) > eps ||
+               seedPlane.distance(vertices[triangle.vertexIndex2]) > eps ||
+               glm::dot(seedNormal, triangleNormals[neighbour->second]) < 0.0f){
+                continue;
             }
-            auto n = glm::normalize(normal);
-            auto d = -glm::dot(normal, vertices[currentFaceIndices[0]]);
 
-            // Add the face to the list of createdFaces
-            createdFaces.emplace_back(currentFaceIndices);
+            // Insert the third vertex of the triangle in the boundary edge, both resulting edges become open
+            size_t apexIndex;
+            if(triangle.vertexIndex0 == vertexIndexB && triangle.vertexIndex1 == vertexIndexA) apexIndex = triangle.vertexIndex2;
+            else if(triangle.vertexIndex1 == vertexIndexB && triangle.vertexIndex2 == vertexIndexA) apexIndex = triangle.vertexIndex0;
+            else apexIndex = triangle.vertexIndex1;
+
+            triangleIncluded[neighbour->second] = true;
+            boundaryVertices.emplace_back(apexIndex);
+            boundaryNext.emplace_back(boundaryNext[edge]);
+            boundaryNext[edge] = boundaryVertices.size() - 1;
+            openEdges.emplace_back(edge);
+            openEdges.emplace_back(boundaryVertices.size() - 1);
         }
-        this->faces = std::move(createdFaces);
+
+        // 3. Walk the boundary and remove spikes (a, b, a) left by triangles that share more than one edge with the face
+        std::vector<size_t> currentFaceIndices;
+        size_t boundaryEdge = 0;
+        do {
+            const auto vertexIndex = boundaryVertices[boundaryEdge];
+            if(currentFaceIndices.size() >= 2 && currentFaceIndices[currentFaceIndices.size() - 2] == vertexIndex){
+                currentFaceIndices.pop_back();
+            }
+            else{
+                currentFaceIndices.emplace_back(vertexIndex);
+            }
+            boundaryEdge = boundaryNext[boundaryEdge];
+        } while(boundaryEdge != 0);
+
+        // Spikes that wrap around the start of the boundary
+        size_t front = 0;
+        bool spikeRemoved;
+        do {
+            spikeRemoved = false;
+            const auto size = currentFaceIndices.size() - front;
+            if(size < 4) break;
+            if(currentFaceIndices[currentFaceIndices.size() - 2] == currentFaceIndices[front]){
+                currentFaceIndices.pop_back();
+                currentFaceIndices.pop_back();
+                spikeRemoved = true;
+            }
+            else if(currentFaceIndices.back() == currentFaceIndices[front + 1]){
+                currentFaceIndices.pop_back();
+                front++;
+                spikeRemoved = true;
+            }
+        } while(spikeRemoved);
+        currentFaceIndices.erase(currentFaceIndices.begin(), currentFaceIndices.begin() + static_cast<long>(front));
+
+        createdFaces.emplace_back(currentFaceIndices);
     }
+    this->faces = std::move(createdFaces);
 }
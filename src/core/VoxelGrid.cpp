@@ -0,0 +1,195 @@
+#include "meshcore/core/VoxelGrid.h"
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+    inline size_t popCount(uint64_t word) {
+#if defined(_MSC_VER)
+        return __popcnt64(word);
+#else
+        return __builtin_popcountll(word);
+#endif
+    }
+}
+
+VoxelGrid::VoxelGrid(const glm::uvec3 &dimensions, const Vertex &origin, const Vertex &voxelSize):
+    dimensions(dimensions),
+    origin(origin),
+    voxelSize(voxelSize),
+    wordsPerRow((dimensions.x + 63) / 64),
+    words(wordsPerRow * dimensions.y * dimensions.z, 0)
+{}
+
+const glm::uvec3 &VoxelGrid::getDimensions() const {
+    return dimensions;
+}
+
+const Vertex &VoxelGrid::getOrigin() const {
+    return origin;
+}
+
+const Vertex &VoxelGrid::getVoxelSize() const {
+    return voxelSize;
+}
+
+AABB VoxelGrid::getBounds() const {
+    return {origin, origin + Vertex(dimensions) * voxelSize};
+}
+
+const std::string &VoxelGrid::getName() const {
+    return name;
+}
+
+void VoxelGrid::setName(const std::string &newName) {
+    this->name = newName;
+}
+
+const uint64_t *VoxelGrid::getRow(unsigned int y, unsigned int z) const {
+    return words.data() + (static_cast<size_t>(z) * dimensions.y + y) * wordsPerRow;
+}
+
+uint64_t *VoxelGrid::getRow(unsigned int y, unsigned int z) {
+    return words.data() + (static_cast<size_t>(z) * dimensions.y + y) * wordsPerRow;
+}
+
+bool VoxelGrid::isOccupied(unsigned int x, unsigned int y, unsigned int z) const {
+    assert(x < dimensions.x && y < dimensions.y && z < dimensions.z);
+    return (getRow(y, z)[x / 64] >> (x % 64)) & 1u;
+}
+
+void VoxelGrid::setOccupied(unsigned int x, unsigned int y, unsigned int z, bool occupied) {
+    assert(x < dimensions.x && y < dimensions.y && z < dimensions.z);
+    auto& word = getRow(y, z)[x / 64];
+    const uint64_t mask = uint64_t(1) << (x % 64);
+    word = occupied ? (word | mask) : (word & ~mask);
+}
+
+void VoxelGrid::setRowRange(unsigned int y, unsigned int z, unsigned int xBegin, unsigned int xEnd) {
+    assert(xBegin <= xEnd && xEnd <= dimensions.x);
+    auto row = getRow(y, z);
+    while(xBegin < xEnd){
+        const auto bitIndex = xBegin % 64;
+        const auto bitCount = std::min(64u - bitIndex, xEnd - xBegin);
+        const uint64_t mask = (bitCount == 64 ? ~uint64_t(0) : ((uint64_t(1) << bitCount) - 1)) << bitIndex;
+        row[xBegin / 64] |= mask;
+        xBegin += bitCount;
+    }
+}
+
+void VoxelGrid::setColumnRange(unsigned int x, unsigned int z, unsigned int yBegin, unsigned int yEnd) {
+    assert(x < dimensions.x && yBegin <= yEnd && yEnd <= dimensions.y);
+
+    // Rows of consecutive y are stored next to each other, so the column's words are wordsPerRow apart
+    if(yBegin == yEnd){
+        return;
+    }
+    auto word = getRow(yBegin, z) + x / 64;
+    const uint64_t mask = uint64_t(1) << (x % 64);
+    for (auto y = yBegin; y < yEnd; ++y, word += wordsPerRow){
+        *word |= mask;
+    }
+}
+
+size_t VoxelGrid::getOccupiedCount() const {
+    size_t count = 0;
+    for (const auto &word: words){
+        count += popCount(word);
+    }
+    return count;
+}
+
+float VoxelGrid::getVolume() const {
+    return static_cast<float>(getOccupiedCount()) * voxelSize.x * voxelSize.y * voxelSize.z;
+}
+
+/**
+ * @return The 64 bits of row (y,z) starting at x = firstBit, bits outside the grid are zero
+ */
+uint64_t VoxelGrid::extractBits(unsigned int y, unsigned int z, long long firstBit) const {
+    const long long wordIndex = firstBit >= 0 ? firstBit / 64 : -((63 - firstBit) / 64);
+    const auto shift = static_cast<unsigned int>(firstBit - wordIndex * 64);
+    const auto row = getRow(y, z);
+    const auto rowWords = static_cast<long long>(wordsPerRow);
+    const uint64_t low = (wordIndex >= 0 && wordIndex < rowWords) ? row[wordIndex] : 0;
+    if(shift == 0){
+        return low;
+    }
+    const uint64_t high = (wordIndex + 1 >= 0 && wordIndex + 1 < rowWords) ? row[wordIndex + 1] : 0;
+    return (low >> shift) | (high << (64 - shift));
+}
+
+template<bool stopAtFirstOverlap>
+size_t VoxelGrid::countOverlap(const VoxelGrid &other, const glm::ivec3 &otherOffset) const {
+    assert(glm::all(glm::equal(voxelSize, other.voxelSize)) && "Overlap is only defined for grids with equal voxel sizes");
+
+    // Range of this grid's voxels that can be covered by the other grid
+    const long long xBegin = std::max(0LL, static_cast<long long>(otherOffset.x));
+    const long long yBegin = std::max(0LL, static_cast<long long>(otherOffset.y));
+    const long long zBegin = std::max(0LL, static_cast<long long>(otherOffset.z));
+    const long long xEnd = std::min(static_cast<long long>(dimensions.x), static_cast<long long>(other.dimensions.x) + otherOffset.x);
+    const long long yEnd = std::min(static_cast<long long>(dimensions.y), static_cast<long long>(other.dimensions.y) + otherOffset.y);
+    const long long zEnd = std::min(static_cast<long long>(dimensions.z), static_cast<long long>(other.dimensions.z) + otherOffset.z);
+    if(xBegin >= xEnd || yBegin >= yEnd || zBegin >= zEnd){
+        return 0;
+    }
+
+    const auto wordBegin = static_cast<size_t>(xBegin / 64);
+    const auto wordEnd = static_cast<size_t>((xEnd + 63) / 64);
+
+    size_t count = 0;
+    for (long long z = zBegin; z < zEnd; ++z){
+        for (long long y = yBegin; y < yEnd; ++y){
+            const auto row = getRow(y, z);
+            for (size_t w = wordBegin; w < wordEnd; ++w){
+                if(row[w] == 0){
+                    continue;
+                }
+                const auto overlap = row[w] & other.extractBits(y - otherOffset.y, z - otherOffset.z, static_cast<long long>(64 * w) - otherOffset.x);
+                if(overlap != 0){
+                    if constexpr (stopAtFirstOverlap){
+                        return 1;
+                    }
+                    count += popCount(overlap);
+                }
+            }
+        }
+    }
+    return count;
+}
+
+size_t VoxelGrid::getOverlapCount(const VoxelGrid &other, const glm::ivec3 &otherOffset) const {
+    return countOverlap<false>(other, otherOffset);
+}
+
+bool VoxelGrid::intersects(const VoxelGrid &other, const glm::ivec3 &otherOffset) const {
+    return countOverlap<true>(other, otherOffset) > 0;
+}
+
+bool VoxelGrid::isContainedIn(const VoxelGrid &container, const glm::ivec3 &offset) const {
+    assert(glm::all(glm::equal(voxelSize, container.voxelSize)) && "Containment is only defined for grids with equal voxel sizes");
+
+    for (unsigned int z = 0; z < dimensions.z; ++z){
+        for (unsigned int y = 0; y < dimensions.y; ++y){
+            const auto row = getRow(y, z);
+            const long long containerY = static_cast<long long>(y) + offset.y;
+            const long long containerZ = static_cast<long long>(z) + offset.z;
+            const bool rowInContainer = containerY >= 0 && containerY < container.dimensions.y && containerZ >= 0 && containerZ < container.dimensions.z;
+            for (size_t w = 0; w < wordsPerRow; ++w){
+                if(row[w] == 0){
+                    continue;
+                }
+                if(!rowInContainer){
+                    return false;
+                }
+                if((row[w] & ~container.extractBits(containerY, containerZ, static_cast<long long>(64 * w) + offset.x)) != 0){
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
@@ -8,6 +8,17 @@
 
 int WorldSpaceMesh::nextId = 0;
 
+WorldSpaceMesh::WarmStart::WarmStart(const WarmStart &other) {
+    *this = other;
+}
+
+WorldSpaceMesh::WarmStart &WorldSpaceMesh::WarmStart::operator=(const WarmStart &other) {
+    for (size_t i = 0; i < indices.size(); ++i){
+        indices[i].store(other.indices[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    return *this;
+}
+
 WorldSpaceMesh::WorldSpaceMesh():
 id(std::to_string(nextId++)),
 modelSpaceMesh(std::make_shared<ModelSpaceMesh>(ModelSpaceMesh()))
@@ -80,6 +91,46 @@ AABB WorldSpaceMesh::computeWorldSpaceAABB() const {
     return {minimum, maximum};
 }
 
+/**
+ * @brief Compute the exact world space AABB from six support queries on the convex hull of the mesh.
+ *
+ * Each query hill climbs over the hull's vertex adjacency, starting from the extreme vertex found by the previous call.
+ * After a small change of the rotation the extreme vertices are close to the previous ones, making this nearly O(1).
+ * Concurrent calls on the same instance are safe, they only compete for the warm start.
+ */
+AABB WorldSpaceMesh::computeTightWorldSpaceAABB() const {
+    std::array<size_t, 6> extremeIndices{};
+    for (size_t i = 0; i < extremeIndices.size(); ++i){
+        extremeIndices[i] = extremeHullVertexIndices.indices[i].load(std::memory_order_relaxed);
+    }
+    const auto aabb = this->modelSpaceMesh->getConvexHull()->computeSupportAABB(this->modelTransformation.getPosition(), this->modelTransformation.getRotation(), this->modelTransformation.getScale(), extremeIndices);
+    for (size_t i = 0; i < extremeIndices.size(); ++i){
+        extremeHullVertexIndices.indices[i].store(extremeIndices[i], std::memory_order_relaxed);
+    }
+    return aabb;
+}
+
+/**
+ * @brief Compute a world space AABB that encloses the mesh by transforming the OBB of the model space mesh.
+ *
+ * The OBB is cached by the model space mesh, after which each query takes constant time. Suitable for a broad phase.
+ */
+AABB WorldSpaceMesh::computeConservativeWorldSpaceAABB() const {
+    const auto& modelSpaceOBB = this->modelSpaceMesh->getOBB();
+    const auto& obbBounds = modelSpaceOBB.getAabb();
+
+    // Rotation from the OBB's frame to world space, the extent along each world axis follows from its absolute value
+    const auto obbToWorld = glm::mat3((this->modelTransformation.getRotation() * modelSpaceOBB.getRotation()).computeMatrix());
+    const auto half = obbBounds.getHalf() * this->modelTransformation.getScale();
+    Vertex worldSpaceHalf(0.0f);
+    for (int column = 0; column < 3; ++column){
+        worldSpaceHalf += glm::abs(obbToWorld[column]) * half[column];
+    }
+
+    const auto worldSpaceCenter = this->modelTransformation.transformVertex(modelSpaceOBB.getRotation().rotateVertex(obbBounds.getCenter()));
+    return {worldSpaceCenter - worldSpaceHalf, worldSpaceCenter + worldSpaceHalf};
+}
+
 glm::vec3 WorldSpaceMesh::computeSupport(const glm::vec3 &direction) const {
 
     // Transform the direction to modelSpace
@@ -0,0 +1,167 @@
+#include "meshcore/factories/VoxelGridFactory.h"
+#include "meshcore/acceleration/BoundingVolumeHierarchy.h"
+#include "meshcore/acceleration/CachingBoundsTreeFactory.h"
+#include "meshcore/geometric/AABBTriangleData.h"
+#include "meshcore/geometric/Intersection.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <tbb/parallel_for.h>
+
+namespace {
+    // Fractions of a voxel the rays are offset from the voxel centers, so they don't run exactly through edges of
+    // triangulated faces that are aligned with the grid
+    constexpr float RAY_JITTER_Y = 1.2345e-4f;
+    constexpr float RAY_JITTER_Z = 2.7183e-4f;
+
+    // Hits closer than this fraction of a voxel, with the same facing, are a single crossing through a shared edge or vertex
+    constexpr float DUPLICATE_HIT_TOLERANCE = 1e-4f;
+}
+
+float VoxelGridFactory::computeVoxelSize(const ModelSpaceMesh &modelSpaceMesh, unsigned int resolution) {
+    if(resolution == 0){
+        throw std::invalid_argument("The resolution of a voxel grid should be positive");
+    }
+    const auto& bounds = modelSpaceMesh.getBounds();
+    const auto size = bounds.getMaximum() - bounds.getMinimum();
+    const auto longestSide = std::max(size.x, std::max(size.y, size.z));
+    return longestSide > 0.0f ? longestSide / static_cast<float>(resolution) : 1.0f;
+}
+
+std::shared_ptr<VoxelGrid> VoxelGridFactory::createEmptyVoxelGrid(const ModelSpaceMesh &modelSpaceMesh, float voxelSize) {
+    if(!(voxelSize > 0.0f)){
+        throw std::invalid_argument("The voxel size should be positive");
+    }
+    if(modelSpaceMesh.getTriangles().empty()){
+        throw std::invalid_argument("Can't voxelise a mesh without triangles");
+    }
+    const auto& bounds = modelSpaceMesh.getBounds();
+    const auto minimumIndex = glm::floor(bounds.getMinimum() / voxelSize);
+    const auto maximumIndex = glm::floor(bounds.getMaximum() / voxelSize);
+    auto voxelGrid = std::make_shared<VoxelGrid>(glm::uvec3(maximumIndex - minimumIndex) + glm::uvec3(1), minimumIndex * voxelSize, Vertex(voxelSize));
+    voxelGrid->setName(modelSpaceMesh.getName());
+    return voxelGrid;
+}
+
+void VoxelGridFactory::addSurfaceVoxels(const ModelSpaceMesh &modelSpaceMesh, VoxelGrid &voxelGrid) {
+
+    const auto& dimensions = voxelGrid.getDimensions();
+    const auto& origin = voxelGrid.getOrigin();
+    const auto voxelSize = voxelGrid.getVoxelSize().x;
+    const auto& vertices = modelSpaceMesh.getVertices();
+
+    // Voxel range covered by the bounds of each triangle, clamped to the grid
+    const auto toVoxelIndex = [&](const Vertex& point){
+        return glm::uvec3(glm::clamp(glm::floor((point - origin) / voxelSize), Vertex(0.0f), Vertex(dimensions - glm::uvec3(1))));
+    };
+    std::vector<VertexTriangle> triangles;
+    std::vector<std::pair<glm::uvec3, glm::uvec3>> voxelRanges;
+    triangles.reserve(modelSpaceMesh.getTriangles().size());
+    voxelRanges.reserve(modelSpaceMesh.getTriangles().size());
+    for (const auto& indexTriangle: modelSpaceMesh.getTriangles()){
+        const auto& triangle = triangles.emplace_back(vertices[indexTriangle.vertexIndex0], vertices[indexTriangle.vertexIndex1], vertices[indexTriangle.vertexIndex2]);
+        voxelRanges.emplace_back(toVoxelIndex(glm::min(glm::min(triangle.vertices[0], triangle.vertices[1]), triangle.vertices[2])),
+                                 toVoxelIndex(glm::max(glm::max(triangle.vertices[0], triangle.vertices[1]), triangle.vertices[2])));
+    }
+
+    // Bin the triangles per layer of voxels along the z-axis
+    std::vector<std::vector<unsigned int>> layerTriangles(dimensions.z);
+    for (unsigned int triangleIndex = 0; triangleIndex < triangles.size(); ++triangleIndex){
+        for (auto z = voxelRanges[triangleIndex].first.z; z <= voxelRanges[triangleIndex].second.z; ++z){
+            layerTriangles[z].emplace_back(triangleIndex);
+        }
+    }
+
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, dimensions.z), [&](const tbb::blocked_range<unsigned int>& range){
+        for (auto z = range.begin(); z < range.end(); ++z){
+            for (const auto triangleIndex: layerTriangles[z]){
+                const auto& triangle = triangles[triangleIndex];
+                const AABBTriangleData triangleData(triangle);
+                const auto& [first, last] = voxelRanges[triangleIndex];
+                for (auto y = first.y; y <= last.y; ++y){
+                    for (auto x = first.x; x <= last.x; ++x){
+                        if(voxelGrid.isOccupied(x, y, z)){
+                            continue;
+                        }
+                        const auto minimum = origin + voxelSize * Vertex(x, y, z);
+                        if(Intersection::intersect(AABB(minimum, minimum + Vertex(voxelSize)), triangle, triangleData)){
+                            voxelGrid.setOccupied(x, y, z);
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+std::shared_ptr<VoxelGrid> VoxelGridFactory::createSurfaceVoxelGrid(const std::shared_ptr<ModelSpaceMesh> &modelSpaceMesh, float voxelSize) {
+    auto voxelGrid = createEmptyVoxelGrid(*modelSpaceMesh, voxelSize);
+    addSurfaceVoxels(*modelSpaceMesh, *voxelGrid);
+    return voxelGrid;
+}
+
+std::shared_ptr<VoxelGrid> VoxelGridFactory::createSolidVoxelGrid(const std::shared_ptr<ModelSpaceMesh> &modelSpaceMesh, float voxelSize, bool includeSurface) {
+
+    auto voxelGrid = createEmptyVoxelGrid(*modelSpaceMesh, voxelSize);
+    const auto& dimensions = voxelGrid->getDimensions();
+    const auto& origin = voxelGrid->getOrigin();
+    const auto& tree = CachingBoundsTreeFactory<BoundingVolumeHierarchy>::getBoundsTree(modelSpaceMesh);
+
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, dimensions.z), [&](const tbb::blocked_range<unsigned int>& range){
+        std::vector<BoundingVolumeHierarchy::RayHit> hits;
+        for (auto z = range.begin(); z < range.end(); ++z){
+            for (unsigned int y = 0; y < dimensions.y; ++y){
+
+                // Cast a ray along the x-axis, starting one voxel before the grid, so its distances are measured along x
+                const Vertex rayOrigin = origin + voxelSize * Vertex(-1.0f, float(y) + 0.5f + RAY_JITTER_Y, float(z) + 0.5f + RAY_JITTER_Z);
+                const Ray ray(rayOrigin, glm::vec3(1.0f, 0.0f, 0.0f));
+                hits.clear();
+                tree->queryRayHits(ray, hits);
+                std::sort(hits.begin(), hits.end(), [](const auto& a, const auto& b){ return a.distance < b.distance; });
+
+                // Track the winding number along the ray, the ray enters the mesh through front faces and leaves through back faces
+                int winding = 0;
+                float spanStart = 0.0f;
+                float previousDistance = -std::numeric_limits<float>::max();
+                bool previousEntering = false;
+                for (const auto& hit: hits){
+                    const auto entering = tree->getTriangles()[hit.triangleIndex].normal.x < 0.0f;
+                    if(entering == previousEntering && hit.distance - previousDistance < DUPLICATE_HIT_TOLERANCE * voxelSize){
+                        continue;
+                    }
+                    previousDistance = hit.distance;
+                    previousEntering = entering;
+
+                    if(entering && winding++ == 0){
+                        spanStart = hit.distance;
+                    }
+                    else if(!entering && winding > 0 && --winding == 0){
+                        // Occupy the voxels whose centers lie in the span, distances are one voxel ahead of the grid
+                        const auto first = std::ceil(spanStart / voxelSize - 1.5f);
+                        const auto end = std::ceil(hit.distance / voxelSize - 1.5f);
+                        const auto xBegin = static_cast<unsigned int>(std::clamp(first, 0.0f, float(dimensions.x)));
+                        const auto xEnd = static_cast<unsigned int>(std::clamp(end, 0.0f, float(dimensions.x)));
+                        if(xBegin < xEnd){
+                            voxelGrid->setRowRange(y, z, xBegin, xEnd);
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    if(includeSurface){
+        addSurfaceVoxels(*modelSpaceMesh, *voxelGrid);
+    }
+    return voxelGrid;
+}
+
+std::vector<std::shared_ptr<VoxelGrid>> VoxelGridFactory::createSolidVoxelGrids(const std::vector<std::shared_ptr<ModelSpaceMesh>> &modelSpaceMeshes, float voxelSize, bool includeSurface) {
+    std::vector<std::shared_ptr<VoxelGrid>> voxelGrids(modelSpaceMeshes.size());
+    tbb::parallel_for(size_t(0), modelSpaceMeshes.size(), [&](size_t index){
+        voxelGrids[index] = createSolidVoxelGrid(modelSpaceMeshes[index], voxelSize, includeSurface);
+    });
+    return voxelGrids;
+}
@@ -0,0 +1,429 @@
+#include "meshcore/geometric/CollisionProxy.h"
+#include "meshcore/acceleration/BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <tbb/parallel_for.h>
+
+namespace {
+
+    /** Sum of squared distances to a set of planes, as a symmetric 4x4 matrix **/
+    struct Quadric {
+        std::array<double, 10> coefficients{}; // aa, ab, ac, ad, bb, bc, bd, cc, cd, dd
+
+        void addPlane(const glm::dvec3& normal, double offset, double weight) {
+            const double plane[4] = {normal.x, normal.y, normal.z, offset};
+            size_t index = 0;
+            for (int row = 0; row < 4; ++row){
+                for (int column = row; column < 4; ++column){
+                    coefficients[index++] += weight * plane[row] * plane[column];
+                }
+            }
+        }
+
+        Quadric& operator+=(const Quadric& other) {
+            for (size_t index = 0; index < coefficients.size(); ++index){
+                coefficients[index] += other.coefficients[index];
+            }
+            return *this;
+        }
+
+        [[nodiscard]] double evaluate(const glm::dvec3& point) const {
+            const auto& q = coefficients;
+            return q[0]*point.x*point.x + 2.0*q[1]*point.x*point.y + 2.0*q[2]*point.x*point.z + 2.0*q[3]*point.x
+                 + q[4]*point.y*point.y + 2.0*q[5]*point.y*point.z + 2.0*q[6]*point.y
+                 + q[7]*point.z*point.z + 2.0*q[8]*point.z
+                 + q[9];
+        }
+
+        /** Point with the smallest error, if the quadric isn't (nearly) singular **/
+        [[nodiscard]] std::optional<glm::dvec3> computeMinimum() const {
+            const auto& q = coefficients;
+            const glm::dvec3 row0(q[0], q[1], q[2]);
+            const glm::dvec3 row1(q[1], q[4], q[5]);
+            const glm::dvec3 row2(q[2], q[5], q[7]);
+            const glm::dvec3 rightHandSide(-q[3], -q[6], -q[8]);
+            const auto determinant = glm::dot(row0, glm::cross(row1, row2));
+            const auto scale = q[0] + q[4] + q[7];
+            if(std::abs(determinant) <= 1e-9 * scale * scale * scale){
+                return std::nullopt;
+            }
+            // Cramer's rule, the matrix is symmetric so its rows are its columns
+            return glm::dvec3(glm::dot(rightHandSide, glm::cross(row1, row2)),
+                              glm::dot(row0, glm::cross(rightHandSide, row2)),
+                              glm::dot(row0, glm::cross(row1, rightHandSide))) / determinant;
+        }
+    };
+
+    /** Triangle mesh with shared vertices, as needed for edge collapses **/
+    struct IndexedMesh {
+        std::vector<Vertex> vertices;
+        std::vector<std::array<unsigned int, 3>> triangles;
+    };
+
+    /** Merges vertices at the same position **/
+    IndexedMesh weldVertices(const ModelSpaceMesh& modelSpaceMesh) {
+        const auto& vertices = modelSpaceMesh.getVertices();
+        std::vector<unsigned int> order(vertices.size());
+        std::iota(order.begin(), order.end(), 0u);
+        const auto less = [&vertices](unsigned int first, unsigned int second){
+            const auto& a = vertices[first];
+            const auto& b = vertices[second];
+            return a.x != b.x ? a.x < b.x : a.y != b.y ? a.y < b.y : a.z < b.z;
+        };
+        std::sort(order.begin(), order.end(), less);
+
+        IndexedMesh result;
+        std::vector<unsigned int> remapping(vertices.size());
+        for (size_t i = 0; i < order.size(); ++i){
+            if(i == 0 || vertices[order[i]] != vertices[order[i - 1]]){
+                result.vertices.emplace_back(vertices[order[i]]);
+            }
+            remapping[order[i]] = static_cast<unsigned int>(result.vertices.size() - 1);
+        }
+        for (const auto& triangle: modelSpaceMesh.getTriangles()){
+            const std::array<unsigned int, 3> indices = {remapping[triangle.vertexIndex0], remapping[triangle.vertexIndex1], remapping[triangle.vertexIndex2]};
+            if(indices[0] != indices[1] && indices[1] != indices[2] && indices[2] != indices[0]){
+                result.triangles.emplace_back(indices);
+            }
+        }
+        return result;
+    }
+
+    /** Each directed edge occurs exactly once, and so does its reverse **/
+    bool isClosedManifold(const IndexedMesh& mesh) {
+        if(mesh.triangles.size() < 4){
+            return false;
+        }
+        std::vector<std::pair<unsigned int, unsigned int>> edges;
+        edges.reserve(3 * mesh.triangles.size());
+        for (const auto& triangle: mesh.triangles){
+            for (int i = 0; i < 3; ++i){
+                edges.emplace_back(triangle[i], triangle[(i + 1) % 3]);
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        if(std::adjacent_find(edges.begin(), edges.end()) != edges.end()){
+            return false;
+        }
+        return std::all_of(edges.begin(), edges.end(), [&edges](const auto& edge){
+            return std::binary_search(edges.begin(), edges.end(), std::make_pair(edge.second, edge.first));
+        });
+    }
+
+    /**
+     * Quadric error edge collapses (Garland and Heckbert) on a closed manifold mesh, until at most the target number of
+     * triangles remains. Collapses that would make the mesh non-manifold or flip a triangle are skipped.
+     */
+    IndexedMesh simplify(const IndexedMesh& mesh, size_t targetTriangles) {
+        auto positions = std::vector<glm::dvec3>(mesh.vertices.begin(), mesh.vertices.end());
+        auto triangles = mesh.triangles;
+        std::vector<unsigned char> removedTriangles(triangles.size(), false);
+        std::vector<unsigned char> removedVertices(positions.size(), false);
+        std::vector<unsigned int> versions(positions.size(), 0);
+        std::vector<std::vector<unsigned int>> vertexTriangles(positions.size());
+        std::vector<Quadric> quadrics(positions.size());
+
+        const auto computeNormal = [&](const std::array<unsigned int, 3>& triangle){
+            return glm::cross(positions[triangle[1]] - positions[triangle[0]], positions[triangle[2]] - positions[triangle[0]]);
+        };
+        for (unsigned int triangleIndex = 0; triangleIndex < triangles.size(); ++triangleIndex){
+            const auto& triangle = triangles[triangleIndex];
+            const auto normal = computeNormal(triangle);
+            const auto doubleArea = glm::length(normal);
+            if(doubleArea > 0.0){
+                const auto unitNormal = normal / doubleArea;
+                for (const auto vertexIndex: triangle){
+                    quadrics[vertexIndex].addPlane(unitNormal, -glm::dot(unitNormal, positions[triangle[0]]), doubleArea);
+                }
+            }
+            for (const auto vertexIndex: triangle){
+                vertexTriangles[vertexIndex].emplace_back(triangleIndex);
+            }
+        }
+
+        struct Collapse {
+            double cost;
+            unsigned int first, second;
+            unsigned int firstVersion, secondVersion;
+            glm::dvec3 position;
+            bool operator>(const Collapse& other) const { return cost > other.cost; }
+        };
+        std::priority_queue<Collapse, std::vector<Collapse>, std::greater<>> queue;
+
+        const auto pushCollapse = [&](unsigned int first, unsigned int second){
+            auto quadric = quadrics[first];
+            quadric += quadrics[second];
+            const auto& a = positions[first];
+            const auto& b = positions[second];
+            std::array<glm::dvec3, 4> candidates = {a, b, (a + b) * 0.5, (a + b) * 0.5};
+            const auto minimum = quadric.computeMinimum();
+            const auto edgeLength = glm::length(b - a);
+            if(minimum && glm::length(minimum.value() - (a + b) * 0.5) <= 2.0 * edgeLength){
+                candidates[3] = minimum.value();
+            }
+            auto position = candidates[0];
+            auto cost = quadric.evaluate(position);
+            for (size_t i = 1; i < candidates.size(); ++i){
+                const auto candidateCost = quadric.evaluate(candidates[i]);
+                if(candidateCost < cost){
+                    cost = candidateCost;
+                    position = candidates[i];
+                }
+            }
+            queue.push({std::max(cost, 0.0), first, second, versions[first], versions[second], position});
+        };
+        const auto collectNeighbours = [&](unsigned int vertexIndex){
+            std::vector<unsigned int> neighbours;
+            for (const auto triangleIndex: vertexTriangles[vertexIndex]){
+                for (const auto other: triangles[triangleIndex]){
+                    if(other != vertexIndex){
+                        neighbours.emplace_back(other);
+                    }
+                }
+            }
+            std::sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+            return neighbours;
+        };
+
+        for (const auto& triangle: triangles){
+            for (int i = 0; i < 3; ++i){
+                if(triangle[i] < triangle[(i + 1) % 3]){ // Every edge once, the reverse edge is in the neighbouring triangle
+                    pushCollapse(triangle[i], triangle[(i + 1) % 3]);
+                }
+            }
+        }
+
+        // Moving a vertex shouldn't flip or degenerate any of its remaining triangles
+        const auto keepsOrientation = [&](unsigned int vertexIndex, unsigned int otherIndex, const glm::dvec3& position){
+            for (const auto triangleIndex: vertexTriangles[vertexIndex]){
+                auto triangle = triangles[triangleIndex];
+                if(std::find(triangle.begin(), triangle.end(), otherIndex) != triangle.end()){
+                    continue; // Removed by the collapse
+                }
+                const auto oldNormal = computeNormal(triangle);
+                const auto oldPosition = positions[vertexIndex];
+                positions[vertexIndex] = position;
+                const auto newNormal = computeNormal(triangle);
+                positions[vertexIndex] = oldPosition;
+                const auto oldLength = glm::length(oldNormal);
+                const auto newLength = glm::length(newNormal);
+                if(newLength <= 1e-12 * std::max(oldLength, 1e-30) || glm::dot(oldNormal, newNormal) < 0.2 * oldLength * newLength){
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        auto remainingTriangles = triangles.size();
+        while(remainingTriangles > std::max(targetTriangles, size_t(4)) && !queue.empty()){
+            const auto collapse = queue.top();
+            queue.pop();
+            const auto first = collapse.first;
+            const auto second = collapse.second;
+            if(removedVertices[first] || removedVertices[second] || versions[first] != collapse.firstVersion || versions[second] != collapse.secondVersion){
+                continue; // Outdated
+            }
+
+            // Link condition: the edge's endpoints share exactly the two vertices opposite to the edge
+            const auto firstNeighbours = collectNeighbours(first);
+            const auto secondNeighbours = collectNeighbours(second);
+            std::vector<unsigned int> sharedNeighbours;
+            std::set_intersection(firstNeighbours.begin(), firstNeighbours.end(), secondNeighbours.begin(), secondNeighbours.end(), std::back_inserter(sharedNeighbours));
+            if(sharedNeighbours.size() != 2){
+                continue;
+            }
+            if(!keepsOrientation(first, second, collapse.position) || !keepsOrientation(second, first, collapse.position)){
+                continue;
+            }
+
+            // Collapse the second vertex into the first one
+            positions[first] = collapse.position;
+            quadrics[first] += quadrics[second];
+            for (const auto triangleIndex: vertexTriangles[second]){
+                auto& triangle = triangles[triangleIndex];
+                if(std::find(triangle.begin(), triangle.end(), first) != triangle.end()){
+                    removedTriangles[triangleIndex] = true;
+                    remainingTriangles--;
+                    for (const auto vertexIndex: triangle){
+                        if(vertexIndex != second){
+                            auto& incident = vertexTriangles[vertexIndex];
+                            incident.erase(std::find(incident.begin(), incident.end(), triangleIndex));
+                        }
+                    }
+                }
+                else {
+                    std::replace(triangle.begin(), triangle.end(), second, first);
+                    vertexTriangles[first].emplace_back(triangleIndex);
+                }
+            }
+            vertexTriangles[second].clear();
+            removedVertices[second] = true;
+            versions[first]++;
+            for (const auto neighbour: collectNeighbours(first)){
+                pushCollapse(first, neighbour);
+            }
+        }
+
+        // Compact the remaining vertices and triangles
+        IndexedMesh result;
+        std::vector<unsigned int> remapping(positions.size(), 0);
+        for (size_t vertexIndex = 0; vertexIndex < positions.size(); ++vertexIndex){
+            if(!removedVertices[vertexIndex] && !vertexTriangles[vertexIndex].empty()){
+                remapping[vertexIndex] = static_cast<unsigned int>(result.vertices.size());
+                result.vertices.emplace_back(positions[vertexIndex]);
+            }
+        }
+        for (size_t triangleIndex = 0; triangleIndex < triangles.size(); ++triangleIndex){
+            if(!removedTriangles[triangleIndex]){
+                const auto& triangle = triangles[triangleIndex];
+                result.triangles.push_back({remapping[triangle[0]], remapping[triangle[1]], remapping[triangle[2]]});
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Moves each vertex along its normal, far enough that the planes of all its triangles move outwards by at least
+     * the inflation. Steep corners are limited to four times the inflation.
+     */
+    std::shared_ptr<ModelSpaceMesh> inflate(const IndexedMesh& mesh, float inflation) {
+        std::vector<glm::vec3> vertexNormals(mesh.vertices.size(), glm::vec3(0.0f));
+        std::vector<glm::vec3> triangleNormals;
+        triangleNormals.reserve(mesh.triangles.size());
+        for (const auto& triangle: mesh.triangles){
+            const auto normal = glm::cross(mesh.vertices[triangle[1]] - mesh.vertices[triangle[0]], mesh.vertices[triangle[2]] - mesh.vertices[triangle[0]]);
+            for (const auto vertexIndex: triangle){
+                vertexNormals[vertexIndex] += normal; // Area weighted
+            }
+            const auto length = glm::length(normal);
+            triangleNormals.emplace_back(length > 0.0f ? normal / length : glm::vec3(0.0f));
+        }
+        std::vector<float> minimumCosines(mesh.vertices.size(), 1.0f);
+        for (auto& normal: vertexNormals){
+            const auto length = glm::length(normal);
+            normal = length > 0.0f ? normal / length : glm::vec3(0.0f);
+        }
+        for (size_t triangleIndex = 0; triangleIndex < mesh.triangles.size(); ++triangleIndex){
+            for (const auto vertexIndex: mesh.triangles[triangleIndex]){
+                minimumCosines[vertexIndex] = std::min(minimumCosines[vertexIndex], glm::dot(vertexNormals[vertexIndex], triangleNormals[triangleIndex]));
+            }
+        }
+
+        std::vector<Vertex> vertices;
+        vertices.reserve(mesh.vertices.size());
+        for (size_t vertexIndex = 0; vertexIndex < mesh.vertices.size(); ++vertexIndex){
+            const auto offset = inflation / std::max(minimumCosines[vertexIndex], 0.25f);
+            vertices.emplace_back(mesh.vertices[vertexIndex] + offset * vertexNormals[vertexIndex]);
+        }
+        std::vector<IndexTriangle> triangles;
+        triangles.reserve(mesh.triangles.size());
+        for (const auto& triangle: mesh.triangles){
+            triangles.emplace_back(triangle[0], triangle[1], triangle[2]);
+        }
+        return std::make_shared<ModelSpaceMesh>(vertices, triangles);
+    }
+
+    /** No triangle of the mesh crosses the proxy's surface and all of its vertices lie inside the proxy **/
+    bool encloses(const std::shared_ptr<ModelSpaceMesh>& proxy, const ModelSpaceMesh& modelSpaceMesh) {
+        const BoundingVolumeHierarchy tree(proxy);
+        const auto& vertices = modelSpaceMesh.getVertices();
+        const auto& triangles = modelSpaceMesh.getTriangles();
+        std::atomic<bool> enclosed = true;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, std::max(vertices.size(), triangles.size())), [&](const tbb::blocked_range<size_t>& range){
+            for (size_t index = range.begin(); index < range.end() && enclosed; ++index){
+                if(index < vertices.size() && !tree.containsPoint(vertices[index])){
+                    enclosed = false;
+                }
+                if(index < triangles.size()){
+                    const auto& triangle = triangles[index];
+                    if(tree.intersectsTriangle(VertexTriangle(vertices[triangle.vertexIndex0], vertices[triangle.vertexIndex1], vertices[triangle.vertexIndex2]))){
+                        enclosed = false;
+                    }
+                }
+            }
+        });
+        return enclosed;
+    }
+
+    /** Largest distance from a vertex of the mesh outside of the simplified mesh to its surface **/
+    float computeOutsideDistance(const std::shared_ptr<ModelSpaceMesh>& simplified, const ModelSpaceMesh& modelSpaceMesh) {
+        const BoundingVolumeHierarchy tree(simplified);
+        const auto& vertices = modelSpaceMesh.getVertices();
+        std::vector<float> distances(vertices.size(), 0.0f);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, vertices.size()), [&](const tbb::blocked_range<size_t>& range){
+            for (size_t index = range.begin(); index < range.end(); ++index){
+                if(!tree.containsPoint(vertices[index])){
+                    BoundingVolumeHierarchy::ClosestTriangleQueryResult result;
+                    tree.queryClosestTriangle(vertices[index], &result);
+                    distances[index] = std::sqrt(result.lowerDistanceBoundSquared);
+                }
+            }
+        });
+        return distances.empty() ? 0.0f : *std::max_element(distances.begin(), distances.end());
+    }
+}
+
+CollisionProxy::CollisionProxy(const ModelSpaceMesh& modelSpaceMesh, const CollisionProxyParameters& parameters) {
+
+    if(modelSpaceMesh.getTriangles().size() <= parameters.targetTriangles){
+        mesh = std::make_shared<ModelSpaceMesh>(modelSpaceMesh);
+        return;
+    }
+
+    // Meshes that aren't closed can't be inflated consistently, their convex hull encloses them as well
+    auto indexedMesh = weldVertices(modelSpaceMesh);
+    if(!isClosedManifold(indexedMesh)){
+        const auto& convexHull = modelSpaceMesh.getConvexHull();
+        if(convexHull->getTriangles().size() <= parameters.targetTriangles){
+            mesh = convexHull;
+            return;
+        }
+        indexedMesh = weldVertices(*convexHull);
+    }
+
+    const auto simplifiedMesh = simplify(indexedMesh, parameters.targetTriangles);
+    const auto bounds = modelSpaceMesh.getBounds();
+    const auto diagonal = glm::length(bounds.getMaximum() - bounds.getMinimum());
+    auto currentInflation = std::max(parameters.minimumInflation, computeOutsideDistance(inflate(simplifiedMesh, 0.0f), modelSpaceMesh) + 1e-4f * diagonal);
+    for (unsigned int attempt = 0; attempt < parameters.maximumAttempts; ++attempt){
+        auto candidate = inflate(simplifiedMesh, currentInflation);
+        if(encloses(candidate, modelSpaceMesh)){
+            mesh = candidate;
+            inflation = currentInflation;
+            simplified = true;
+            return;
+        }
+        currentInflation *= 1.5f;
+    }
+    mesh = modelSpaceMesh.getConvexHull();
+}
+
+const std::shared_ptr<ModelSpaceMesh>& CollisionProxy::getMesh() const {
+    return mesh;
+}
+
+float CollisionProxy::getInflation() const {
+    return inflation;
+}
+
+bool CollisionProxy::isSimplified() const {
+    return simplified;
+}
+
+float CollisionProxyStatistics::getRejectionRate() const {
+    const auto tests = proxyTests.load();
+    return tests == 0 ? 0.0f : static_cast<float>(rejections.load()) / static_cast<float>(tests);
+}
+
+void CollisionProxyStatistics::reset() {
+    boundsRejections = 0;
+    proxyTests = 0;
+    rejections = 0;
+    fullTests = 0;
+}
@@ -0,0 +1,450 @@
+#include "meshcore/geometric/ConvexDecomposition.h"
+#include "meshcore/geometric/Distance.h"
+#include "meshcore/geometric/GJK.h"
+#include "meshcore/geometric/Intersection.h"
+#include "meshcore/acceleration/BoundingVolumeHierarchy.h"
+#include "meshcore/factories/VoxelGridFactory.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <tbb/parallel_for.h>
+
+namespace {
+
+    /** Box of grid cells, the maximum is exclusive **/
+    struct Region {
+        std::array<int, 3> minimum;
+        std::array<int, 3> maximum;
+    };
+
+    /** Occupied voxels of a solid voxelisation, with prefix sums to count them in any region in constant time **/
+    class VoxelPrefixSums {
+        Vertex origin;
+        float voxelSize;
+        std::array<int, 3> size;
+        std::vector<unsigned int> prefixSums; // Number of occupied voxels below each grid corner, (size + 1) corners per axis
+
+        [[nodiscard]] size_t computeCornerIndex(int x, int y, int z) const {
+            return (static_cast<size_t>(z) * (size[1] + 1) + y) * (size[0] + 1) + x;
+        }
+
+    public:
+        explicit VoxelPrefixSums(const VoxelGrid& voxelGrid): origin(voxelGrid.getOrigin()), voxelSize(voxelGrid.getVoxelSize().x) {
+            for (int axis = 0; axis < 3; ++axis){
+                size[axis] = static_cast<int>(voxelGrid.getDimensions()[axis]);
+            }
+            prefixSums.assign(static_cast<size_t>(size[0] + 1) * (size[1] + 1) * (size[2] + 1), 0);
+            for (int z = 1; z <= size[2]; ++z){
+                for (int y = 1; y <= size[1]; ++y){
+                    for (int x = 1; x <= size[0]; ++x){
+                        prefixSums[computeCornerIndex(x, y, z)] = (voxelGrid.isOccupied(x - 1, y - 1, z - 1) ? 1u : 0u)
+                                + prefixSums[computeCornerIndex(x - 1, y, z)] + prefixSums[computeCornerIndex(x, y - 1, z)] + prefixSums[computeCornerIndex(x, y, z - 1)]
+                                - prefixSums[computeCornerIndex(x - 1, y - 1, z)] - prefixSums[computeCornerIndex(x - 1, y, z - 1)] - prefixSums[computeCornerIndex(x, y - 1, z - 1)]
+                                + prefixSums[computeCornerIndex(x - 1, y - 1, z - 1)];
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] unsigned int countOccupiedVoxels(const Region& region) const {
+            const auto& [x0, y0, z0] = region.minimum;
+            const auto& [x1, y1, z1] = region.maximum;
+            return prefixSums[computeCornerIndex(x1, y1, z1)]
+                   - prefixSums[computeCornerIndex(x0, y1, z1)] - prefixSums[computeCornerIndex(x1, y0, z1)] - prefixSums[computeCornerIndex(x1, y1, z0)]
+                   + prefixSums[computeCornerIndex(x0, y0, z1)] + prefixSums[computeCornerIndex(x0, y1, z0)] + prefixSums[computeCornerIndex(x1, y0, z0)]
+                   - prefixSums[computeCornerIndex(x0, y0, z0)];
+        }
+
+        [[nodiscard]] AABB computeBounds(const Region& region) const {
+            return {origin + voxelSize * glm::vec3(region.minimum[0], region.minimum[1], region.minimum[2]),
+                    origin + voxelSize * glm::vec3(region.maximum[0], region.maximum[1], region.maximum[2])};
+        }
+
+        [[nodiscard]] float getVoxelVolume() const { return voxelSize * voxelSize * voxelSize; }
+
+        /** Voxels covering the bounds, the grid itself may extend past them by a voxel **/
+        [[nodiscard]] Region computeRegion(const AABB& bounds) const {
+            Region region{};
+            for (int axis = 0; axis < 3; ++axis){
+                const auto minimum = std::floor((bounds.getMinimum()[axis] - origin[axis]) / voxelSize);
+                const auto maximum = std::ceil((bounds.getMaximum()[axis] - origin[axis]) / voxelSize);
+                region.minimum[axis] = std::clamp(static_cast<int>(minimum), 0, size[axis] - 1);
+                region.maximum[axis] = std::clamp(static_cast<int>(maximum), region.minimum[axis] + 1, size[axis]);
+            }
+            return region;
+        }
+    };
+
+    /**
+     * Sutherland-Hodgman clipping of a triangle to a box, appending the vertices of the clipped polygon.
+     * Only the part of the surface bounding the mesh's interior inside the box is kept, so polygons that collapse onto
+     * the box's boundary and triangles in a side of the box that face into it are discarded.
+     */
+    void clipTriangle(const VertexTriangle& triangle, const AABB& box, float tolerance, std::vector<Vertex>& result) {
+        for (int axis = 0; axis < 3; ++axis){
+            for (const auto side: {-1.0f, 1.0f}){
+                const auto limit = side < 0.0f ? box.getMinimum()[axis] : box.getMaximum()[axis];
+                if(std::abs(triangle.vertices[0][axis] - limit) <= tolerance && std::abs(triangle.vertices[1][axis] - limit) <= tolerance &&
+                   std::abs(triangle.vertices[2][axis] - limit) <= tolerance && side * triangle.normal[axis] <= 0.0f){
+                    return;
+                }
+            }
+        }
+
+        std::vector<Vertex> polygon = {triangle.vertices[0], triangle.vertices[1], triangle.vertices[2]};
+        std::vector<Vertex> clipped;
+        for (int axis = 0; axis < 3 && !polygon.empty(); ++axis){
+            for (const auto side: {-1.0f, 1.0f}){
+                const auto limit = side < 0.0f ? box.getMinimum()[axis] : box.getMaximum()[axis];
+                clipped.clear();
+                for (size_t i = 0; i < polygon.size(); ++i){
+                    const auto& current = polygon[i];
+                    const auto& next = polygon[(i + 1) % polygon.size()];
+                    const auto currentDistance = side * (current[axis] - limit); // Inside when not positive
+                    const auto nextDistance = side * (next[axis] - limit);
+                    if(currentDistance <= 0.0f){
+                        clipped.push_back(current);
+                    }
+                    if((currentDistance < 0.0f && nextDistance > 0.0f) || (currentDistance > 0.0f && nextDistance < 0.0f)){
+                        auto intersection = current + (next - current) * (currentDistance / (currentDistance - nextDistance));
+                        intersection[axis] = limit;
+                        clipped.push_back(intersection);
+                    }
+                }
+                std::swap(polygon, clipped);
+                if(polygon.empty()){
+                    break;
+                }
+            }
+        }
+        glm::vec3 areaVector(0.0f);
+        for (size_t i = 1; i + 1 < polygon.size(); ++i){
+            areaVector += glm::cross(polygon[i] - polygon[0], polygon[i + 1] - polygon[0]);
+        }
+        if(glm::length(areaVector) > tolerance * tolerance){
+            result.insert(result.end(), polygon.begin(), polygon.end());
+        }
+    }
+
+    struct Piece {
+        Region region;
+        std::vector<size_t> triangleIndices; // Triangles of the mesh overlapping the region
+        std::shared_ptr<ModelSpaceMesh> hull;
+        float concavity = 0.0f;
+    };
+
+    /** Convex hull of the mesh clipped to the region: the clipped triangles and the region's corners inside the mesh **/
+    Piece createPiece(const Region& region, const std::vector<size_t>& candidateTriangles, const BoundingVolumeHierarchy& tree,
+                      const VoxelPrefixSums& grid, float meshVolume) {
+        Piece piece{region, {}, nullptr, 0.0f};
+        const auto box = grid.computeBounds(region);
+        const auto tolerance = 1e-4f * glm::length(box.getMaximum() - box.getMinimum());
+        std::vector<Vertex> points;
+        for (const auto triangleIndex: candidateTriangles){
+            const auto& triangle = tree.getTriangles()[triangleIndex];
+            if(Intersection::intersect(triangle.bounds, box)){
+                piece.triangleIndices.push_back(triangleIndex);
+                clipTriangle(triangle, box, tolerance, points);
+            }
+        }
+
+        // Corners on the mesh's surface only belong to the piece if the interior extends into the box, so they are tested slightly inwards
+        for (int corner = 0; corner < 8; ++corner){
+            const Vertex point((corner & 1 ? box.getMaximum() : box.getMinimum()).x,
+                               (corner & 2 ? box.getMaximum() : box.getMinimum()).y,
+                               (corner & 4 ? box.getMaximum() : box.getMinimum()).z);
+            if(tree.containsPoint(point + tolerance * glm::normalize(box.getCenter() - point))){
+                points.push_back(point);
+            }
+        }
+        if(points.size() < 4){
+            return piece;
+        }
+
+        piece.hull = ModelSpaceMesh(points).getConvexHull();
+        const auto insideVolume = static_cast<float>(grid.countOccupiedVoxels(region)) * grid.getVoxelVolume();
+        piece.concavity = std::max(0.0f, piece.hull->getVolume() - insideVolume) / meshVolume;
+        return piece;
+    }
+
+    /** Best split of the piece's region, among a few evenly spaced planes along each axis **/
+    std::optional<std::pair<Piece, Piece>> splitPiece(const Piece& piece, const BoundingVolumeHierarchy& tree, const VoxelPrefixSums& grid, float meshVolume) {
+        constexpr int planesPerAxis = 7;
+        std::vector<std::pair<int, int>> planes; // Axis and cell index
+        for (int axis = 0; axis < 3; ++axis){
+            const auto cells = piece.region.maximum[axis] - piece.region.minimum[axis];
+            const auto count = std::min(cells - 1, planesPerAxis);
+            for (int k = 1; k <= count; ++k){
+                const auto position = piece.region.minimum[axis] + static_cast<int>(std::lround(static_cast<float>(k * cells) / static_cast<float>(count + 1)));
+                if(planes.empty() || planes.back() != std::make_pair(axis, position)){
+                    planes.emplace_back(axis, position);
+                }
+            }
+        }
+
+        std::vector<std::optional<std::pair<Piece, Piece>>> candidates(planes.size());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, planes.size(), 1), [&](const tbb::blocked_range<size_t>& range){
+            for (size_t planeIndex = range.begin(); planeIndex < range.end(); ++planeIndex){
+                const auto [axis, position] = planes[planeIndex];
+                auto lowerRegion = piece.region;
+                auto upperRegion = piece.region;
+                lowerRegion.maximum[axis] = position;
+                upperRegion.minimum[axis] = position;
+                if(grid.countOccupiedVoxels(lowerRegion) == 0 || grid.countOccupiedVoxels(upperRegion) == 0){
+                    continue;
+                }
+                auto lower = createPiece(lowerRegion, piece.triangleIndices, tree, grid, meshVolume);
+                auto upper = createPiece(upperRegion, piece.triangleIndices, tree, grid, meshVolume);
+                if(lower.hull && upper.hull){
+                    candidates[planeIndex] = std::make_pair(std::move(lower), std::move(upper));
+                }
+            }
+        });
+
+        std::optional<std::pair<Piece, Piece>> best;
+        float bestVolume = std::numeric_limits<float>::max();
+        for (auto& candidate: candidates){
+            if(candidate){
+                const auto volume = candidate->first.hull->getVolume() + candidate->second.hull->getVolume();
+                if(volume < bestVolume){
+                    bestVolume = volume;
+                    best = std::move(candidate);
+                }
+            }
+        }
+        return best;
+    }
+}
+
+ConvexDecomposition::ConvexDecomposition(const ModelSpaceMesh &modelSpaceMesh, const ConvexDecompositionParameters &parameters) {
+
+    // Convex meshes and meshes without volume are represented by their convex hull
+    if(modelSpaceMesh.getTriangles().empty() || modelSpaceMesh.isConvex()){
+        pieces.push_back(modelSpaceMesh.getConvexHull());
+        buildTree();
+        return;
+    }
+
+    const auto meshCopy = std::make_shared<ModelSpaceMesh>(modelSpaceMesh);
+    const BoundingVolumeHierarchy tree(meshCopy);
+    const auto voxelSize = VoxelGridFactory::computeVoxelSize(modelSpaceMesh, std::max(1u, parameters.volumeResolution));
+    const VoxelPrefixSums grid(*VoxelGridFactory::createSolidVoxelGrid(meshCopy, voxelSize));
+    const auto rootRegion = grid.computeRegion(modelSpaceMesh.getBounds());
+    const auto meshVolume = std::max(static_cast<float>(grid.countOccupiedVoxels(rootRegion)) * grid.getVoxelVolume(), std::numeric_limits<float>::min());
+
+    std::vector<size_t> allTriangles(tree.getTriangles().size());
+    std::iota(allTriangles.begin(), allTriangles.end(), 0);
+    std::vector<Piece> openPieces;
+    std::vector<Piece> finishedPieces;
+    auto root = createPiece(rootRegion, allTriangles, tree, grid, meshVolume);
+    if(!root.hull){
+        pieces.push_back(modelSpaceMesh.getConvexHull());
+        buildTree();
+        return;
+    }
+    openPieces.push_back(std::move(root));
+
+    // Split the least convex piece until all are within the tolerance
+    while(!openPieces.empty() && openPieces.size() + finishedPieces.size() < std::max<size_t>(1, parameters.maximumPieces)){
+        const auto worst = std::max_element(openPieces.begin(), openPieces.end(), [](const Piece& first, const Piece& second){
+            return first.concavity < second.concavity;
+        });
+        if(worst->concavity <= parameters.concavityTolerance){
+            break;
+        }
+        auto piece = std::move(*worst);
+        openPieces.erase(worst);
+
+        auto children = splitPiece(piece, tree, grid, meshVolume);
+        if(!children){
+            finishedPieces.push_back(std::move(piece));
+            continue;
+        }
+        openPieces.push_back(std::move(children->first));
+        openPieces.push_back(std::move(children->second));
+    }
+
+    openPieces.insert(openPieces.end(), std::make_move_iterator(finishedPieces.begin()), std::make_move_iterator(finishedPieces.end()));
+    for (const auto& piece: openPieces){
+        pieces.push_back(piece.hull);
+        concavity = std::max(concavity, piece.concavity);
+    }
+    buildTree();
+}
+
+void ConvexDecomposition::buildTree() {
+    nodes.clear();
+    if(pieces.empty()){
+        return;
+    }
+
+    // Top down, splitting the pieces at the median of their centers along the longest axis
+    std::vector<unsigned int> order(pieces.size());
+    std::iota(order.begin(), order.end(), 0);
+    struct Task {
+        size_t nodeIndex;
+        size_t begin;
+        size_t end;
+    };
+    std::vector<Task> stack = {{0, 0, pieces.size()}};
+    nodes.emplace_back();
+    while(!stack.empty()){
+        const auto task = stack.back();
+        stack.pop_back();
+
+        Vertex minimum(std::numeric_limits<float>::max());
+        Vertex maximum(-std::numeric_limits<float>::max());
+        Vertex centerMinimum(std::numeric_limits<float>::max());
+        Vertex centerMaximum(-std::numeric_limits<float>::max());
+        for (auto index = task.begin; index < task.end; ++index){
+            const auto& bounds = pieces[order[index]]->getBounds();
+            minimum = glm::min(minimum, bounds.getMinimum());
+            maximum = glm::max(maximum, bounds.getMaximum());
+            centerMinimum = glm::min(centerMinimum, bounds.getCenter());
+            centerMaximum = glm::max(centerMaximum, bounds.getCenter());
+        }
+        nodes[task.nodeIndex].bounds = AABB(minimum, maximum);
+
+        if(task.end - task.begin == 1){
+            nodes[task.nodeIndex].firstChildOrPieceIndex = order[task.begin];
+            continue;
+        }
+
+        const auto extent = centerMaximum - centerMinimum;
+        const int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+        const auto middle = task.begin + (task.end - task.begin) / 2;
+        std::nth_element(order.begin() + task.begin, order.begin() + middle, order.begin() + task.end, [&](unsigned int first, unsigned int second){
+            return pieces[first]->getBounds().getCenter()[axis] < pieces[second]->getBounds().getCenter()[axis];
+        });
+
+        const auto firstChild = nodes.size();
+        nodes[task.nodeIndex].split = true;
+        nodes[task.nodeIndex].firstChildOrPieceIndex = firstChild;
+        nodes.emplace_back();
+        nodes.emplace_back();
+        stack.push_back({firstChild, task.begin, middle});
+        stack.push_back({firstChild + 1, middle, task.end});
+    }
+}
+
+void ConvexDecomposition::computeWorldSpaceBounds(const Transformation &transformation, std::vector<AABB> &worldSpaceBounds) const {
+    std::array<glm::vec3, 3> absoluteAxes;
+    for (int axis = 0; axis < 3; ++axis){
+        glm::vec3 direction(0.0f);
+        direction[axis] = 1.0f;
+        absoluteAxes[axis] = glm::abs(transformation.getRotation().rotateVertex(direction));
+    }
+    worldSpaceBounds.clear();
+    worldSpaceBounds.reserve(nodes.size());
+    for (const auto& node: nodes){
+        const auto center = transformation.getPosition() + transformation.getScale() * transformation.getRotation().rotateVertex(node.bounds.getCenter());
+        const auto half = node.bounds.getHalf();
+        const auto worldSpaceHalf = transformation.getScale() * (absoluteAxes[0] * half.x + absoluteAxes[1] * half.y + absoluteAxes[2] * half.z);
+        worldSpaceBounds.emplace_back(center - worldSpaceHalf, center + worldSpaceHalf);
+    }
+}
+
+const std::vector<std::shared_ptr<ModelSpaceMesh>> &ConvexDecomposition::getPieces() const {
+    return pieces;
+}
+
+const std::vector<ConvexDecomposition::Node> &ConvexDecomposition::getNodes() const {
+    return nodes;
+}
+
+float ConvexDecomposition::getConcavity() const {
+    return concavity;
+}
+
+/**
+ * @brief Dual traversal of both piece hierarchies, with a GJK test for each pair of leaves whose world space bounds overlap.
+ */
+bool ConvexDecomposition::intersects(const Transformation &transformation, const ConvexDecomposition &other, const Transformation &otherTransformation) const {
+    if(nodes.empty() || other.nodes.empty()){
+        return false;
+    }
+    std::vector<AABB> bounds;
+    std::vector<AABB> otherBounds;
+    computeWorldSpaceBounds(transformation, bounds);
+    other.computeWorldSpaceBounds(otherTransformation, otherBounds);
+
+    std::vector<std::pair<unsigned int, unsigned int>> stack = {{0, 0}};
+    while(!stack.empty()){
+        const auto [nodeIndex, otherNodeIndex] = stack.back();
+        stack.pop_back();
+        if(!Intersection::intersect(bounds[nodeIndex], otherBounds[otherNodeIndex])){
+            continue;
+        }
+
+        const auto& node = nodes[nodeIndex];
+        const auto& otherNode = other.nodes[otherNodeIndex];
+        if(!node.split && !otherNode.split){
+            const GJKTransformedMesh piece(*pieces[node.firstChildOrPieceIndex], transformation);
+            const GJKTransformedMesh otherPiece(*other.pieces[otherNode.firstChildOrPieceIndex], otherTransformation);
+            if(!GJK::hasSeparation(piece, otherPiece)){
+                return true;
+            }
+            continue;
+        }
+
+        const bool descendOther = otherNode.split && (!node.split || otherBounds[otherNodeIndex].getVolume() > bounds[nodeIndex].getVolume());
+        for (unsigned int i = 0; i < 2; ++i){
+            stack.emplace_back(descendOther ? nodeIndex : node.firstChildOrPieceIndex + i, descendOther ? otherNode.firstChildOrPieceIndex + i : otherNodeIndex);
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Branch and bound over both piece hierarchies, pruning node pairs whose world space bounds are further apart than the closest pieces so far.
+ */
+float ConvexDecomposition::computeDistance(const Transformation &transformation, const ConvexDecomposition &other, const Transformation &otherTransformation) const {
+    if(nodes.empty() || other.nodes.empty()){
+        return std::numeric_limits<float>::max();
+    }
+    std::vector<AABB> bounds;
+    std::vector<AABB> otherBounds;
+    computeWorldSpaceBounds(transformation, bounds);
+    other.computeWorldSpaceBounds(otherTransformation, otherBounds);
+
+    float closestDistanceSquared = std::numeric_limits<float>::max();
+    std::vector<std::pair<unsigned int, unsigned int>> stack = {{0, 0}};
+    while(!stack.empty()){
+        const auto [nodeIndex, otherNodeIndex] = stack.back();
+        stack.pop_back();
+        if(Distance::distanceSquared(bounds[nodeIndex], otherBounds[otherNodeIndex]) >= closestDistanceSquared){
+            continue;
+        }
+
+        const auto& node = nodes[nodeIndex];
+        const auto& otherNode = other.nodes[otherNodeIndex];
+        if(!node.split && !otherNode.split){
+            const GJKTransformedMesh piece(*pieces[node.firstChildOrPieceIndex], transformation);
+            const GJKTransformedMesh otherPiece(*other.pieces[otherNode.firstChildOrPieceIndex], otherTransformation);
+            const auto distanceSquared = GJK::computeDistanceSqr(piece, otherPiece);
+            if(!distanceSquared.has_value()){
+                return 0.0f;
+            }
+            closestDistanceSquared = std::min(closestDistanceSquared, distanceSquared.value());
+            continue;
+        }
+
+        // Visit the closest child pair first, so it tightens the bound before the other one is considered
+        const bool descendOther = otherNode.split && (!node.split || otherBounds[otherNodeIndex].getVolume() > bounds[nodeIndex].getVolume());
+        std::array<std::pair<unsigned int, unsigned int>, 2> children;
+        for (unsigned int i = 0; i < 2; ++i){
+            children[i] = {descendOther ? nodeIndex : node.firstChildOrPieceIndex + i, descendOther ? otherNode.firstChildOrPieceIndex + i : otherNodeIndex};
+        }
+        if(Distance::distanceSquared(bounds[children[0].first], otherBounds[children[0].second]) < Distance::distanceSquared(bounds[children[1].first], otherBounds[children[1].second])){
+            std::swap(children[0], children[1]);
+        }
+        stack.push_back(children[0]);
+        stack.push_back(children[1]);
+    }
+    return std::sqrt(closestDistanceSquared);
+}
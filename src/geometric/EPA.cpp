@@ -0,0 +1,239 @@
+#include "meshcore/geometric/GJK.h"
+#include <algorithm>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtx/norm.hpp>
+
+namespace {
+
+    constexpr float EPA_TOLERANCE = 1e-4f;
+    constexpr int EPA_MAXIMUM_ITERATIONS = 64;
+
+    struct PolytopeFace {
+        std::array<size_t, 3> vertices;
+        glm::vec3 normal;
+        float distance;
+    };
+
+    /** Continue from a line simplex (newest point last), returns true if the origin lies on it **/
+    bool updateLine(std::vector<glm::vec3>& simplex, glm::vec3& direction) {
+        const auto a = simplex[1];
+        const auto ab = simplex[0] - a;
+        const auto ao = -a;
+        if(glm::dot(ab, ao) > 0.0f){
+            direction = glm::cross(glm::cross(ab, ao), ab);
+        }
+        else {
+            simplex = {a};
+            direction = ao;
+        }
+        return glm::length2(direction) < GJK_EPSILON * GJK_EPSILON;
+    }
+
+    /** Continue from a triangle simplex (newest point last), returns true if the origin lies in it **/
+    bool updateTriangle(std::vector<glm::vec3>& simplex, glm::vec3& direction) {
+        const auto a = simplex[2];
+        const auto b = simplex[1];
+        const auto c = simplex[0];
+        const auto ab = b - a;
+        const auto ac = c - a;
+        const auto ao = -a;
+        const auto abc = glm::cross(ab, ac);
+        if(glm::length2(abc) < 1e-12f){
+            simplex = {b, a}; // Collinear points
+            return updateLine(simplex, direction);
+        }
+
+        if(glm::dot(glm::cross(abc, ac), ao) > 0.0f){
+            if(glm::dot(ac, ao) > 0.0f){
+                simplex = {c, a};
+                direction = glm::cross(glm::cross(ac, ao), ac);
+                return glm::length2(direction) < GJK_EPSILON * GJK_EPSILON;
+            }
+            simplex = {b, a};
+            return updateLine(simplex, direction);
+        }
+        if(glm::dot(glm::cross(ab, abc), ao) > 0.0f){
+            simplex = {b, a};
+            return updateLine(simplex, direction);
+        }
+
+        const auto side = glm::dot(abc, ao);
+        if(std::abs(side) <= GJK_EPSILON * glm::length(abc)){
+            return true; // The origin lies in the triangle
+        }
+        if(side > 0.0f){
+            direction = abc;
+        }
+        else {
+            simplex = {b, c, a};
+            direction = -abc;
+        }
+        return false;
+    }
+
+    /** Continue from a tetrahedron simplex (newest point last), returns true if the origin lies in it **/
+    bool updateTetrahedron(std::vector<glm::vec3>& simplex, glm::vec3& direction) {
+        const auto a = simplex[3];
+        const auto ao = -a;
+        const std::array<std::array<glm::vec3, 3>, 3> faces = {{{simplex[2], simplex[1], simplex[0]},
+                                                                {simplex[1], simplex[0], simplex[2]},
+                                                                {simplex[0], simplex[2], simplex[1]}}};
+        for(const auto& [b, c, opposite]: faces){
+            auto normal = glm::cross(b - a, c - a);
+            if(glm::dot(normal, opposite - a) > 0.0f){
+                normal = -normal;
+            }
+            if(glm::dot(normal, ao) > 0.0f){
+                simplex = {c, b, a};
+                return updateTriangle(simplex, direction);
+            }
+        }
+        return true;
+    }
+
+    bool addFace(std::vector<PolytopeFace>& faces, const std::vector<glm::vec3>& vertices, size_t a, size_t b, size_t c, const glm::vec3& interiorPoint) {
+        auto normal = glm::cross(vertices[b] - vertices[a], vertices[c] - vertices[a]);
+        const auto length = glm::length(normal);
+        if(length < 1e-12f){
+            return false;
+        }
+        normal /= length;
+        if(glm::dot(normal, vertices[a] - interiorPoint) < 0.0f){
+            normal = -normal;
+            std::swap(b, c);
+        }
+        faces.push_back({{a, b, c}, normal, glm::dot(normal, vertices[a])});
+        return true;
+    }
+}
+
+/**
+ * @brief Penetration depth of two convex shapes through GJK followed by the expanding polytope algorithm (EPA).
+ *
+ * @param penetrationNormal If not null, receives the direction in which the second shape should be moved by the
+ * penetration depth to separate the shapes
+ * @return The penetration depth, zero when the shapes don't intersect
+ */
+float GJK::computePenetrationDepth(const GJKConvexShape &shapeA, const GJKConvexShape &shapeB, glm::vec3 *penetrationNormal) {
+
+    // GJK, looking for a simplex of the Minkowski difference that encloses the origin
+    auto direction = estimateSeparatingDirection(shapeA, shapeB);
+    if(glm::length2(direction) < GJK_EPSILON * GJK_EPSILON){
+        direction = glm::vec3(1.0f, 0.0f, 0.0f);
+    }
+    std::vector<glm::vec3> simplex = {support(shapeA, shapeB, direction).point};
+    direction = -simplex.front();
+    bool enclosed = glm::length2(direction) < GJK_EPSILON * GJK_EPSILON;
+    for(int iteration = 0; iteration < 1000 && !enclosed; ++iteration){
+        const auto point = support(shapeA, shapeB, direction).point;
+        if(glm::dot(point, direction) < 0.0f){
+            return 0.0f; // Separating axis found
+        }
+        simplex.push_back(point);
+        switch(simplex.size()){
+            case 2: enclosed = updateLine(simplex, direction); break;
+            case 3: enclosed = updateTriangle(simplex, direction); break;
+            default: enclosed = updateTetrahedron(simplex, direction); break;
+        }
+    }
+    if(!enclosed){
+        return 0.0f;
+    }
+
+    // The origin can lie on a lower dimensional simplex, blow it up to a tetrahedron
+    const std::array<glm::vec3, 6> axes = {glm::vec3(1,0,0), glm::vec3(-1,0,0), glm::vec3(0,1,0), glm::vec3(0,-1,0), glm::vec3(0,0,1), glm::vec3(0,0,-1)};
+    if(simplex.size() == 1){
+        for(const auto& axis: axes){
+            const auto point = support(shapeA, shapeB, axis).point;
+            if(glm::distance2(point, simplex[0]) > GJK_EPSILON * GJK_EPSILON){
+                simplex.push_back(point);
+                break;
+            }
+        }
+    }
+    if(simplex.size() == 2){
+        const auto line = simplex[1] - simplex[0];
+        const auto lineLength2 = glm::length2(line);
+        for(const auto& axis: axes){
+            const auto perpendicular = glm::cross(line, axis);
+            if(glm::length2(perpendicular) < 1e-8f * lineLength2){
+                continue;
+            }
+            const auto point = support(shapeA, shapeB, perpendicular).point;
+            if(glm::length2(glm::cross(point - simplex[0], line)) > GJK_EPSILON * GJK_EPSILON * lineLength2){
+                simplex.push_back(point);
+                break;
+            }
+        }
+    }
+    if(simplex.size() == 3){
+        const auto normal = glm::normalize(glm::cross(simplex[1] - simplex[0], simplex[2] - simplex[0]));
+        for(const auto& candidate: {normal, -normal}){
+            const auto point = support(shapeA, shapeB, candidate).point;
+            if(std::abs(glm::dot(point - simplex[0], normal)) > GJK_EPSILON){
+                simplex.push_back(point);
+                break;
+            }
+        }
+    }
+    if(simplex.size() < 4){
+        return 0.0f; // The Minkowski difference is flat, the shapes merely touch
+    }
+
+    // EPA, expanding the polytope towards the boundary of the Minkowski difference closest to the origin
+    std::vector<glm::vec3> vertices(simplex.begin(), simplex.end());
+    const auto interiorPoint = (vertices[0] + vertices[1] + vertices[2] + vertices[3]) * 0.25f;
+    std::vector<PolytopeFace> faces;
+    addFace(faces, vertices, 0, 1, 2, interiorPoint);
+    addFace(faces, vertices, 0, 1, 3, interiorPoint);
+    addFace(faces, vertices, 0, 2, 3, interiorPoint);
+    addFace(faces, vertices, 1, 2, 3, interiorPoint);
+    if(faces.size() < 4){
+        return 0.0f;
+    }
+
+    std::vector<std::pair<size_t, size_t>> horizon;
+    PolytopeFace closest = faces.front();
+    for(int iteration = 0; iteration < EPA_MAXIMUM_ITERATIONS && !faces.empty(); ++iteration){
+        closest = *std::min_element(faces.begin(), faces.end(), [](const PolytopeFace& first, const PolytopeFace& second){
+            return first.distance < second.distance;
+        });
+
+        const auto point = support(shapeA, shapeB, closest.normal).point;
+        if(glm::dot(point, closest.normal) - closest.distance < EPA_TOLERANCE * std::max(1.0f, closest.distance)){
+            break;
+        }
+
+        // Remove the faces that see the new point, keeping track of the edges on the boundary of the removed region
+        horizon.clear();
+        for(auto it = faces.begin(); it != faces.end();){
+            if(glm::dot(it->normal, point - vertices[it->vertices[0]]) > 0.0f){
+                for(int edge = 0; edge < 3; ++edge){
+                    const std::pair<size_t, size_t> current = {it->vertices[edge], it->vertices[(edge + 1) % 3]};
+                    const auto reverse = std::find(horizon.begin(), horizon.end(), std::make_pair(current.second, current.first));
+                    if(reverse != horizon.end()){
+                        horizon.erase(reverse);
+                    }
+                    else {
+                        horizon.push_back(current);
+                    }
+                }
+                it = faces.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        vertices.push_back(point);
+        for(const auto& [first, second]: horizon){
+            addFace(faces, vertices, first, second, vertices.size() - 1, interiorPoint);
+        }
+    }
+
+    if(penetrationNormal){
+        *penetrationNormal = closest.normal;
+    }
+    return std::max(0.0f, closest.distance);
+}
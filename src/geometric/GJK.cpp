@@ -3,6 +3,8 @@
 //
 
 #include "meshcore/geometric/GJK.h"
+#include "meshcore/core/ModelSpaceMesh.h"
+#include "meshcore/core/Transformation.h"
 #include <array>
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
@@ -511,3 +513,14 @@ GJKSphere::GJKSphere(const Sphere &sphere): radius(sphere.getRadius()), center(s
 glm::vec3 GJKSphere::getCenter() const {
     return this->center;
 }
+
+GJKTransformedMesh::GJKTransformedMesh(const ModelSpaceMesh &mesh, const Transformation &transformation): mesh(mesh), transformation(transformation) {}
+
+glm::vec3 GJKTransformedMesh::computeSupport(const glm::vec3 &direction) const {
+    supportIndex = mesh.computeSupportIndex(transformation.getRotation().inverseRotateVertex(direction), supportIndex);
+    return transformation.getPosition() + transformation.getScale() * transformation.getRotation().rotateVertex(mesh.getVertices()[supportIndex]);
+}
+
+glm::vec3 GJKTransformedMesh::getCenter() const {
+    return transformation.getPosition() + transformation.getScale() * transformation.getRotation().rotateVertex(mesh.getCenter());
+}
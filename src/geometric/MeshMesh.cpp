@@ -11,9 +11,52 @@
 #include <tbb/parallel_for.h>
 
 #include "meshcore/acceleration/BoundingVolumeHierarchy.h"
+#include "meshcore/acceleration/OrientationCache.h"
+#include "meshcore/geometric/ConvexDecomposition.h"
+#include "meshcore/geometric/CollisionProxy.h"
 
 namespace Intersection {
 
+    /**
+     * @brief Tests whether two meshes, placed by the given transformations, intersect.
+     *
+     * Same as the WorldSpaceMesh overload, without requiring a WorldSpaceMesh for each mesh.
+     */
+    bool intersect(const std::shared_ptr<ModelSpaceMesh>& modelSpaceMeshA, const Transformation& transformationA, const std::shared_ptr<ModelSpaceMesh>& modelSpaceMeshB, const Transformation& transformationB){
+
+        // Actual intersection test
+        const auto triangleCountA = modelSpaceMeshA->getTriangles().size();
+        const auto triangleCountB = modelSpaceMeshB->getTriangles().size();
+        const auto& simplerMesh = triangleCountA < triangleCountB ? modelSpaceMeshA : modelSpaceMeshB;
+        const auto& complexMesh = triangleCountA < triangleCountB ? modelSpaceMeshB : modelSpaceMeshA;
+
+        const auto& simpleTransformation = triangleCountA < triangleCountB ? transformationA : transformationB;
+        const auto& complexTransformation = triangleCountA < triangleCountB ? transformationB : transformationA;
+        const auto simpleToComplexTransformation = complexTransformation.getInverse() * simpleTransformation;
+        const auto& complexObjectTree = CachingBoundsTreeFactory<BoundingVolumeHierarchy>::getBoundsTree(complexMesh);
+
+        bool equalRotation = simpleTransformation.getRotation() == complexTransformation.getRotation() || simpleTransformation.getRotation() == -complexTransformation.getRotation(); // q and -q represent the same rotation
+        bool equalScaling = simpleTransformation.getScale() == complexTransformation.getScale();
+
+        if (equalRotation && equalScaling) {
+
+            // The specific case were the scaling and rotation of the items are equal
+            const auto& simplerObjectTree = CachingBoundsTreeFactory<BoundingVolumeHierarchy>::getBoundsTree(simplerMesh);
+            return complexObjectTree->intersectsTranslated(*simplerObjectTree, simpleToComplexTransformation.getPosition());
+        }
+
+        // The general case where the triangles have to be transformed
+        for (const auto & indexTriangle : simplerMesh->getTriangles()) {
+            VertexTriangle triangle(simplerMesh->getVertices()[indexTriangle.vertexIndex0],
+                                    simplerMesh->getVertices()[indexTriangle.vertexIndex1],
+                                    simplerMesh->getVertices()[indexTriangle.vertexIndex2]);
+            if (complexObjectTree->intersectsTriangle(triangle.getTransformed(simpleToComplexTransformation))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     /**
      * @brief Tests whether two meshes intersect.
      *
@@ -27,52 +70,88 @@ namespace Intersection {
      * @return True if the worldSpaceMeshes intersect, false otherwise.
      */
     bool intersect(const WorldSpaceMesh& worldSpaceMeshA, const WorldSpaceMesh& worldSpaceMeshB){
+        return intersect(worldSpaceMeshA.getModelSpaceMesh(), worldSpaceMeshA.getModelTransformation(), worldSpaceMeshB.getModelSpaceMesh(), worldSpaceMeshB.getModelTransformation());
+    }
 
-        // Actual intersection test
-        const auto triangleCountA = worldSpaceMeshA.getModelSpaceMesh()->getTriangles().size();
-        const auto triangleCountB = worldSpaceMeshB.getModelSpaceMesh()->getTriangles().size();
-        const auto& simplerObject = triangleCountA < triangleCountB ? worldSpaceMeshA : worldSpaceMeshB;
-        const auto& complexObject = triangleCountA < triangleCountB ? worldSpaceMeshB : worldSpaceMeshA;
-
-        const auto& simpleTransformation = simplerObject.getModelTransformation();
-        const auto& complexTransformation = complexObject.getModelTransformation();
-        const auto simpleToComplexTransformation = complexObject.getModelTransformation().getInverse() * simplerObject.getModelTransformation();
-        const auto& complexObjectTree = CachingBoundsTreeFactory<BoundingVolumeHierarchy>::getBoundsTree(complexObject.getModelSpaceMesh());
-
-        bool equalRotation = simpleTransformation.getRotation() == complexTransformation.getRotation();
-        bool equalScaling = simpleTransformation.getScale() == complexTransformation.getScale();
-
-        if (equalRotation && equalScaling) {
-
-            // The specific case were the scaling and rotation of the items are equal
-            const auto simpleToComplexTranslation = simpleToComplexTransformation.getPosition();
-            const auto& simplerObjectTree = CachingBoundsTreeFactory<BoundingVolumeHierarchy>::getBoundsTree(simplerObject.getModelSpaceMesh());
-
-            for (const auto & node : simplerObjectTree->getNodes()) {
-                if (complexObjectTree->intersectsAABB(node.bounds.getTranslated(simpleToComplexTranslation))) {
-                    for (int i = 0; i < node.triangleCount; ++i) {
-                        const VertexTriangle& triangle = simplerObjectTree->getTriangles()[node.firstChildOrTriangleIndex + i];
-                        if (complexObjectTree->intersectsTriangle(triangle.getTranslated(simpleToComplexTranslation))) {
-                            return true;
-                        }
-                    }
-                }
+    /**
+     * @brief Tests whether two meshes intersect, testing their conservative AABBs and collision proxies first.
+     *
+     * The conservative AABBs are derived from the meshes' cached OBBs in constant time and reject pairs that are far apart.
+     * The proxies enclose the meshes, so if neither the proxies' surfaces intersect nor one proxy lies inside the other,
+     * the meshes can't intersect and the full test is skipped. Only worthwhile for detailed meshes, meshes that are
+     * their own proxy go straight to the full test.
+     *
+     * @param statistics Optional, counts the pairs rejected by their bounds, the proxy tests, the full tests and how many full tests were avoided
+     */
+    bool intersectProxyFirst(const WorldSpaceMesh& worldSpaceMeshA, const WorldSpaceMesh& worldSpaceMeshB, CollisionProxyStatistics* statistics){
+        if(!intersect(worldSpaceMeshA.computeConservativeWorldSpaceAABB(), worldSpaceMeshB.computeConservativeWorldSpaceAABB())){
+            if(statistics){
+                statistics->boundsRejections++;
             }
             return false;
         }
 
-        // The general case where the triangles have to be transformed
-        const auto& simplerObjectMesh = simplerObject.getModelSpaceMesh();
+        const auto& modelSpaceMeshA = worldSpaceMeshA.getModelSpaceMesh();
+        const auto& modelSpaceMeshB = worldSpaceMeshB.getModelSpaceMesh();
+        const auto& proxyMeshA = modelSpaceMeshA->getCollisionProxy()->getMesh();
+        const auto& proxyMeshB = modelSpaceMeshB->getCollisionProxy()->getMesh();
 
-        for (const auto & indexTriangle : simplerObjectMesh->getTriangles()) {
-            VertexTriangle triangle(simplerObjectMesh->getVertices()[indexTriangle.vertexIndex0],
-                                    simplerObjectMesh->getVertices()[indexTriangle.vertexIndex1],
-                                    simplerObjectMesh->getVertices()[indexTriangle.vertexIndex2]);
-            if (complexObjectTree->intersectsTriangle(triangle.getTransformed(simpleToComplexTransformation))) {
-                return true;
+        if(proxyMeshA->getTriangles().size() < modelSpaceMeshA->getTriangles().size() || proxyMeshB->getTriangles().size() < modelSpaceMeshB->getTriangles().size()){
+            if(statistics){
+                statistics->proxyTests++;
+            }
+            const auto& transformationA = worldSpaceMeshA.getModelTransformation();
+            const auto& transformationB = worldSpaceMeshB.getModelTransformation();
+            const auto contains = [](const std::shared_ptr<ModelSpaceMesh>& outer, const Transformation& outerTransformation, const std::shared_ptr<ModelSpaceMesh>& inner, const Transformation& innerTransformation){
+                const auto point = outerTransformation.inverseTransformVertex(innerTransformation.transformVertex(inner->getVertices()[0]));
+                return CachingBoundsTreeFactory<BoundingVolumeHierarchy>::getBoundsTree(outer)->containsPoint(point);
+            };
+            const auto proxiesOverlap = intersect(proxyMeshA, transformationA, proxyMeshB, transformationB)
+                    || contains(proxyMeshA, transformationA, proxyMeshB, transformationB)
+                    || contains(proxyMeshB, transformationB, proxyMeshA, transformationA);
+            if(!proxiesOverlap){
+                if(statistics){
+                    statistics->rejections++;
+                }
+                return false;
             }
         }
-        return false;
+
+        if(statistics){
+            statistics->fullTests++;
+        }
+        return intersect(worldSpaceMeshA, worldSpaceMeshB);
+    }
+
+    /**
+     * @brief Tests whether two oriented meshes with the same scale intersect.
+     *
+     * The rotations are baked into the oriented meshes, so they only differ by a translation and no triangles have
+     * to be transformed, whatever their rotations. Uses the trees of the oriented meshes if they were built.
+     */
+    bool intersect(const OrientedMesh& orientedMeshA, const glm::vec3& positionA, const OrientedMesh& orientedMeshB, const glm::vec3& positionB, float scale){
+        const auto triangleCountA = orientedMeshA.mesh->getTriangles().size();
+        const auto triangleCountB = orientedMeshB.mesh->getTriangles().size();
+        const auto& simplerObject = triangleCountA < triangleCountB ? orientedMeshA : orientedMeshB;
+        const auto& complexObject = triangleCountA < triangleCountB ? orientedMeshB : orientedMeshA;
+        const auto& simplerPosition = triangleCountA < triangleCountB ? positionA : positionB;
+        const auto& complexPosition = triangleCountA < triangleCountB ? positionB : positionA;
+
+        const auto& simplerObjectTree = simplerObject.tree ? simplerObject.tree : CachingBoundsTreeFactory<BoundingVolumeHierarchy>::getBoundsTree(simplerObject.mesh);
+        const auto& complexObjectTree = complexObject.tree ? complexObject.tree : CachingBoundsTreeFactory<BoundingVolumeHierarchy>::getBoundsTree(complexObject.mesh);
+        return complexObjectTree->intersectsTranslated(*simplerObjectTree, (simplerPosition - complexPosition) / scale);
+    }
+
+    /**
+     * @brief Tests whether the convex decompositions of two meshes intersect.
+     *
+     * The pieces of a decomposition enclose the mesh, so this can report intersections between meshes that are less
+     * than the decomposition's concavity tolerance apart, but never misses an intersection of the meshes themselves.
+     */
+    bool intersectConvexDecompositions(const WorldSpaceMesh& worldSpaceMeshA, const WorldSpaceMesh& worldSpaceMeshB){
+        const auto& decompositionA = worldSpaceMeshA.getModelSpaceMesh()->getConvexDecomposition();
+        const auto& decompositionB = worldSpaceMeshB.getModelSpaceMesh()->getConvexDecomposition();
+        return decompositionA->intersects(worldSpaceMeshA.getModelTransformation(), *decompositionB, worldSpaceMeshB.getModelTransformation());
     }
 
     bool debugIntersects(const WorldSpaceMesh& worldSpaceMeshA, const WorldSpaceMesh& worldSpaceMeshB){
@@ -229,4 +308,13 @@ namespace Distance{
 
         return glm::sqrt(closestTriangleQueryResult.lowerDistanceBoundSquared)*complexTransformation.getScale();
     }
-}
\ No newline at end of file
+
+    /**
+     * @brief Distance between the convex decompositions of two meshes, a lower bound of the distance between the meshes.
+     */
+    float distanceConvexDecompositions(const WorldSpaceMesh& worldSpaceMeshA, const WorldSpaceMesh& worldSpaceMeshB){
+        const auto& decompositionA = worldSpaceMeshA.getModelSpaceMesh()->getConvexDecomposition();
+        const auto& decompositionB = worldSpaceMeshB.getModelSpaceMesh()->getConvexDecomposition();
+        return decompositionA->computeDistance(worldSpaceMeshA.getModelTransformation(), *decompositionB, worldSpaceMeshB.getModelTransformation());
+    }
+}
@@ -18,6 +18,11 @@ namespace Intersection {
     }
 
     float intersectionDistance(const Ray& ray, const VertexTriangle& triangle) {
+        glm::vec2 barycentricCoordinates;
+        return intersectionDistance(ray, triangle, barycentricCoordinates);
+    }
+
+    float intersectionDistance(const Ray& ray, const VertexTriangle& triangle, glm::vec2& barycentricCoordinates) {
 
         //Möller–Trumbore
         glm::vec3 h = glm::cross(ray.direction, -triangle.edges[2]);
@@ -39,6 +44,7 @@ namespace Intersection {
         }
         // At this stage we can compute t to find out where the intersection point is on the line.
         float t = f * glm::dot(-triangle.edges[2], q);
+        barycentricCoordinates = glm::vec2(u, v);
         return t;
     }
 
@@ -15,11 +15,12 @@
  *
  */
 
+#include <cmath>
 #include <glm/glm.hpp>
 
 #include "meshcore/geometric/Intersection.h"
 
-#define FABS(x) (abs(x))        /* implement as is fastest on your machine */
+#define FABS(x) (std::abs(x))   /* implement as is fastest on your machine, unqualified abs can resolve to the integer overload */
 
 /* if USE_EPSILON_TEST is true then we do a check:
          if |dv|<EPSILON then dv=0.0;
@@ -0,0 +1,350 @@
+#include "meshcore/optimization/BottomLeftFill.h"
+#include "meshcore/geometric/Intersection.h"
+#include "meshcore/acceleration/Heightmap.h"
+
+#include <atomic>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <tbb/parallel_reduce.h>
+#include <tbb/blocked_range.h>
+
+namespace {
+
+    /** Uniform grid in the xy-plane, listing the placed items whose AABB covers each cell **/
+    class ColumnGrid {
+        glm::vec2 origin;
+        float cellSize;
+        int numberOfColumns;
+        int numberOfRows;
+        std::vector<std::vector<size_t>> cells;
+
+        [[nodiscard]] int computeColumn(float x) const {
+            return std::clamp(static_cast<int>((x - origin.x) / cellSize), 0, numberOfColumns - 1);
+        }
+
+        [[nodiscard]] int computeRow(float y) const {
+            return std::clamp(static_cast<int>((y - origin.y) / cellSize), 0, numberOfRows - 1);
+        }
+
+    public:
+        ColumnGrid(const AABB& container, float preferredCellSize) {
+            constexpr int maximumCells = 256;
+            const auto extent = container.getMaximum() - container.getMinimum();
+            origin = glm::vec2(container.getMinimum().x, container.getMinimum().y);
+            cellSize = std::max({preferredCellSize, extent.x / maximumCells, extent.y / maximumCells, 1e-6f});
+            numberOfColumns = std::max(1, static_cast<int>(std::ceil(extent.x / cellSize)));
+            numberOfRows = std::max(1, static_cast<int>(std::ceil(extent.y / cellSize)));
+            cells.resize(numberOfColumns * numberOfRows);
+        }
+
+        void insert(size_t itemIndex, const AABB& aabb) {
+            for (int row = computeRow(aabb.getMinimum().y); row <= computeRow(aabb.getMaximum().y); ++row){
+                for (int column = computeColumn(aabb.getMinimum().x); column <= computeColumn(aabb.getMaximum().x); ++column){
+                    cells[row * numberOfColumns + column].push_back(itemIndex);
+                }
+            }
+        }
+
+        void query(const glm::vec2& minimum, const glm::vec2& maximum, std::vector<size_t>& result) const {
+            result.clear();
+            for (int row = computeRow(minimum.y); row <= computeRow(maximum.y); ++row){
+                for (int column = computeColumn(minimum.x); column <= computeColumn(maximum.x); ++column){
+                    const auto& cell = cells[row * numberOfColumns + column];
+                    result.insert(result.end(), cell.begin(), cell.end());
+                }
+            }
+            std::sort(result.begin(), result.end());
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+        }
+    };
+
+    struct Candidate {
+        float z = std::numeric_limits<float>::infinity();
+        float y = 0.0f;
+        float x = 0.0f;
+        float top = 0.0f;
+        size_t index = std::numeric_limits<size_t>::max();
+
+        [[nodiscard]] bool isBetterThan(const Candidate& other) const {
+            return std::tie(z, y, x, top, index) < std::tie(other.z, other.y, other.x, other.top, other.index);
+        }
+    };
+
+    void updateMinimum(std::atomic<float>& minimum, float value) {
+        auto current = minimum.load();
+        while(value < current && !minimum.compare_exchange_weak(current, value)){}
+    }
+}
+
+BottomLeftFill::BottomLeftFill(BottomLeftFillParameters parameters): parameters(std::move(parameters)) {
+    if(this->parameters.orientations.empty()){
+        throw std::invalid_argument("At least one orientation is required");
+    }
+}
+
+std::shared_ptr<StripPackingSolution> BottomLeftFill::construct(const std::shared_ptr<StripPackingProblem> &problem) const {
+    auto solution = std::make_shared<StripPackingSolution>(problem);
+    construct(*solution);
+    return solution;
+}
+
+void BottomLeftFill::construct(StripPackingSolution &solution) const {
+    const auto& problem = solution.getProblem();
+    const auto& container = problem->getContainer();
+    const auto& requiredItems = problem->getRequiredItems();
+    const auto& orientations = parameters.orientations;
+
+    const auto heightmapCellSize = parameters.heightmapCellSize > 0.0f ? parameters.heightmapCellSize : Heightmap::computeDefaultCellSize(container, requiredItems);
+    Heightmap surface(container, heightmapCellSize);
+
+    // Bounds of each item type in each orientation, relative to the item's origin
+    std::vector<std::vector<AABB>> orientedBounds(requiredItems.size());
+    std::vector<std::vector<std::shared_ptr<const DepthMap>>> depthMaps(requiredItems.size());
+    std::vector<std::vector<size_t>> distinctOrientations(requiredItems.size()); // Orientations that rotate the item onto itself are only tried once
+    std::vector<WorldSpaceMesh> prototypes;
+    float cellSize = 0.0f;
+    for (size_t typeIndex = 0; typeIndex < requiredItems.size(); ++typeIndex){
+        const auto& hullVertices = requiredItems[typeIndex]->getConvexHull()->getVertices();
+        const auto& bounds = requiredItems[typeIndex]->getBounds();
+        const auto resolution = 1e-4f * std::max(1e-6f, glm::length(bounds.getMaximum() - bounds.getMinimum()));
+        std::set<std::vector<std::array<long, 3>>> knownShapes;
+        for (size_t orientationIndex = 0; orientationIndex < orientations.size(); ++orientationIndex){
+            std::vector<Vertex> rotatedVertices;
+            Vertex minimum(std::numeric_limits<float>::max());
+            Vertex maximum(-std::numeric_limits<float>::max());
+            for (const auto& vertex: hullVertices){
+                rotatedVertices.push_back(orientations[orientationIndex].rotateVertex(vertex));
+                minimum = glm::min(minimum, rotatedVertices.back());
+                maximum = glm::max(maximum, rotatedVertices.back());
+            }
+            orientedBounds[typeIndex].emplace_back(minimum, maximum);
+            cellSize = std::max({cellSize, maximum.x - minimum.x, maximum.y - minimum.y});
+
+            std::vector<std::array<long, 3>> shape;
+            for (const auto& vertex: rotatedVertices){
+                const auto relative = glm::round((vertex - minimum) / resolution);
+                shape.push_back({long(relative.x), long(relative.y), long(relative.z)});
+            }
+            std::sort(shape.begin(), shape.end());
+            if(knownShapes.insert(shape).second){
+                distinctOrientations[typeIndex].push_back(orientationIndex);
+                depthMaps[typeIndex].push_back(surface.getDepthMap(requiredItems[typeIndex], orientations[orientationIndex]));
+            }
+            else {
+                depthMaps[typeIndex].emplace_back();
+            }
+        }
+        prototypes.emplace_back(requiredItems[typeIndex]);
+    }
+
+    // Items placed in orientations of the set only differ by a translation, which the cached oriented meshes exploit
+    if(parameters.useOrientationCache && !solution.getOrientationCache()){
+        OrientationCacheParameters cacheParameters;
+        cacheParameters.lazyBuild = false;
+        solution.setOrientationCache(std::make_shared<OrientationCache>(cacheParameters));
+    }
+    const auto& orientationCache = solution.getOrientationCache();
+    std::vector<std::vector<std::shared_ptr<const OrientedMesh>>> orientedMeshes(requiredItems.size(), std::vector<std::shared_ptr<const OrientedMesh>>(orientations.size()));
+    std::vector<std::shared_ptr<const OrientedMesh>> placedOrientedMeshes(solution.getNumberOfItems());
+    if(orientationCache){
+        for (size_t typeIndex = 0; typeIndex < requiredItems.size(); ++typeIndex){
+            std::vector<Quaternion> typeOrientations;
+            for (const auto orientationIndex: distinctOrientations[typeIndex]){
+                typeOrientations.push_back(orientations[orientationIndex]);
+            }
+            orientationCache->prepare({requiredItems[typeIndex]}, typeOrientations);
+            for (const auto orientationIndex: distinctOrientations[typeIndex]){
+                orientedMeshes[typeIndex][orientationIndex] = orientationCache->get(requiredItems[typeIndex], orientations[orientationIndex]);
+            }
+        }
+    }
+
+    ColumnGrid grid(container, cellSize);
+    std::vector<glm::vec2> candidatePoints = {glm::vec2(container.getMinimum().x, container.getMinimum().y)};
+    std::set<std::pair<float, float>> knownPoints = {{container.getMinimum().x, container.getMinimum().y}};
+    const auto addCandidatePoint = [&](float x, float y){
+        if(x < container.getMaximum().x && y < container.getMaximum().y && knownPoints.emplace(x, y).second){
+            candidatePoints.emplace_back(x, y);
+        }
+    };
+
+    for (const auto itemIndex: computeItemOrder(solution)){
+        const auto typeIndex = solution.getItemType(itemIndex);
+        const auto& itemOrientations = distinctOrientations[typeIndex];
+        std::atomic<float> bestZ(std::numeric_limits<float>::infinity());
+
+        const auto best = tbb::parallel_reduce(tbb::blocked_range<size_t>(0, candidatePoints.size() * itemOrientations.size()), Candidate(),
+            [&](const tbb::blocked_range<size_t>& range, Candidate candidate){
+                std::vector<size_t> neighbours;
+                std::vector<float> levels;
+                auto mesh = prototypes[typeIndex];
+
+                for (size_t candidateIndex = range.begin(); candidateIndex < range.end(); ++candidateIndex){
+                    const auto& point = candidatePoints[candidateIndex / itemOrientations.size()];
+                    const auto orientationIndex = itemOrientations[candidateIndex % itemOrientations.size()];
+                    const auto& bounds = orientedBounds[typeIndex][orientationIndex];
+                    const auto extent = bounds.getMaximum() - bounds.getMinimum();
+                    if(point.x + extent.x > container.getMaximum().x || point.y + extent.y > container.getMaximum().y){
+                        continue;
+                    }
+
+                    // Placed items overlapping or touching the candidate's footprint, the item can rest on the top of each of their AABBs
+                    grid.query(point, point + glm::vec2(extent.x, extent.y), neighbours);
+                    levels.assign(1, container.getMinimum().z);
+                    neighbours.erase(std::remove_if(neighbours.begin(), neighbours.end(), [&](size_t neighbour){
+                        const auto& aabb = solution.getItemAABB(neighbour);
+                        return aabb.getMaximum().x < point.x || aabb.getMinimum().x > point.x + extent.x ||
+                               aabb.getMaximum().y < point.y || aabb.getMinimum().y > point.y + extent.y;
+                    }), neighbours.end());
+                    for (const auto neighbour: neighbours){
+                        levels.push_back(solution.getItemAABB(neighbour).getMaximum().z + parameters.clearance);
+                    }
+                    std::sort(levels.begin(), levels.end());
+                    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+
+                    // Above the heightmap's surface the item certainly fits, only the levels below it need exact tests
+                    const auto surfaceLevel = surface.computeLowestPlacement(*depthMaps[typeIndex][orientationIndex], point.x, point.y) + parameters.clearance;
+                    levels.erase(std::lower_bound(levels.begin(), levels.end(), surfaceLevel), levels.end());
+                    levels.push_back(surfaceLevel);
+
+                    Transformation transformation;
+                    transformation.setRotation(orientations[orientationIndex]);
+                    const auto& orientedMesh = orientedMeshes[typeIndex][orientationIndex];
+                    const auto collides = [&](float z){
+                        const auto position = Vertex(point.x, point.y, z) - bounds.getMinimum();
+                        transformation.setPosition(position);
+                        mesh.setModelTransformation(transformation);
+                        for (const auto neighbour: neighbours){
+                            const auto& aabb = solution.getItemAABB(neighbour);
+                            if(aabb.getMaximum().z < z || aabb.getMinimum().z > z + extent.z){
+                                continue;
+                            }
+
+                            // Same argument order as StripPackingSolution::isFeasible, so touching meshes get the same verdict
+                            const auto& placedOrientedMesh = placedOrientedMeshes[neighbour];
+                            if(orientedMesh && placedOrientedMesh){
+                                const auto neighbourPosition = solution.getItemTransformation(neighbour).getPosition();
+                                if(itemIndex < neighbour ? Intersection::intersect(*orientedMesh, position, *placedOrientedMesh, neighbourPosition) :
+                                                           Intersection::intersect(*placedOrientedMesh, neighbourPosition, *orientedMesh, position)){
+                                    return true;
+                                }
+                                continue;
+                            }
+                            const auto& other = *solution.getItem(neighbour);
+                            if(itemIndex < neighbour ? Intersection::intersect(mesh, other) : Intersection::intersect(other, mesh)){
+                                return true;
+                            }
+                        }
+                        return false;
+                    };
+
+                    // Lowest level without collisions, candidates that can only end up above the best one found so far are abandoned
+                    std::optional<float> lowerLevel;
+                    std::optional<float> feasibleLevel;
+                    for (const auto level: levels){
+                        if(lowerLevel.value_or(-std::numeric_limits<float>::infinity()) >= bestZ.load() || level > bestZ.load() ||
+                           level + extent.z > container.getMaximum().z){
+                            break;
+                        }
+                        if(level == surfaceLevel || !collides(level)){
+                            feasibleLevel = level;
+                            break;
+                        }
+                        lowerLevel = level;
+                    }
+                    if(!feasibleLevel){
+                        continue;
+                    }
+
+                    // The item can often be lowered in between the AABBs it rests on
+                    auto z = *feasibleLevel;
+                    if(lowerLevel){
+                        auto lowerBound = *lowerLevel;
+                        for (unsigned int iteration = 0; iteration < parameters.dropIterations && lowerBound < bestZ.load(); ++iteration){
+                            const auto middle = 0.5f * (lowerBound + z);
+                            (collides(middle) ? lowerBound : z) = middle;
+                        }
+                        if(lowerBound >= bestZ.load()){
+                            continue;
+                        }
+                    }
+
+                    const Candidate pointCandidate{z, point.y, point.x, z + extent.z, candidateIndex};
+                    if(pointCandidate.isBetterThan(candidate)){
+                        candidate = pointCandidate;
+                        updateMinimum(bestZ, z);
+                    }
+                }
+                return candidate;
+            },
+            [](const Candidate& first, const Candidate& second){
+                return first.isBetterThan(second) ? first : second;
+            });
+
+        if(best.index == std::numeric_limits<size_t>::max()){
+            throw std::runtime_error("Item " + solution.getItemName(itemIndex) + " does not fit in the container");
+        }
+
+        const auto orientationIndex = itemOrientations[best.index % itemOrientations.size()];
+        Transformation transformation;
+        transformation.setRotation(orientations[orientationIndex]);
+        transformation.setPosition(Vertex(best.x, best.y, best.z) - orientedBounds[typeIndex][orientationIndex].getMinimum());
+        solution.setItemTransformation(itemIndex, transformation);
+
+        // The cached AABB and view of the placed item are created here, the parallel candidate evaluation only reads them
+        const auto& aabb = solution.getItemAABB(itemIndex);
+        static_cast<void>(solution.getItem(itemIndex));
+        placedOrientedMeshes[itemIndex] = orientedMeshes[typeIndex][orientationIndex];
+        grid.insert(itemIndex, aabb);
+        surface.setItem(itemIndex, depthMaps[typeIndex][orientationIndex], Vertex(best.x, best.y, best.z));
+        addCandidatePoint(aabb.getMaximum().x + parameters.clearance, aabb.getMinimum().y);
+        addCandidatePoint(aabb.getMinimum().x, aabb.getMaximum().y + parameters.clearance);
+        addCandidatePoint(aabb.getMaximum().x + parameters.clearance, container.getMinimum().y);
+        addCandidatePoint(container.getMinimum().x, aabb.getMaximum().y + parameters.clearance);
+    }
+}
+
+std::vector<size_t> BottomLeftFill::computeItemOrder(const StripPackingSolution &solution) const {
+    const auto& requiredItems = solution.getProblem()->getRequiredItems();
+    std::vector<float> keys(requiredItems.size(), 0.0f);
+    for (size_t typeIndex = 0; typeIndex < requiredItems.size(); ++typeIndex){
+        const auto& bounds = requiredItems[typeIndex]->getBounds();
+        const auto extent = bounds.getMaximum() - bounds.getMinimum();
+        switch(parameters.itemOrder){
+            case ItemOrder::AsGiven: break;
+            case ItemOrder::DecreasingVolume: keys[typeIndex] = requiredItems[typeIndex]->getVolume(); break;
+            case ItemOrder::DecreasingHeight: keys[typeIndex] = extent.z; break;
+            case ItemOrder::DecreasingBaseArea: keys[typeIndex] = extent.x * extent.y; break;
+        }
+    }
+
+    std::vector<size_t> order(solution.getNumberOfItems());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t first, size_t second){
+        return keys[solution.getItemType(first)] > keys[solution.getItemType(second)];
+    });
+    return order;
+}
+
+std::vector<Quaternion> BottomLeftFill::getAxisAlignedOrientations() {
+    std::vector<Quaternion> result;
+    std::set<std::array<int, 6>> knownAxes;
+    const auto quarterTurn = 0.5f * glm::pi<float>();
+    for (int yaw = 0; yaw < 4; ++yaw){
+        for (int pitch = 0; pitch < 4; ++pitch){
+            for (int roll = 0; roll < 4; ++roll){
+                const Quaternion rotation(yaw * quarterTurn, pitch * quarterTurn, roll * quarterTurn);
+
+                // A rotation is identified by the images of the x- and y-axis
+                const auto xAxis = glm::round(rotation.rotateVertex(glm::vec3(1.0f, 0.0f, 0.0f)));
+                const auto yAxis = glm::round(rotation.rotateVertex(glm::vec3(0.0f, 1.0f, 0.0f)));
+                const std::array<int, 6> axes = {int(xAxis.x), int(xAxis.y), int(xAxis.z), int(yAxis.x), int(yAxis.y), int(yAxis.z)};
+                if(knownAxes.insert(axes).second){
+                    result.push_back(rotation);
+                }
+            }
+        }
+    }
+    return result;
+}
@@ -7,6 +7,7 @@
 #include "meshcore/acceleration/BoundingVolumeHierarchy.h"
 #include "meshcore/acceleration/CachingBoundsTreeFactory.h"
 #include "meshcore/core/Ray.h"
+#include <typeinfo>
 
 SingleVolumeMaximisationSolution::SingleVolumeMaximisationSolution(
     const std::shared_ptr<WorldSpaceMesh> &itemWorldSpaceMesh,
@@ -21,8 +22,55 @@ const std::shared_ptr<WorldSpaceMesh> & SingleVolumeMaximisationSolution::getCon
     return containerWorldSpaceMesh;
 }
 
+const std::shared_ptr<const SignedDistanceField> & SingleVolumeMaximisationSolution::getContainerDistanceField() const {
+    return containerDistanceField;
+}
+
+void SingleVolumeMaximisationSolution::setContainerDistanceField(const std::shared_ptr<const SignedDistanceField> &distanceField) {
+    containerDistanceField = distanceField;
+}
+
+std::optional<bool> SingleVolumeMaximisationSolution::isContainedByDistanceField() const {
+    const auto& itemMesh = itemWorldSpaceMesh->getModelSpaceMesh();
+    const auto itemToContainerTransformation = containerWorldSpaceMesh->getModelTransformation().getInverse() * itemWorldSpaceMesh->getModelTransformation();
+
+    // Any vertex outside of the container means the surfaces cross or the item lies outside
+    std::vector<Vertex> vertices;
+    std::vector<float> upperBounds;
+    vertices.reserve(itemMesh->getVertices().size());
+    upperBounds.reserve(itemMesh->getVertices().size());
+    for (const auto& vertex: itemMesh->getVertices()){
+        vertices.emplace_back(itemToContainerTransformation.transformVertex(vertex));
+        const auto [lower, upper] = containerDistanceField->getSignedDistanceBounds(vertices.back());
+        if(lower > 0.0f){
+            return false;
+        }
+        upperBounds.emplace_back(upper);
+    }
+
+    // Each point of a triangle lies within its longest edge from any of its vertices, so deep enough vertices keep the whole triangle inside
+    for (const auto& triangle: itemMesh->getTriangles()){
+        const auto& v0 = vertices[triangle.vertexIndex0];
+        const auto& v1 = vertices[triangle.vertexIndex1];
+        const auto& v2 = vertices[triangle.vertexIndex2];
+        const auto longestEdge = std::max(glm::length(v1 - v0), std::max(glm::length(v2 - v1), glm::length(v0 - v2)));
+        const auto deepest = std::min(upperBounds[triangle.vertexIndex0], std::min(upperBounds[triangle.vertexIndex1], upperBounds[triangle.vertexIndex2]));
+        if(deepest + longestEdge >= 0.0f){
+            return std::nullopt;
+        }
+    }
+    return true;
+}
+
 bool SingleVolumeMaximisationSolution::isFeasible() const {
 
+    if(containerDistanceField){
+        const auto contained = isContainedByDistanceField();
+        if(contained.has_value()){
+            return contained.value();
+        }
+    }
+
     // Containment: At least one vertex of the item should be inside the outer mesh, point inclusion check using ray`
     const Transformation& itemTransformation =  itemWorldSpaceMesh->getModelTransformation();
     const Transformation& outerTransformation =  containerWorldSpaceMesh->getModelTransformation();
@@ -39,5 +87,22 @@ bool SingleVolumeMaximisationSolution::isFeasible() const {
 }
 
 std::shared_ptr<AbstractSolution> SingleVolumeMaximisationSolution::clone() const {
-    return std::make_shared<SingleVolumeMaximisationSolution>(itemWorldSpaceMesh->clone(), containerWorldSpaceMesh->clone());
+    auto result = std::make_shared<SingleVolumeMaximisationSolution>(itemWorldSpaceMesh->clone(), containerWorldSpaceMesh->clone());
+    result->containerDistanceField = containerDistanceField;
+    return result;
+}
+
+bool SingleVolumeMaximisationSolution::copyStateFrom(const AbstractSolution &other) {
+    if(typeid(*this) != typeid(SingleVolumeMaximisationSolution) || typeid(other) != typeid(SingleVolumeMaximisationSolution)){
+        return false;
+    }
+    const auto& otherSolution = static_cast<const SingleVolumeMaximisationSolution&>(other);
+    if(otherSolution.itemWorldSpaceMesh->getModelSpaceMesh() != itemWorldSpaceMesh->getModelSpaceMesh() ||
+       otherSolution.containerWorldSpaceMesh->getModelSpaceMesh() != containerWorldSpaceMesh->getModelSpaceMesh()){
+        return false;
+    }
+    itemWorldSpaceMesh->setModelTransformation(otherSolution.itemWorldSpaceMesh->getModelTransformation());
+    containerWorldSpaceMesh->setModelTransformation(otherSolution.containerWorldSpaceMesh->getModelTransformation());
+    containerDistanceField = otherSolution.containerDistanceField;
+    return true;
 }
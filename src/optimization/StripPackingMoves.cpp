@@ -0,0 +1,77 @@
+#include "meshcore/optimization/StripPackingMoves.h"
+
+StripPackingItemTransformationMove::StripPackingItemTransformationMove(size_t itemIndex, const Transformation &newTransformation):
+    itemIndex(itemIndex), newTransformation(newTransformation) {}
+
+void StripPackingItemTransformationMove::doMove(std::shared_ptr<StripPackingSolution> solution) {
+    oldTransformation = solution->getItemTransformation(itemIndex);
+    solution->setItemTransformation(itemIndex, newTransformation);
+}
+
+void StripPackingItemTransformationMove::undoMove(std::shared_ptr<StripPackingSolution> solution) {
+    solution->setItemTransformation(itemIndex, oldTransformation);
+}
+
+bool StripPackingItemTransformationMove::appendAffectedItems(std::vector<size_t> &affectedItems) const {
+    affectedItems.push_back(itemIndex);
+    return true;
+}
+
+void StripPackingItemTransformationMove::assign(size_t newItemIndex, const Transformation &transformation) {
+    itemIndex = newItemIndex;
+    newTransformation = transformation;
+}
+
+size_t StripPackingItemTransformationMove::getItemIndex() const {
+    return itemIndex;
+}
+
+const Transformation &StripPackingItemTransformationMove::getNewTransformation() const {
+    return newTransformation;
+}
+
+const Transformation &StripPackingItemTransformationMove::getOldTransformation() const {
+    return oldTransformation;
+}
+
+std::shared_ptr<Move<StripPackingSolution>> StripPackingTranslationMoveFactory::sample(const std::shared_ptr<const StripPackingSolution> &solution, const Random &random, float stepSize) const {
+    std::shared_ptr<Move<StripPackingSolution>> move;
+    sampleInto(move, solution, random, stepSize);
+    return move;
+}
+
+void StripPackingTranslationMoveFactory::sampleInto(std::shared_ptr<Move<StripPackingSolution>> &move, const std::shared_ptr<const StripPackingSolution> &solution, const Random &random, float stepSize) const {
+    const auto itemIndex = static_cast<size_t>(random.nextInteger(0, static_cast<int>(solution->getProblem()->getTotalNumberOfItems()) - 1));
+    auto transformation = solution->getItemTransformation(itemIndex);
+    transformation.setPosition(transformation.getPosition() + glm::vec3(random.nextFloat(-stepSize, stepSize),
+                                                                        random.nextFloat(-stepSize, stepSize),
+                                                                        random.nextFloat(-stepSize, stepSize)));
+
+    // Only overwrite moves nobody else holds on to
+    const auto itemMove = move.use_count() == 1 ? dynamic_cast<StripPackingItemTransformationMove*>(move.get()) : nullptr;
+    if(itemMove){
+        itemMove->assign(itemIndex, transformation);
+    }
+    else {
+        move = std::make_shared<StripPackingItemTransformationMove>(itemIndex, transformation);
+    }
+}
+
+std::vector<std::shared_ptr<Move<StripPackingSolution>>> StripPackingTranslationMoveFactory::listMoves(const std::shared_ptr<const StripPackingSolution> &solution, float stepSize) const {
+    std::vector<std::shared_ptr<Move<StripPackingSolution>>> moves;
+    const auto numberOfItems = solution->getProblem()->getTotalNumberOfItems();
+    moves.reserve(6 * numberOfItems);
+    for (size_t itemIndex = 0; itemIndex < numberOfItems; ++itemIndex){
+        const auto transformation = solution->getItemTransformation(itemIndex);
+        for (int axis = 0; axis < 3; ++axis){
+            for (const float sign: {1.0f, -1.0f}){
+                glm::vec3 offset(0.0f);
+                offset[axis] = sign * stepSize;
+                auto newTransformation = transformation;
+                newTransformation.setPosition(transformation.getPosition() + offset);
+                moves.emplace_back(std::make_shared<StripPackingItemTransformationMove>(itemIndex, newTransformation));
+            }
+        }
+    }
+    return moves;
+}
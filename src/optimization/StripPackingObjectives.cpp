@@ -0,0 +1,143 @@
+#include "meshcore/optimization/StripPackingObjectives.h"
+#include "meshcore/optimization/StripPackingMoves.h"
+#include "meshcore/geometric/GJK.h"
+#include "meshcore/geometric/Intersection.h"
+#include <tbb/parallel_reduce.h>
+#include <tbb/blocked_range.h>
+
+float StripPackingHeightObjective::evaluate(std::shared_ptr<const StripPackingSolution> solution) const {
+    return solution->computeTotalHeight();
+}
+
+bool StripPackingHeightObjective::supportsDeltaEvaluation() const {
+    return true;
+}
+
+float StripPackingHeightObjective::evaluateDelta(const StripPackingSolution &solution, const Move<StripPackingSolution> &move, float previousScore) const {
+    thread_local std::vector<size_t> affectedItems; // Reused between evaluations on the same thread
+    affectedItems.clear();
+    if(!move.appendAffectedItems(affectedItems) || affectedItems.empty()){
+        return solution.computeTotalHeight() - previousScore;
+    }
+
+    // Items that end up on top define the new height by themselves, the unaffected items didn't exceed the previous height
+    float highestAffectedItem = 0.0f;
+    for (const auto itemIndex: affectedItems){
+        highestAffectedItem = std::max(highestAffectedItem, solution.getItemAABB(itemIndex).getMaximum().z);
+    }
+    if(highestAffectedItem >= previousScore){
+        return highestAffectedItem - previousScore;
+    }
+
+    // The packing may have become lower, which the solution's running maximum only knows after rescanning the items
+    return solution.computeTotalHeight() - previousScore;
+}
+
+namespace {
+
+    constexpr size_t PENALTY_GRAIN_SIZE = 8; // Items per task of the penalty reductions
+
+    /** AABB of a convex shape through support queries along the axes **/
+    AABB computeSupportAABB(const GJKConvexShape& shape) {
+        Vertex minimum, maximum;
+        for (int axis = 0; axis < 3; ++axis){
+            glm::vec3 direction(0.0f);
+            direction[axis] = 1.0f;
+            maximum[axis] = shape.computeSupport(direction)[axis];
+            minimum[axis] = shape.computeSupport(-direction)[axis];
+        }
+        return {minimum, maximum};
+    }
+
+    float computeProtrusion(const AABB& container, const AABB& itemAABB) {
+        const auto below = glm::max(container.getMinimum() - itemAABB.getMinimum(), 0.0f);
+        const auto above = glm::max(itemAABB.getMaximum() - container.getMaximum(), 0.0f);
+        return below.x + below.y + below.z + above.x + above.y + above.z;
+    }
+
+    // Pairs are always evaluated with the lowest index first, so full and delta evaluations give identical values
+    float computePairPenetration(const StripPackingSolution& solution, size_t firstIndex, const Transformation& firstTransformation, const AABB& firstAABB,
+                                 size_t secondIndex, const Transformation& secondTransformation, const AABB& secondAABB) {
+        if(!Intersection::intersect(firstAABB, secondAABB)){
+            return 0.0f;
+        }
+        const GJKTransformedMesh firstHull(*solution.getItemModelSpaceMesh(firstIndex)->getConvexHull(), firstTransformation);
+        const GJKTransformedMesh secondHull(*solution.getItemModelSpaceMesh(secondIndex)->getConvexHull(), secondTransformation);
+        return firstIndex < secondIndex ? GJK::computePenetrationDepth(firstHull, secondHull) : GJK::computePenetrationDepth(secondHull, firstHull);
+    }
+}
+
+StripPackingOverlapObjective::StripPackingOverlapObjective(float overlapWeight): overlapWeight(overlapWeight) {}
+
+float StripPackingOverlapObjective::evaluate(std::shared_ptr<const StripPackingSolution> solution) const {
+    return solution->computeTotalHeight() + overlapWeight * computePenalty(*solution);
+}
+
+float StripPackingOverlapObjective::computePenalty(const StripPackingSolution &solution) const {
+    const auto numberOfItems = solution.getNumberOfItems();
+
+    // Cached AABBs are filled in sequentially, the parallel part below only reads them
+    solution.prepareCaches();
+
+    // The deterministic reduction splits and joins the same way on every run, so the rounding of the sum is reproducible
+    return tbb::parallel_deterministic_reduce(tbb::blocked_range<size_t>(0, numberOfItems, PENALTY_GRAIN_SIZE), 0.0f, [&](const tbb::blocked_range<size_t>& range, float penalty){
+        for (size_t firstIndex = range.begin(); firstIndex < range.end(); ++firstIndex){
+            const auto firstTransformation = solution.getItemTransformation(firstIndex);
+            const auto& firstAABB = solution.getItemAABB(firstIndex);
+            penalty += computeProtrusion(solution.getProblem()->getContainer(), firstAABB);
+            for (size_t secondIndex = firstIndex + 1; secondIndex < numberOfItems; ++secondIndex){
+                const auto& secondAABB = solution.getItemAABB(secondIndex);
+                if(Intersection::intersect(firstAABB, secondAABB)){
+                    penalty += computePairPenetration(solution, firstIndex, firstTransformation, firstAABB, secondIndex, solution.getItemTransformation(secondIndex), secondAABB);
+                }
+            }
+        }
+        return penalty;
+    }, std::plus<>());
+}
+
+/**
+ * @brief Penalty terms involving the given item, when placed with the given transformation.
+ */
+float StripPackingOverlapObjective::computeItemPenalty(const StripPackingSolution &solution, size_t itemIndex, const Transformation &transformation) {
+    const auto itemAABB = computeSupportAABB(GJKTransformedMesh(*solution.getItemModelSpaceMesh(itemIndex)->getConvexHull(), transformation));
+    const auto numberOfItems = solution.getNumberOfItems();
+    solution.prepareCaches();
+
+    const auto overlap = tbb::parallel_deterministic_reduce(tbb::blocked_range<size_t>(0, numberOfItems, PENALTY_GRAIN_SIZE), 0.0f, [&](const tbb::blocked_range<size_t>& range, float penalty){
+        for (size_t otherIndex = range.begin(); otherIndex < range.end(); ++otherIndex){
+            const auto& otherAABB = solution.getItemAABB(otherIndex);
+            if(otherIndex != itemIndex && Intersection::intersect(itemAABB, otherAABB)){
+                penalty += computePairPenetration(solution, itemIndex, transformation, itemAABB, otherIndex, solution.getItemTransformation(otherIndex), otherAABB);
+            }
+        }
+        return penalty;
+    }, std::plus<>());
+    return overlap + computeProtrusion(solution.getProblem()->getContainer(), itemAABB);
+}
+
+bool StripPackingOverlapObjective::supportsDeltaEvaluation() const {
+    return true;
+}
+
+float StripPackingOverlapObjective::evaluateDelta(const StripPackingSolution &solution, const Move<StripPackingSolution> &move, float previousScore) const {
+    const auto itemMove = dynamic_cast<const StripPackingItemTransformationMove*>(&move);
+    if(!itemMove){
+        return solution.computeTotalHeight() + overlapWeight * computePenalty(solution) - previousScore;
+    }
+
+    // Height before the move, from the other items' cached AABBs and the item's previous hull
+    const auto itemIndex = itemMove->getItemIndex();
+    const auto& oldTransformation = itemMove->getOldTransformation();
+    float oldHeight = computeSupportAABB(GJKTransformedMesh(*solution.getItemModelSpaceMesh(itemIndex)->getConvexHull(), oldTransformation)).getMaximum().z;
+    for (size_t otherIndex = 0; otherIndex < solution.getNumberOfItems(); ++otherIndex){
+        if(otherIndex != itemIndex){
+            oldHeight = std::max(oldHeight, solution.getItemAABB(otherIndex).getMaximum().z);
+        }
+    }
+    oldHeight = std::max(oldHeight, 0.0f);
+
+    const auto newPenalty = computeItemPenalty(solution, itemIndex, solution.getItemTransformation(itemIndex));
+    const auto oldPenalty = computeItemPenalty(solution, itemIndex, oldTransformation);
+    return solution.computeTotalHeight() - oldHeight + overlapWeight * (newPenalty - oldPenalty);
+}
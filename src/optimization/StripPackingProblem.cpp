@@ -6,9 +6,15 @@
 
 #include <fstream>
 #include <iostream>
+#include <cstring>
+#include <cstdint>
+#include <limits>
 
 #include "meshcore/utility/FileParser.h"
+#include "meshcore/utility/MemoryMappedFile.h"
 #include "meshcore/geometric/Intersection.h"
+#include "meshcore/acceleration/BoundingVolumeHierarchy.h"
+#include "meshcore/acceleration/CachingBoundsTreeFactory.h"
 #include <boost/functional/hash.hpp>
 
 #ifndef MESHCORE_DATA_DIR
@@ -311,4 +317,315 @@ const std::string &StripPackingProblem::getInstancePath() const {
 
 const AABB &StripPackingProblem::getContainer() const {
     return container;
+}
+
+namespace {
+
+    /*
+     * Layout of a bundle file (little endian, native float representation):
+     *   BundleHeader | BundleItemEntry[itemTypeCount] | data sections
+     * Every data section starts on a BUNDLE_ALIGNMENT boundary. The loader copies each section out of the memory mapping,
+     * as ModelSpaceMesh and BoundingVolumeHierarchy own their buffers; the mapping only avoids reading the file through a stream.
+     */
+    constexpr char BUNDLE_MAGIC[8] = {'M', 'C', 'B', 'U', 'N', 'D', 'L', 'E'};
+    constexpr uint32_t BUNDLE_VERSION = 1;
+    constexpr uint64_t BUNDLE_ALIGNMENT = 64;
+
+    struct BundleSection {
+        uint64_t offset = 0;
+        uint64_t count = 0;
+    };
+
+    struct BundleHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t itemTypeCount;
+        uint32_t itemOrigin;
+        float containerMinimum[3];
+        float containerMaximum[3];
+        BundleSection name;
+        BundleSection instancePath;
+        BundleSection itemEntries;
+    };
+
+    struct BundleItemEntry {
+        uint64_t demand;
+        BundleSection name;
+        BundleSection vertices;         // Vertex
+        BundleSection triangles;        // uint32_t[3]
+        BundleSection hullVertices;     // Vertex
+        BundleSection hullTriangles;    // uint32_t[3]
+        BundleSection nodes;            // BundleNode
+        BundleSection nodeTriangles;    // Vertex[3]
+        float boundsMinimum[3];
+        float boundsMaximum[3];
+        float volumeCentroid[3];
+        float volume;
+    };
+
+    struct BundleNode {
+        float minimum[3];
+        float maximum[3];
+        uint32_t triangleCount;
+        uint32_t split;
+        uint32_t firstChildOrTriangleIndex;
+        uint32_t padding;
+    };
+
+    static_assert(sizeof(Vertex) == 3 * sizeof(float), "Vertices are stored as tightly packed floats");
+    static_assert(std::is_trivially_copyable_v<BundleHeader> && std::is_trivially_copyable_v<BundleItemEntry> && std::is_trivially_copyable_v<BundleNode>);
+
+    class BundleWriter {
+        std::vector<char> buffer;
+    public:
+        template<class T>
+        BundleSection append(const T* data, size_t count) {
+            buffer.resize((buffer.size() + BUNDLE_ALIGNMENT - 1) / BUNDLE_ALIGNMENT * BUNDLE_ALIGNMENT, 0);
+            BundleSection section{buffer.size(), count};
+            const auto bytes = reinterpret_cast<const char*>(data);
+            buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+            return section;
+        }
+
+        BundleSection append(const std::string& string) {
+            return append(string.data(), string.size());
+        }
+
+        BundleSection append(const std::vector<IndexTriangle>& triangles) {
+            std::vector<uint32_t> indices;
+            indices.reserve(3 * triangles.size());
+            for (const auto &triangle: triangles) {
+                assert(triangle.vertexIndex0 <= UINT32_MAX && triangle.vertexIndex1 <= UINT32_MAX && triangle.vertexIndex2 <= UINT32_MAX);
+                indices.emplace_back(triangle.vertexIndex0);
+                indices.emplace_back(triangle.vertexIndex1);
+                indices.emplace_back(triangle.vertexIndex2);
+            }
+            BundleSection section = append(indices.data(), indices.size());
+            section.count = triangles.size();
+            return section;
+        }
+
+        template<class T>
+        void overwrite(const BundleSection& section, const T* data) {
+            std::memcpy(buffer.data() + section.offset, data, section.count * sizeof(T));
+        }
+
+        [[nodiscard]] const std::vector<char>& getBuffer() const {
+            return buffer;
+        }
+    };
+
+    template<class T>
+    std::vector<T> readBundleSection(const MemoryMappedFile& file, const BundleSection& section) {
+        if(section.offset > file.getSize() || section.count > (file.getSize() - section.offset) / sizeof(T)){
+            throw std::runtime_error("Bundle section exceeds the size of the file");
+        }
+        std::vector<T> result(section.count);
+        std::memcpy(result.data(), file.getData() + section.offset, section.count * sizeof(T));
+        return result;
+    }
+
+    std::string readBundleString(const MemoryMappedFile& file, const BundleSection& section) {
+        auto characters = readBundleSection<char>(file, section);
+        return {characters.begin(), characters.end()};
+    }
+
+    std::vector<IndexTriangle> readBundleTriangles(const MemoryMappedFile& file, const BundleSection& section, size_t vertexCount) {
+        if(section.count > file.getSize() / (3 * sizeof(uint32_t))){
+            throw std::runtime_error("Bundle section exceeds the size of the file");
+        }
+        auto indices = readBundleSection<uint32_t>(file, BundleSection{section.offset, 3 * section.count});
+        std::vector<IndexTriangle> triangles;
+        triangles.reserve(section.count);
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            if(indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount){
+                throw std::runtime_error("Bundle triangle refers to a vertex that doesn't exist");
+            }
+            triangles.emplace_back(indices[i], indices[i + 1], indices[i + 2]);
+        }
+        return triangles;
+    }
+}
+
+/**
+ * @brief Write the problem, including all data derived from its items, to a single versioned binary file.
+ *
+ * Next to the vertex and index buffers of each item type, the bundle holds its convex hull, bounds, volume, volume centroid
+ * and the flat BoundingVolumeHierarchy. Loading a bundle therefore avoids parsing mesh files and rebuilding these structures.
+ *
+ * @param bundlePath The path of the file to write, overwritten if it exists
+ */
+void StripPackingProblem::saveBundle(const std::string &bundlePath) const {
+
+    BundleWriter writer;
+
+    // Reserve space for the header and the item table, these are filled in when all offsets are known
+    BundleHeader header{};
+    const auto headerSection = writer.append(&header, 1);
+    std::vector<BundleItemEntry> entries(requiredItems.size());
+    const auto entriesSection = writer.append(entries.data(), entries.size());
+
+    std::memcpy(header.magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC));
+    header.version = BUNDLE_VERSION;
+    header.itemTypeCount = static_cast<uint32_t>(requiredItems.size());
+    header.itemOrigin = static_cast<uint32_t>(itemOrigin);
+    for (int i = 0; i < 3; ++i){
+        header.containerMinimum[i] = container.getMinimum()[i];
+        header.containerMaximum[i] = container.getMaximum()[i];
+    }
+    header.name = writer.append(name);
+    header.instancePath = writer.append(instancePath);
+    header.itemEntries = entriesSection;
+
+    for (size_t itemIndex = 0; itemIndex < requiredItems.size(); ++itemIndex){
+        const auto& item = requiredItems[itemIndex];
+        auto& entry = entries[itemIndex];
+
+        entry.demand = requiredItemCounts[itemIndex];
+        entry.name = writer.append(item->getName());
+        entry.vertices = writer.append(item->getVertices().data(), item->getVertices().size());
+        entry.triangles = writer.append(item->getTriangles());
+
+        const auto& hull = item->getConvexHull();
+        entry.hullVertices = writer.append(hull->getVertices().data(), hull->getVertices().size());
+        entry.hullTriangles = writer.append(hull->getTriangles());
+
+        const auto& bounds = item->getBounds();
+        const auto volumeCentroid = item->getVolumeCentroid();
+        for (int i = 0; i < 3; ++i){
+            entry.boundsMinimum[i] = bounds.getMinimum()[i];
+            entry.boundsMaximum[i] = bounds.getMaximum()[i];
+            entry.volumeCentroid[i] = volumeCentroid[i];
+        }
+        entry.volume = item->getVolume();
+
+        // Flatten the bounding volume hierarchy
+        const auto& tree = CachingBoundsTreeFactory<BoundingVolumeHierarchy>::getBoundsTree(item);
+        std::vector<BundleNode> nodes;
+        nodes.reserve(tree->getNodes().size());
+        for (const auto &node: tree->getNodes()){
+            BundleNode bundleNode{};
+            for (int i = 0; i < 3; ++i){
+                bundleNode.minimum[i] = node.bounds.getMinimum()[i];
+                bundleNode.maximum[i] = node.bounds.getMaximum()[i];
+            }
+            bundleNode.triangleCount = node.triangleCount;
+            bundleNode.split = node.split;
+            bundleNode.firstChildOrTriangleIndex = node.firstChildOrTriangleIndex;
+            nodes.emplace_back(bundleNode);
+        }
+        entry.nodes = writer.append(nodes.data(), nodes.size());
+
+        std::vector<Vertex> nodeTriangleVertices;
+        nodeTriangleVertices.reserve(3 * tree->getTriangles().size());
+        for (const auto &triangle: tree->getTriangles()){
+            nodeTriangleVertices.insert(nodeTriangleVertices.end(), std::begin(triangle.vertices), std::end(triangle.vertices));
+        }
+        entry.nodeTriangles = writer.append(nodeTriangleVertices.data(), nodeTriangleVertices.size());
+        entry.nodeTriangles.count = tree->getTriangles().size();
+    }
+
+    writer.overwrite(headerSection, &header);
+    writer.overwrite(entriesSection, entries.data());
+
+    std::ofstream stream(bundlePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!stream.is_open()){
+        throw std::runtime_error("Could not open file " + bundlePath);
+    }
+    stream.write(writer.getBuffer().data(), static_cast<std::streamsize>(writer.getBuffer().size()));
+}
+
+/**
+ * @brief Load a problem previously written with saveBundle.
+ *
+ * The file is memory mapped, the derived data of each item is restored into its ModelSpaceMesh and
+ * the bounding volume hierarchies are registered in the CachingBoundsTreeFactory.
+ *
+ * @param bundlePath The path of the bundle file
+ * @return The restored problem
+ */
+std::shared_ptr<StripPackingProblem> StripPackingProblem::loadBundle(const std::string &bundlePath) {
+
+    MemoryMappedFile file(bundlePath);
+
+    if(file.getSize() < sizeof(BundleHeader)){
+        throw std::runtime_error("File " + bundlePath + " is not a valid bundle");
+    }
+    BundleHeader header{};
+    std::memcpy(&header, file.getData(), sizeof(BundleHeader));
+    if(std::memcmp(header.magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC)) != 0){
+        throw std::runtime_error("File " + bundlePath + " is not a valid bundle");
+    }
+    if(header.version != BUNDLE_VERSION){
+        throw std::runtime_error("Bundle " + bundlePath + " has version " + std::to_string(header.version) + ", expected version " + std::to_string(BUNDLE_VERSION));
+    }
+
+    const auto entries = readBundleSection<BundleItemEntry>(file, header.itemEntries);
+    if(entries.size() != header.itemTypeCount){
+        throw std::runtime_error("Bundle " + bundlePath + " has " + std::to_string(entries.size()) + " item entries, expected " + std::to_string(header.itemTypeCount));
+    }
+
+    std::vector<std::shared_ptr<ModelSpaceMesh>> itemTypes;
+    std::vector<size_t> itemDemand;
+    itemTypes.reserve(entries.size());
+    itemDemand.reserve(entries.size());
+    for (const auto &entry: entries){
+
+        auto vertices = readBundleSection<Vertex>(file, entry.vertices);
+        auto triangles = readBundleTriangles(file, entry.triangles, vertices.size());
+        auto item = std::make_shared<ModelSpaceMesh>(std::move(vertices), std::move(triangles));
+        item->setName(readBundleString(file, entry.name));
+
+        auto hullVertices = readBundleSection<Vertex>(file, entry.hullVertices);
+        auto hullTriangles = readBundleTriangles(file, entry.hullTriangles, hullVertices.size());
+        auto hull = std::make_shared<ModelSpaceMesh>(std::move(hullVertices), std::move(hullTriangles));
+        hull->setName("Convex hull of " + item->getName());
+
+        const AABB bounds(Vertex(entry.boundsMinimum[0], entry.boundsMinimum[1], entry.boundsMinimum[2]),
+                          Vertex(entry.boundsMaximum[0], entry.boundsMaximum[1], entry.boundsMaximum[2]));
+        const Vertex volumeCentroid(entry.volumeCentroid[0], entry.volumeCentroid[1], entry.volumeCentroid[2]);
+        item->setPrecomputedProperties(bounds, entry.volume, volumeCentroid, hull);
+
+        // Restore the bounding volume hierarchy
+        const auto bundleNodes = readBundleSection<BundleNode>(file, entry.nodes);
+        if(bundleNodes.empty() || entry.nodeTriangles.count > file.getSize() / (3 * sizeof(Vertex))){
+            throw std::runtime_error("Bundle " + bundlePath + " has an invalid bounding volume hierarchy");
+        }
+        std::vector<BoundingVolumeHierarchy::Node> nodes;
+        nodes.reserve(bundleNodes.size());
+        for (size_t nodeIndex = 0; nodeIndex < bundleNodes.size(); ++nodeIndex){
+            // Children and triangle ranges are traversed without bounds checks, so they have to lie within the arrays,
+            // children follow their parent so the traversal can't cycle
+            const auto& bundleNode = bundleNodes[nodeIndex];
+            const uint64_t first = bundleNode.firstChildOrTriangleIndex;
+            const auto valid = bundleNode.split != 0 ? bundleNode.triangleCount == 0 && first > nodeIndex && first + 2 <= bundleNodes.size()
+                                                     : bundleNode.triangleCount <= std::numeric_limits<unsigned short>::max() && first + bundleNode.triangleCount <= entry.nodeTriangles.count;
+            if(!valid){
+                throw std::runtime_error("Bundle " + bundlePath + " has an invalid bounding volume hierarchy");
+            }
+            BoundingVolumeHierarchy::Node node;
+            node.bounds = AABB(Vertex(bundleNode.minimum[0], bundleNode.minimum[1], bundleNode.minimum[2]),
+                               Vertex(bundleNode.maximum[0], bundleNode.maximum[1], bundleNode.maximum[2]));
+            node.triangleCount = static_cast<unsigned short>(bundleNode.triangleCount);
+            node.split = bundleNode.split != 0;
+            node.firstChildOrTriangleIndex = bundleNode.firstChildOrTriangleIndex;
+            nodes.emplace_back(node);
+        }
+        const auto nodeTriangleVertices = readBundleSection<Vertex>(file, BundleSection{entry.nodeTriangles.offset, 3 * entry.nodeTriangles.count});
+        std::vector<VertexTriangle> nodeTriangles;
+        nodeTriangles.reserve(entry.nodeTriangles.count);
+        for (size_t i = 0; i < nodeTriangleVertices.size(); i += 3){
+            nodeTriangles.emplace_back(nodeTriangleVertices[i], nodeTriangleVertices[i + 1], nodeTriangleVertices[i + 2]);
+        }
+        CachingBoundsTreeFactory<BoundingVolumeHierarchy>::putBoundsTree(item, std::make_shared<BoundingVolumeHierarchy>(std::move(nodes), std::move(nodeTriangles)));
+
+        itemTypes.emplace_back(item);
+        itemDemand.emplace_back(entry.demand);
+    }
+
+    const AABB container(Vertex(header.containerMinimum[0], header.containerMinimum[1], header.containerMinimum[2]),
+                         Vertex(header.containerMaximum[0], header.containerMaximum[1], header.containerMaximum[2]));
+
+    return std::make_shared<StripPackingProblem>(readBundleString(file, header.instancePath), readBundleString(file, header.name),
+                                                 container, itemTypes, itemDemand, static_cast<ObjectOrigin>(header.itemOrigin));
 }
\ No newline at end of file
@@ -7,78 +7,105 @@
 #include "meshcore/geometric/Intersection.h"
 #include <fstream>
 #include <iostream>
+#include <typeinfo>
+
+StripPackingSolution::StripPackingSolution(const std::shared_ptr<StripPackingProblem> &problem): problem(problem) {
+    const auto numberOfItems = problem->getTotalNumberOfItems();
+
+    // The item types and prototypes never change, so they are created once and shared by all clones of this solution
+    auto types = std::make_shared<std::vector<size_t>>();
+    auto prototypes = std::make_shared<std::vector<std::shared_ptr<WorldSpaceMesh>>>();
+    types->reserve(numberOfItems);
+    prototypes->reserve(numberOfItems);
+    const auto& requiredItems = problem->getRequiredItems();
+    const auto& requiredItemCounts = problem->getRequiredItemCounts();
+    for (size_t typeIndex = 0; typeIndex < requiredItems.size(); ++typeIndex){
+        for (size_t count = 0; count < requiredItemCounts[typeIndex]; ++count){
+            types->push_back(typeIndex);
+            prototypes->push_back(std::make_shared<WorldSpaceMesh>(requiredItems[typeIndex]));
+            maxHeight += requiredItems[typeIndex]->getBounds().getMaximum().z;
+        }
+    }
+    itemTypes = std::move(types);
+    itemPrototypes = std::move(prototypes);
+
+    positions.resize(numberOfItems, glm::vec3(0.0f));
+    rotations.resize(numberOfItems, Quaternion());
+    scales.resize(numberOfItems, 1.0f);
+    itemAABBs.resize(numberOfItems);
+    validItemAABBs.resize(numberOfItems, false);
+    extremeHullVertexIndices.resize(numberOfItems, {0, 0, 0, 0, 0, 0});
+    itemViews.resize(numberOfItems);
+}
 
-StripPackingSolution::StripPackingSolution(const std::shared_ptr<StripPackingProblem> &problem):
-    problem(problem), cachedAABBs(problem->getTotalNumberOfItems(), std::nullopt) {
-    // Initialize items and item names
-    items.reserve(problem->getTotalNumberOfItems());
-    itemNames.reserve(problem->getTotalNumberOfItems());
-
-    bool uniqueNames = false;
-
-    if (uniqueNames){
-        std::unordered_map<std::string, int> nameCounts; // To handle duplicate names
-
-        for (const auto& mesh : problem->listRequiredItems()) {
-            items.push_back(std::make_shared<WorldSpaceMesh>(mesh));
-
-            std::string name = mesh->getName();
-            auto it = nameCounts.find(name);
-            if (it == nameCounts.end()) {
-                nameCounts[name] = 0;  // first occurrence
-            } else {
-                ++(it->second);        // duplicate found
-                name += "_" + std::to_string(it->second);
-            }
-            itemNames.push_back(name);
+StripPackingSolution::StripPackingSolution(const StripPackingSolution &other):
+    problem(other.problem),
+    itemTypes(other.itemTypes),
+    itemPrototypes(other.itemPrototypes),
+    positions(other.positions),
+    rotations(other.rotations),
+    scales(other.scales),
+    itemAABBs(other.itemAABBs),
+    validItemAABBs(other.validItemAABBs),
+    extremeHullVertexIndices(other.extremeHullVertexIndices),
+    itemViews(other.itemViews.size()),
+    cachedTotalHeight(other.cachedTotalHeight),
+    orientationCache(other.orientationCache),
+    useCollisionProxies(other.useCollisionProxies),
+    collisionProxyStatistics(other.collisionProxyStatistics),
+    maxHeight(other.maxHeight) {}
+
+size_t StripPackingSolution::getNumberOfItems() const {
+    return positions.size();
+}
 
-            maxHeight += mesh->getBounds().getMaximum().z;
-        }
-    } else{
-        for (const auto& mesh : problem->listRequiredItems())
-        {
-            std::string name = mesh->getName();
-            items.push_back(std::make_shared<WorldSpaceMesh>(mesh));
-            itemNames.push_back(name);
-            maxHeight += mesh->getBounds().getMaximum().z;
-        }
+const std::vector<std::shared_ptr<WorldSpaceMesh>> & StripPackingSolution::getItems() const {
+    for (size_t itemIndex = 0; itemIndex < itemViews.size(); ++itemIndex) {
+        static_cast<void>(getItem(itemIndex));
+    }
+    return itemViews;
+}
 
+const std::shared_ptr<WorldSpaceMesh> & StripPackingSolution::getItem(size_t itemIndex) const {
+    if(!itemViews[itemIndex]){
+        itemViews[itemIndex] = (*itemPrototypes)[itemIndex]->clone();
+        synchroniseItemView(itemIndex);
     }
+    return itemViews[itemIndex];
 }
 
-StripPackingSolution::StripPackingSolution(const StripPackingSolution &other): problem(other.problem), itemNames(other.itemNames), cachedAABBs(other.cachedAABBs), maxHeight(other.maxHeight) {
-    items.reserve(other.items.size());
-    for (const auto& item : other.items) {
-        items.push_back(item->clone());
+void StripPackingSolution::synchroniseItemView(size_t itemIndex) const {
+    if(itemViews[itemIndex]){
+        itemViews[itemIndex]->setModelTransformation(getItemTransformation(itemIndex));
     }
 }
 
-const std::vector<std::shared_ptr<WorldSpaceMesh>> & StripPackingSolution::getItems() const {
-    return items;
+size_t StripPackingSolution::getItemType(size_t itemIndex) const {
+    return (*itemTypes)[itemIndex];
 }
 
-const std::shared_ptr<WorldSpaceMesh> & StripPackingSolution::getItem(size_t itemIndex) const {
-    return items[itemIndex];
+const std::shared_ptr<ModelSpaceMesh> & StripPackingSolution::getItemModelSpaceMesh(size_t itemIndex) const {
+    return problem->getRequiredItems()[(*itemTypes)[itemIndex]];
 }
 
 const std::string & StripPackingSolution::getItemName(size_t itemIndex) const {
-    return itemNames[itemIndex];
+    return getItemModelSpaceMesh(itemIndex)->getName();
 }
 
-const size_t StripPackingSolution::getItemIndexByName(const std::string &name) const {
-    for (size_t itemIndex = 0; itemIndex < itemNames.size(); ++itemIndex) {
-        if (itemNames[itemIndex] == name) {
+size_t StripPackingSolution::getItemIndexByName(const std::string &name) const {
+    for (size_t itemIndex = 0; itemIndex < getNumberOfItems(); ++itemIndex) {
+        if (getItemName(itemIndex) == name) {
             return (itemIndex);
         }
     }
     return -1; // Return -1 if the item name is not found
 }
 
-const size_t StripPackingSolution::getItemIndexByID(const std::string &id) const
+size_t StripPackingSolution::getItemIndexByID(const std::string &id) const
 {
-    std::cout << "Number of items in problem: " <<items.size() << std::endl;
-    for (size_t itemIndex = 0; itemIndex < items.size(); ++itemIndex) {
-        if (items[itemIndex]->getId() == id) {
+    std::cout << "Number of items in problem: " << getNumberOfItems() << std::endl;
+    for (size_t itemIndex = 0; itemIndex < getNumberOfItems(); ++itemIndex) {
+        if ((*itemPrototypes)[itemIndex]->getId() == id) {
             std::cout << "ItemIndex of item with id " << id << " = " << itemIndex << std::endl;
             return (itemIndex);
         }
@@ -87,54 +114,132 @@ const size_t StripPackingSolution::getItemIndexByID(const std::string &id) const
     return -1; // Return -1 if the item name is not found
 }
 
-const AABB & StripPackingSolution::getItemAABB(size_t itemIndex) const {
+/**
+ * @brief Support queries on the convex hull, warm-started from the extreme vertices of the previous transformation.
+ *
+ * Shares ModelSpaceMesh::computeSupportAABB with WorldSpaceMesh::computeTightWorldSpaceAABB, on the flat item arrays.
+ * Uses the precomputed bounds of the item's orientation instead if it was prepared in the orientation cache.
+ */
+AABB StripPackingSolution::computeItemAABB(size_t itemIndex) const {
+    if(orientationCache){
+        const auto orientedMesh = orientationCache->find(getItemModelSpaceMesh(itemIndex), rotations[itemIndex]);
+        if(orientedMesh){
+            return {positions[itemIndex] + scales[itemIndex] * orientedMesh->bounds.getMinimum(), positions[itemIndex] + scales[itemIndex] * orientedMesh->bounds.getMaximum()};
+        }
+    }
 
-    // Compute the AABB if not cached
-    if (!cachedAABBs[itemIndex]){
-        const auto& item = items[itemIndex];
+    return getItemModelSpaceMesh(itemIndex)->getConvexHull()->computeSupportAABB(positions[itemIndex], rotations[itemIndex], scales[itemIndex], extremeHullVertexIndices[itemIndex]);
+}
 
-        // Considering the vertices on the convex hull suffices for computing the AABB
-        const auto& modelSpaceVertices = item->getModelSpaceMesh()->getConvexHull()->getVertices();
+const AABB & StripPackingSolution::getItemAABB(size_t itemIndex) const {
 
-        // Compute the AABB from these vertices and the item transformation
-        cachedAABBs[itemIndex] = AABBFactory::createAABB(modelSpaceVertices, item->getModelTransformation());
+    // Compute the AABB if not cached
+    if (!validItemAABBs[itemIndex]){
+        itemAABBs[itemIndex] = computeItemAABB(itemIndex);
+        validItemAABBs[itemIndex] = true;
     }
 
     // Return the reference to the cached AABB
-    return *cachedAABBs[itemIndex];
+    return itemAABBs[itemIndex];
 }
 
 const std::shared_ptr<StripPackingProblem> & StripPackingSolution::getProblem() const {
     return problem;
 }
 
-const Transformation & StripPackingSolution::getItemTransformation(size_t itemIndex) const {
-    return items[itemIndex]->getModelTransformation();
+Transformation StripPackingSolution::getItemTransformation(size_t itemIndex) const {
+    Transformation transformation;
+    transformation.setPosition(positions[itemIndex]);
+    transformation.setRotation(rotations[itemIndex]);
+    transformation.setScale(scales[itemIndex]);
+    return transformation;
 }
 
-const float StripPackingSolution::getMaxHeight() const {
+float StripPackingSolution::getMaxHeight() const {
     return maxHeight;
 }
 
+const Heightmap &StripPackingSolution::getHeightmap() const {
+    if(!heightmap){
+        heightmap = std::make_shared<Heightmap>(problem->getContainer(), Heightmap::computeDefaultCellSize(problem->getContainer(), problem->getRequiredItems()));
+        for (size_t itemIndex = 0; itemIndex < getNumberOfItems(); ++itemIndex){
+            heightmap->setItem(itemIndex, getItemModelSpaceMesh(itemIndex), getItemTransformation(itemIndex));
+        }
+    }
+    return *heightmap;
+}
+
+const std::shared_ptr<OrientationCache> &StripPackingSolution::getOrientationCache() const {
+    return orientationCache;
+}
+
+void StripPackingSolution::setOrientationCache(const std::shared_ptr<OrientationCache> &cache) {
+    orientationCache = cache;
+}
+
+const std::shared_ptr<CollisionProxyStatistics> &StripPackingSolution::getCollisionProxyStatistics() const {
+    return collisionProxyStatistics;
+}
+
+void StripPackingSolution::setCollisionProxyStatistics(const std::shared_ptr<CollisionProxyStatistics> &statistics) {
+    collisionProxyStatistics = statistics;
+}
+
+bool StripPackingSolution::isUsingCollisionProxies() const {
+    return useCollisionProxies;
+}
+
+void StripPackingSolution::setUseCollisionProxies(bool use) {
+    useCollisionProxies = use;
+}
+
 void StripPackingSolution::setItemTransformation(size_t itemIndex, const Transformation &transformation) {
+
+    // The total height can only be updated incrementally if this item was not the one defining it
+    const bool definedTotalHeight = !cachedTotalHeight.has_value() || !validItemAABBs[itemIndex] || itemAABBs[itemIndex].getMaximum().z >= cachedTotalHeight.value();
+
     // Reset cached AABB when the transformation is updated
-    cachedAABBs[itemIndex].reset();
-    items[itemIndex]->setModelTransformation(transformation);
+    validItemAABBs[itemIndex] = false;
+    positions[itemIndex] = transformation.getPosition();
+    rotations[itemIndex] = transformation.getRotation();
+    scales[itemIndex] = transformation.getScale();
+    synchroniseItemView(itemIndex);
+    if(heightmap){
+        heightmap->setItem(itemIndex, getItemModelSpaceMesh(itemIndex), transformation);
+    }
+
+    if(definedTotalHeight){
+        cachedTotalHeight.reset();
+    }
+    else{
+        cachedTotalHeight = std::max(cachedTotalHeight.value(), getItemAABB(itemIndex).getMaximum().z);
+    }
 }
 
 float StripPackingSolution::computeTotalHeight() const {
-    float maximumHeight = 0.0f;
-    for (size_t itemIndex = 0; itemIndex < items.size(); ++itemIndex){
-        // Update the maximum height based on the AABB of each item
-        maximumHeight = std::max(maximumHeight, getItemAABB(itemIndex).getMaximum().z);
+    if(!cachedTotalHeight.has_value()){
+        float maximumHeight = 0.0f;
+        for (size_t itemIndex = 0; itemIndex < getNumberOfItems(); ++itemIndex){
+            // Update the maximum height based on the AABB of each item
+            maximumHeight = std::max(maximumHeight, getItemAABB(itemIndex).getMaximum().z);
+        }
+        cachedTotalHeight = maximumHeight;
+    }
+    return cachedTotalHeight.value();
+}
+
+void StripPackingSolution::prepareCaches() const {
+    static_cast<void>(computeTotalHeight());
+    for (size_t itemIndex = 0; itemIndex < getNumberOfItems(); ++itemIndex){
+        static_cast<void>(getItemAABB(itemIndex));
     }
-    return maximumHeight;
 }
 
 bool StripPackingSolution::isFeasible() const {
+    const auto numberOfItems = getNumberOfItems();
 
     // Check if the items are embedded within the container
-    for (size_t itemIndex = 0; itemIndex < itemNames.size(); ++itemIndex) {
+    for (size_t itemIndex = 0; itemIndex < numberOfItems; ++itemIndex) {
         bool contained = problem->getContainer().containsAABB(getItemAABB(itemIndex));
         if (!contained){
             return false;
@@ -142,23 +247,34 @@ bool StripPackingSolution::isFeasible() const {
     }
 
     // Check if the items collide with each other
-    for (size_t firstItemIndex = 0; firstItemIndex < itemNames.size(); ++firstItemIndex) {
-
-        const auto& firstItem = items[firstItemIndex];
-        const auto& firstItemAABB = getItemAABB(firstItemIndex);
+    for (size_t firstItemIndex = 0; firstItemIndex < numberOfItems; ++firstItemIndex) {
 
-        for (size_t secondItemIndex = firstItemIndex+1; secondItemIndex < itemNames.size(); ++secondItemIndex) {
+        const auto& firstItemAABB = itemAABBs[firstItemIndex];
 
-            const auto& secondItem = items[secondItemIndex];
-            const auto& secondItemAABB = getItemAABB(secondItemIndex);
+        for (size_t secondItemIndex = firstItemIndex+1; secondItemIndex < numberOfItems; ++secondItemIndex) {
 
             // AABB separation check
-            if (!Intersection::intersect(firstItemAABB, secondItemAABB)) {
+            if (!Intersection::intersect(firstItemAABB, itemAABBs[secondItemIndex])) {
                 continue; // No intersection if AABBs do not intersect
             }
 
-            // Mesh intersection check
-            if (Intersection::intersect(*firstItem, *secondItem)) {
+            // Items with cached orientations and equal scales only differ by a translation
+            if (orientationCache && scales[firstItemIndex] == scales[secondItemIndex]) {
+                const auto firstOrientedMesh = orientationCache->find(getItemModelSpaceMesh(firstItemIndex), rotations[firstItemIndex]);
+                const auto secondOrientedMesh = orientationCache->find(getItemModelSpaceMesh(secondItemIndex), rotations[secondItemIndex]);
+                if (firstOrientedMesh && secondOrientedMesh) {
+                    if (Intersection::intersect(*firstOrientedMesh, positions[firstItemIndex], *secondOrientedMesh, positions[secondItemIndex], scales[firstItemIndex])) {
+                        return false;
+                    }
+                    continue;
+                }
+            }
+
+            // Mesh intersection check, only the items that reach this point need a WorldSpaceMesh view
+            const auto intersects = useCollisionProxies ?
+                    Intersection::intersectProxyFirst(*getItem(firstItemIndex), *getItem(secondItemIndex), collisionProxyStatistics.get()) :
+                    Intersection::intersect(*getItem(firstItemIndex), *getItem(secondItemIndex));
+            if (intersects) {
                 return false;
             }
         }
@@ -170,6 +286,51 @@ std::shared_ptr<AbstractSolution> StripPackingSolution::clone() const {
     return std::make_shared<StripPackingSolution>(*this);
 }
 
+bool StripPackingSolution::copyStateFrom(const AbstractSolution &other) {
+
+    // Extended classes may hold additional state, so they should provide their own implementation
+    if(typeid(*this) != typeid(StripPackingSolution) || typeid(other) != typeid(StripPackingSolution)){
+        return false;
+    }
+
+    const auto& otherSolution = static_cast<const StripPackingSolution&>(other);
+    if(otherSolution.problem != this->problem){
+        return false;
+    }
+
+    copyStripPackingStateFrom(otherSolution);
+    return true;
+}
+
+void StripPackingSolution::copyStripPackingStateFrom(const StripPackingSolution &other) {
+    assert(other.problem == this->problem);
+
+    // Only the items that differ have to be updated in the heightmap
+    std::vector<size_t> changedItems;
+    if(heightmap){
+        for (size_t itemIndex = 0; itemIndex < positions.size(); ++itemIndex){
+            if(positions[itemIndex] != other.positions[itemIndex] || rotations[itemIndex] != other.rotations[itemIndex] || scales[itemIndex] != other.scales[itemIndex]){
+                changedItems.push_back(itemIndex);
+            }
+        }
+    }
+
+    std::copy(other.positions.begin(), other.positions.end(), positions.begin());
+    std::copy(other.rotations.begin(), other.rotations.end(), rotations.begin());
+    std::copy(other.scales.begin(), other.scales.end(), scales.begin());
+    std::copy(other.itemAABBs.begin(), other.itemAABBs.end(), itemAABBs.begin());
+    std::copy(other.validItemAABBs.begin(), other.validItemAABBs.end(), validItemAABBs.begin());
+    std::copy(other.extremeHullVertexIndices.begin(), other.extremeHullVertexIndices.end(), extremeHullVertexIndices.begin());
+    for (size_t itemIndex = 0; itemIndex < itemViews.size(); ++itemIndex){
+        synchroniseItemView(itemIndex);
+    }
+    for (const auto itemIndex: changedItems){
+        heightmap->setItem(itemIndex, getItemModelSpaceMesh(itemIndex), getItemTransformation(itemIndex));
+    }
+    cachedTotalHeight = other.cachedTotalHeight;
+    maxHeight = other.maxHeight;
+}
+
 std::shared_ptr<StripPackingSolution> StripPackingSolution::fromJson(nlohmann::ordered_json &json) {
 
     auto itemOrigin = ObjectOrigin::Original;
@@ -191,9 +352,8 @@ std::shared_ptr<StripPackingSolution> StripPackingSolution::fromJson(nlohmann::o
 
     std::map<std::string, std::vector<size_t>> itemIndexMap;
 
-    for (size_t itemIndex = 0; itemIndex < solution->getItems().size(); ++itemIndex) {
-        const auto& item = solution->getItems()[itemIndex];
-        auto name = item->getModelSpaceMesh()->getName();
+    for (size_t itemIndex = 0; itemIndex < solution->getNumberOfItems(); ++itemIndex) {
+        const auto& name = solution->getItemModelSpaceMesh(itemIndex)->getName();
         if(itemIndexMap.find(name) == itemIndexMap.end()){
             itemIndexMap[name] = std::vector<size_t>();
         }
@@ -238,10 +398,10 @@ std::shared_ptr<StripPackingSolution> StripPackingSolution::fromJson(std::string
 
 nlohmann::ordered_json StripPackingSolution::toJson() const {
     nlohmann::ordered_json result;
-    for (size_t itemIndex = 0; itemIndex < this->getItems().size(); ++itemIndex) {
+    for (size_t itemIndex = 0; itemIndex < this->getNumberOfItems(); ++itemIndex) {
 
         nlohmann::ordered_json itemJson;
-        const auto& transformation = getItemTransformation(itemIndex);
+        const auto transformation = getItemTransformation(itemIndex);
 
         nlohmann::ordered_json transformationJson;
         transformationJson["position"] = {transformation.getPosition().x, transformation.getPosition().y, transformation.getPosition().z};
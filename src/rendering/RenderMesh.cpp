@@ -33,9 +33,8 @@ RenderMesh::RenderMesh(const WorldSpaceMesh& worldSpaceMesh):
     const std::vector<Vertex>& vertices = worldSpaceMesh.getModelSpaceMesh()->getVertices();
     const std::vector<IndexTriangle>& triangles = worldSpaceMesh.getModelSpaceMesh()->getTriangles();
 
-    // We only force the computation of faces and face edges if the number of triangles is small enough
-    const std::vector<IndexFace>& faces = triangles.size() < 1000 ? worldSpaceMesh.getModelSpaceMesh()->getFaces() : std::vector<IndexFace>();
-    const std::vector<IndexEdge>& faceEdges = triangles.size() < 1000 ? worldSpaceMesh.getModelSpaceMesh()->getFaceEdges() : std::vector<IndexEdge>();
+    const std::vector<IndexFace>& faces = worldSpaceMesh.getModelSpaceMesh()->getFaces();
+    const std::vector<IndexEdge>& faceEdges = worldSpaceMesh.getModelSpaceMesh()->getFaceEdges();
 
     this->numberOfVertices = vertices.size();
     this->numberOfFaces = faces.size();
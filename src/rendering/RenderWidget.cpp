@@ -346,7 +346,7 @@ void RenderWidget::setDefaultSolutionRenderCallback() {
             if (const auto& sol = std::dynamic_pointer_cast<const StripPackingSolution>(solution)) {
                 renderWidget->clearGroup("MinimalContainer");
                 float maximumHeight = 0.0f;
-                for (size_t itemIndex = 0; itemIndex < sol->getItems().size(); ++itemIndex) {
+                for (size_t itemIndex = 0; itemIndex < sol->getNumberOfItems(); ++itemIndex) {
                     const auto& item = sol->getItem(itemIndex);
                     const auto& itemName = sol->getItemName(itemIndex);
 
@@ -409,11 +409,96 @@ void FileParser::saveFileOBJ(const std::string &filePath, const std::shared_ptr<
     basicOfstream.close();
 }
 
-std::shared_ptr<ModelSpaceMesh> FileParser::parseFileBinvox(const std::string &filePath) {
+std::shared_ptr<VoxelGrid> FileParser::loadVoxelFile(const std::string &filePath) {
+
+    if(!std::filesystem::exists(filePath)){
+        auto absolutePath = std::filesystem::absolute(filePath);
+        std::cout << "Warning: File " << absolutePath << " does not exist!" << std::endl;
+        return nullptr;
+    }
+
+    std::string extension = filePath.substr(filePath.find_last_of('.') + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c){ return std::tolower(c); });
+    if(extension != "binvox"){
+        std::cout << "Warning: Extension ." << extension << " of file " << filePath << " not supported for voxel grids!" << std::endl;
+        return nullptr;
+    }
+
+    auto voxelGrid = parseVoxelGridBinvox(filePath);
+    voxelGrid->setName(std::filesystem::path(filePath).filename().string());
+    return voxelGrid;
+}
+
+void FileParser::saveVoxelFile(const std::string &filePath, const VoxelGrid &voxelGrid) {
+
+    std::string extension = filePath.substr(filePath.find_last_of('.') + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c){ return std::tolower(c); });
+
+    if(std::filesystem::exists(filePath)){
+        std::cout << "Warning: File " << filePath << " already exists!" << std::endl;
+        return;
+    }
+
+    if(extension == "binvox") saveFileBinvox(filePath, voxelGrid);
+    else{
+        std::cout << "Warning: Extension ." << extension << " for saving voxel grid " << filePath << " not supported!" << std::endl;
+    }
+}
+
+void FileParser::saveFileBinvox(const std::string &filePath, const VoxelGrid &voxelGrid) {
+
+    // Binvox has a single scale, so the grid is padded to a cube to keep its voxels
+    const auto& voxelSize = voxelGrid.getVoxelSize();
+    if(voxelSize.y != voxelSize.x || voxelSize.z != voxelSize.x){
+        throw std::invalid_argument("Only grids of cubic voxels can be saved as binvox files");
+    }
+    const auto& gridDimensions = voxelGrid.getDimensions();
+    const auto size = std::max(gridDimensions.x, std::max(gridDimensions.y, gridDimensions.z));
+    const auto translation = voxelGrid.getOrigin() / voxelSize.x; // In voxels, as read by parseVoxelGridBinvox
+
+    std::ofstream stream(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!stream.is_open()){
+        throw std::runtime_error("Could not open file " + filePath);
+    }
+    stream.imbue(std::locale::classic());
+    stream.precision(std::numeric_limits<float>::max_digits10);
+    stream << "#binvox 1\n";
+    stream << "dim " << size << " " << size << " " << size << "\n";
+    stream << "translate " << translation.x << " " << translation.y << " " << translation.z << "\n";
+    stream << "scale " << float(size) * voxelSize.x << "\n";
+    stream << "data\n";
+
+    // Run-length encoded (value, count) pairs, with y running fastest, then z, then x
+    std::vector<unsigned char> data;
+    unsigned char value = 0;
+    unsigned char count = 0;
+    for (unsigned int x = 0; x < size; ++x){
+        for (unsigned int z = 0; z < size; ++z){
+            for (unsigned int y = 0; y < size; ++y){
+                const unsigned char occupied = x < gridDimensions.x && y < gridDimensions.y && z < gridDimensions.z && voxelGrid.isOccupied(x, y, z);
+                if(count > 0 && (occupied != value || count == 255)){
+                    data.push_back(value);
+                    data.push_back(count);
+                    count = 0;
+                }
+                value = occupied;
+                count++;
+            }
+        }
+    }
+    data.push_back(value);
+    data.push_back(count);
+    stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+std::shared_ptr<VoxelGrid> FileParser::parseVoxelGridBinvox(const std::string &filePath) {
 
     // Open a file stream
     // It's important to add the ios::binary flag to avoid false EOF detection before the end of the file
     std::ifstream stream(filePath, std::ios::in | std::ios::binary);
+    if(!stream.is_open()){
+        throw std::runtime_error("Could not open file " + filePath);
+    }
     std::string line;
 
     // Parse the first line
@@ -453,47 +538,72 @@ std::shared_ptr<ModelSpaceMesh> FileParser::parseFileBinvox(const std::string &f
     std::getline(stream, line);
     assert(line=="data");
 
-    // Start reading voxel data
-    unsigned int voxelCount = dimensions[0]*dimensions[1]*dimensions[2];
-    std::vector<bool> voxels;
-    voxels.reserve(voxelCount);
-    stream.unsetf(std::ios::skipws); // No white space skipping!
-    while(!stream.eof()){
-        unsigned char isVoxelByte;
-        stream >> isVoxelByte;
-        if(stream.eof()) break;
-        unsigned char newVoxelsByte;
-        stream >> newVoxelsByte;
-        if(stream.eof()) break;
-        bool isVoxel = (isVoxelByte & 0b00000001);
-        unsigned int newVoxels = newVoxelsByte;
-        assert(newVoxels >= 1u);
-        assert(newVoxels <= 255);
-        for(unsigned int i=0; i < newVoxels; i++){
-            voxels.emplace_back(isVoxel);
+    // Read all run-length encoded (value, count) pairs at once
+    const auto dataStart = stream.tellg();
+    stream.seekg(0, std::ios::end);
+    const auto dataSize = static_cast<size_t>(stream.tellg() - dataStart);
+    stream.seekg(dataStart);
+    std::vector<unsigned char> data(dataSize);
+    stream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(dataSize));
+
+    // Binvox stores the voxels with y running fastest, then z, then x
+    // (x, y, z) of the binvox file map to (x, y, z) of the grid, with dimensions[2] voxels along y and dimensions[1] along z
+    const glm::uvec3 gridDimensions(dimensions[0], dimensions[2], dimensions[1]);
+    auto voxelGrid = std::make_shared<VoxelGrid>(gridDimensions, Vertex(translation[0], translation[1], translation[2]) * scalingVector, scalingVector);
+
+    const size_t voxelsPerSlice = static_cast<size_t>(gridDimensions.y) * gridDimensions.z;
+    const size_t voxelCount = voxelsPerSlice * gridDimensions.x;
+    size_t voxelIndex = 0;
+    for (size_t i = 0; i + 1 < data.size() && voxelIndex < voxelCount; i += 2){
+        const bool isVoxel = data[i] & 0b00000001;
+        const size_t runLength = std::min(static_cast<size_t>(data[i + 1]), voxelCount - voxelIndex);
+        assert(runLength >= 1u);
+        if(isVoxel){
+
+            // Split the run into stretches along y, each with a constant (x, z)
+            auto x = static_cast<unsigned int>(voxelIndex / voxelsPerSlice);
+            auto z = static_cast<unsigned int>((voxelIndex % voxelsPerSlice) / gridDimensions.y);
+            auto y = static_cast<unsigned int>(voxelIndex % gridDimensions.y);
+            auto remaining = runLength;
+            while(remaining > 0){
+                const auto stretch = static_cast<unsigned int>(std::min(static_cast<size_t>(gridDimensions.y - y), remaining));
+                voxelGrid->setColumnRange(x, z, y, y + stretch);
+                remaining -= stretch;
+                y = 0;
+                if(++z == gridDimensions.z){
+                    z = 0;
+                    ++x;
+                }
+            }
         }
+        voxelIndex += runLength;
     }
-    assert(voxels.size() == voxelCount);
+    if(voxelIndex != voxelCount){
+        std::cout << "Warning: File " << filePath << " contains " << voxelIndex << " voxels instead of " << voxelCount << std::endl;
+    }
+
+    return voxelGrid;
+}
+
+std::shared_ptr<ModelSpaceMesh> FileParser::parseFileBinvox(const std::string &filePath) {
+
+    const auto voxelGrid = parseVoxelGridBinvox(filePath);
+    const auto& gridDimensions = voxelGrid->getDimensions();
+    const auto& scalingVector = voxelGrid->getVoxelSize();
+    const auto& gridOrigin = voxelGrid->getOrigin();
 
     // Convert the voxels to a mesh
     std::vector<Vertex> vertices;
     std::vector<IndexTriangle> triangles;
-    for (unsigned int x = 0; x < dimensions[0]; ++x) {
-        for (unsigned int z = 0; z < dimensions[1]; ++z) {
-            for (unsigned int y = 0; y < dimensions[2]; ++y) {
+    for (unsigned int x = 0; x < gridDimensions.x; ++x) {
+        for (unsigned int z = 0; z < gridDimensions.z; ++z) {
+            for (unsigned int y = 0; y < gridDimensions.y; ++y) {
 
-                // depth, width, height
-                // dimensions[0], dimensions[1], dimensions[2]
-                // x, z, y
-                unsigned int index = x * dimensions[1] * dimensions[2] + z * dimensions[1] + y;  // wxh = width * height = d * d
-                if(voxels[index]){
-//                if(voxels[z + y * dimensions[0] + x * dimensions[0] * dimensions[1]]){
+                if(voxelGrid->isOccupied(x, y, z)){
 
                     // Add the vertices
-                    auto min = glm::vec3(translation[0] + float(x), translation[1] + float(y),translation[2] + float(z));
-                    auto max = glm::vec3(translation[0] + float(x + 1), translation[1] + float(y + 1),translation[2] + float(z + 1));
-                    min *= scalingVector;
-                    max *= scalingVector;
+                    auto min = gridOrigin + glm::vec3(float(x), float(y), float(z)) * scalingVector;
+                    auto max = gridOrigin + glm::vec3(float(x + 1), float(y + 1), float(z + 1)) * scalingVector;
 
                     vertices.emplace_back(min.x, min.y, min.z);
                     vertices.emplace_back(max.x, min.y, min.z);
@@ -504,14 +614,14 @@ std::shared_ptr<ModelSpaceMesh> FileParser::parseFileBinvox(const std::string &f
                     vertices.emplace_back(max.x, max.y, max.z);
                     vertices.emplace_back(min.x, max.y, max.z);
 
-                    bool nextVoxelX = (x + 1 < dimensions[0]) && voxels[index + dimensions[1] * dimensions[2]];
-                    bool previousVoxelX = (x > 0) && voxels[index - dimensions[1] * dimensions[2]];
+                    bool nextVoxelX = (x + 1 < gridDimensions.x) && voxelGrid->isOccupied(x + 1, y, z);
+                    bool previousVoxelX = (x > 0) && voxelGrid->isOccupied(x - 1, y, z);
 
-                    bool nextVoxelY = (y + 1 < dimensions[2]) && voxels[index + 1];
-                    bool previousVoxelY = (y > 0) && voxels[index - 1];
+                    bool nextVoxelY = (y + 1 < gridDimensions.y) && voxelGrid->isOccupied(x, y + 1, z);
+                    bool previousVoxelY = (y > 0) && voxelGrid->isOccupied(x, y - 1, z);
 
-                    bool nextVoxelZ = (z + 1 < dimensions[1]) && voxels[index + dimensions[1]];
-                    bool previousVoxelZ = (z > 0) && voxels[index - dimensions[1]];
+                    bool nextVoxelZ = (z + 1 < gridDimensions.z) && voxelGrid->isOccupied(x, y, z + 1);
+                    bool previousVoxelZ = (z > 0) && voxelGrid->isOccupied(x, y, z - 1);
 
                     // Add the triangles
                     unsigned int numberOfVertices = vertices.size();
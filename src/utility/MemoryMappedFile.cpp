@@ -0,0 +1,78 @@
+#include "meshcore/utility/MemoryMappedFile.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MemoryMappedFile::MemoryMappedFile(const std::string &filePath) {
+#ifdef _WIN32
+    fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(fileHandle == INVALID_HANDLE_VALUE){
+        fileHandle = nullptr;
+        throw std::runtime_error("Could not open file " + filePath);
+    }
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(fileHandle, &fileSize)){
+        CloseHandle(fileHandle);
+        fileHandle = nullptr;
+        throw std::runtime_error("Could not determine the size of file " + filePath);
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+    if(size == 0) return; // Empty files can't be mapped
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mappingHandle == nullptr){
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Could not map file " + filePath);
+    }
+    data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if(data == nullptr){
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Could not map file " + filePath);
+    }
+#else
+    fileDescriptor = open(filePath.c_str(), O_RDONLY);
+    if(fileDescriptor < 0){
+        throw std::runtime_error("Could not open file " + filePath);
+    }
+    struct stat fileStatus{};
+    if(fstat(fileDescriptor, &fileStatus) != 0){
+        close(fileDescriptor);
+        throw std::runtime_error("Could not determine the size of file " + filePath);
+    }
+    size = static_cast<size_t>(fileStatus.st_size);
+    if(size == 0) return; // Empty files can't be mapped
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    if(mapping == MAP_FAILED){
+        close(fileDescriptor);
+        throw std::runtime_error("Could not map file " + filePath);
+    }
+    data = static_cast<const char*>(mapping);
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+#ifdef _WIN32
+    if(data) UnmapViewOfFile(data);
+    if(mappingHandle) CloseHandle(mappingHandle);
+    if(fileHandle) CloseHandle(fileHandle);
+#else
+    if(data) munmap(const_cast<char*>(data), size);
+    if(fileDescriptor >= 0) close(fileDescriptor);
+#endif
+}
+
+const char * MemoryMappedFile::getData() const {
+    return data;
+}
+
+size_t MemoryMappedFile::getSize() const {
+    return size;
+}
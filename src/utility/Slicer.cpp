@@ -0,0 +1,226 @@
+#include "meshcore/utility/Slicer.h"
+#include "meshcore/optimization/StripPackingSolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <tbb/parallel_for.h>
+
+namespace {
+    using Edge = std::pair<size_t, size_t>; // Vertex indices, smallest first
+
+    struct Segment {
+        Edge start; // Edge crossed where the segment starts
+        Edge end;
+        bool operator<(const Segment& other) const { return start < other.start; }
+    };
+
+    Edge makeEdge(size_t vertexIndexA, size_t vertexIndexB) {
+        return vertexIndexA < vertexIndexB ? Edge(vertexIndexA, vertexIndexB) : Edge(vertexIndexB, vertexIndexA);
+    }
+}
+
+float SliceContour::computeSignedArea() const {
+    float area = 0.0f;
+    for (size_t i = 0; i < points.size(); ++i){
+        const auto& current = points[i];
+        const auto& next = points[(i + 1) % points.size()];
+        area += current.x * next.y - next.x * current.y;
+    }
+    return 0.5f * area;
+}
+
+float SliceLayer::computeArea() const {
+    float area = 0.0f;
+    for (const auto& contour: contours){
+        area += contour.computeSignedArea();
+    }
+    return area;
+}
+
+Slicer::Slicer(const WorldSpaceMesh &worldSpaceMesh): Slicer(std::vector<std::shared_ptr<WorldSpaceMesh>>{std::make_shared<WorldSpaceMesh>(worldSpaceMesh)}) {}
+
+Slicer::Slicer(const StripPackingSolution &solution): Slicer(solution.getItems()) {}
+
+Slicer::Slicer(const std::vector<std::shared_ptr<WorldSpaceMesh>> &worldSpaceMeshes) {
+
+    // Offsets of each mesh in the combined vertices, the triangles are appended with their indices shifted by them
+    std::vector<size_t> vertexOffsets{0};
+    size_t triangleCount = 0;
+    for (const auto& worldSpaceMesh: worldSpaceMeshes){
+        vertexOffsets.push_back(vertexOffsets.back() + worldSpaceMesh->getModelSpaceMesh()->getVertices().size());
+        triangleCount += worldSpaceMesh->getModelSpaceMesh()->getTriangles().size();
+    }
+    vertices.resize(vertexOffsets.back());
+    triangles.reserve(triangleCount);
+    for (size_t meshIndex = 0; meshIndex < worldSpaceMeshes.size(); ++meshIndex){
+        const auto vertexOffset = vertexOffsets[meshIndex];
+        for (const auto& triangle: worldSpaceMeshes[meshIndex]->getModelSpaceMesh()->getTriangles()){
+            triangles.emplace_back(triangle.vertexIndex0 + vertexOffset, triangle.vertexIndex1 + vertexOffset, triangle.vertexIndex2 + vertexOffset);
+        }
+    }
+
+    tbb::parallel_for(size_t(0), worldSpaceMeshes.size(), [&](size_t meshIndex){
+        const auto& modelSpaceMesh = worldSpaceMeshes[meshIndex]->getModelSpaceMesh();
+        const auto matrix = worldSpaceMeshes[meshIndex]->getModelTransformation().getMatrix();
+        const auto vertexOffset = vertexOffsets[meshIndex];
+        for (size_t i = 0; i < modelSpaceMesh->getVertices().size(); ++i){
+            vertices[vertexOffset + i] = matrix * glm::vec4(modelSpaceMesh->getVertices()[i], 1.0f);
+        }
+    });
+
+    Vertex minimum(std::numeric_limits<float>::max());
+    Vertex maximum(-std::numeric_limits<float>::max());
+    for (const auto& vertex: vertices){
+        minimum = glm::min(minimum, vertex);
+        maximum = glm::max(maximum, vertex);
+    }
+    bounds = vertices.empty() ? AABB() : AABB(minimum, maximum);
+}
+
+const AABB &Slicer::getBounds() const {
+    return bounds;
+}
+
+std::vector<SliceLayer> Slicer::slice(float layerHeight) const {
+    if(!(layerHeight > 0.0f)){
+        throw std::invalid_argument("The layer height should be positive");
+    }
+    const auto layerCount = static_cast<size_t>(std::ceil((bounds.getMaximum().z - bounds.getMinimum().z) / layerHeight));
+    std::vector<float> heights(std::max(layerCount, size_t(1)));
+    for (size_t layer = 0; layer < heights.size(); ++layer){
+        heights[layer] = bounds.getMinimum().z + (static_cast<float>(layer) + 0.5f) * layerHeight;
+    }
+    return slice(heights);
+}
+
+SliceLayer Slicer::sliceAt(float height) const {
+    return slice(std::vector<float>{height}).front();
+}
+
+std::vector<SliceLayer> Slicer::slice(const std::vector<float> &heights) const {
+    if(!std::is_sorted(heights.begin(), heights.end())){
+        throw std::invalid_argument("The heights of the slicing planes should be in ascending order");
+    }
+
+    // A triangle crosses the planes at heights in (minimum z, maximum z] of its vertices, bin them per layer
+    std::vector<std::pair<size_t, size_t>> layerRanges(triangles.size());
+    std::vector<size_t> layerOffsets(heights.size() + 1, 0);
+    for (size_t triangleIndex = 0; triangleIndex < triangles.size(); ++triangleIndex){
+        const auto& triangle = triangles[triangleIndex];
+        const auto z0 = vertices[triangle.vertexIndex0].z;
+        const auto z1 = vertices[triangle.vertexIndex1].z;
+        const auto z2 = vertices[triangle.vertexIndex2].z;
+        const auto first = std::upper_bound(heights.begin(), heights.end(), std::min(z0, std::min(z1, z2))) - heights.begin();
+        const auto last = std::upper_bound(heights.begin() + first, heights.end(), std::max(z0, std::max(z1, z2))) - heights.begin();
+        layerRanges[triangleIndex] = {first, last};
+        for (auto layer = first; layer < last; ++layer){
+            layerOffsets[layer + 1]++;
+        }
+    }
+    for (size_t layer = 0; layer < heights.size(); ++layer){
+        layerOffsets[layer + 1] += layerOffsets[layer];
+    }
+    std::vector<size_t> layerTriangles(layerOffsets.back());
+    {
+        auto insertPositions = layerOffsets;
+        for (size_t triangleIndex = 0; triangleIndex < triangles.size(); ++triangleIndex){
+            for (auto layer = layerRanges[triangleIndex].first; layer < layerRanges[triangleIndex].second; ++layer){
+                layerTriangles[insertPositions[layer]++] = triangleIndex;
+            }
+        }
+    }
+
+    std::vector<SliceLayer> layers(heights.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, heights.size()), [&](const tbb::blocked_range<size_t>& range){
+        std::vector<Segment> segments;
+        std::vector<Edge> ends;
+        std::vector<size_t> order; // Segments to start contours from
+        std::vector<bool> visited;
+        for (auto layer = range.begin(); layer < range.end(); ++layer){
+            const auto height = heights[layer];
+            layers[layer].height = height;
+
+            // One segment per triangle, from the edge leaving the half-space above the plane to the edge entering it,
+            // which runs counter-clockwise around the solid when seen from above
+            segments.clear();
+            for (auto index = layerOffsets[layer]; index < layerOffsets[layer + 1]; ++index){
+                const auto& triangle = triangles[layerTriangles[index]];
+                const size_t triangleVertices[3] = {triangle.vertexIndex0, triangle.vertexIndex1, triangle.vertexIndex2};
+                Segment segment{};
+                for (int i = 0; i < 3; ++i){
+                    const auto from = triangleVertices[i];
+                    const auto to = triangleVertices[(i + 1) % 3];
+                    const auto fromAbove = vertices[from].z >= height;
+                    const auto toAbove = vertices[to].z >= height;
+                    if(fromAbove && !toAbove){
+                        segment.start = makeEdge(from, to);
+                    }
+                    else if(!fromAbove && toAbove){
+                        segment.end = makeEdge(from, to);
+                    }
+                }
+                segments.push_back(segment);
+            }
+            std::sort(segments.begin(), segments.end());
+
+            // Open chains start at an edge no other segment ends at, trace them before the closed loops
+            ends.clear();
+            for (const auto& segment: segments){
+                ends.push_back(segment.end);
+            }
+            std::sort(ends.begin(), ends.end());
+            order.clear();
+            for (size_t i = 0; i < segments.size(); ++i){
+                if(!std::binary_search(ends.begin(), ends.end(), segments[i].start)){
+                    order.push_back(i);
+                }
+            }
+            const auto openChainCount = order.size();
+            for (size_t i = 0; i < segments.size(); ++i){
+                order.push_back(i);
+            }
+
+            const auto computePoint = [&](const Edge& edge){
+                const auto& a = vertices[edge.first];
+                const auto& b = vertices[edge.second];
+                const auto t = (height - a.z) / (b.z - a.z);
+                return glm::vec2(a.x + t * (b.x - a.x), a.y + t * (b.y - a.y));
+            };
+
+            visited.assign(segments.size(), false);
+            auto& contours = layers[layer].contours;
+            for (size_t orderIndex = 0; orderIndex < order.size(); ++orderIndex){
+                auto segmentIndex = order[orderIndex];
+                if(visited[segmentIndex]){
+                    continue;
+                }
+                SliceContour contour;
+                const auto firstEdge = segments[segmentIndex].start;
+                Edge lastEdge = firstEdge;
+                while (true){
+                    visited[segmentIndex] = true;
+                    contour.points.push_back(computePoint(segments[segmentIndex].start));
+                    lastEdge = segments[segmentIndex].end;
+
+                    // Continue with an unvisited segment starting where this one ends
+                    auto next = std::lower_bound(segments.begin(), segments.end(), Segment{lastEdge, {}});
+                    while (next != segments.end() && next->start == lastEdge && visited[next - segments.begin()]){
+                        ++next;
+                    }
+                    if(next == segments.end() || next->start != lastEdge){
+                        break;
+                    }
+                    segmentIndex = next - segments.begin();
+                }
+                contour.closed = orderIndex >= openChainCount && lastEdge == firstEdge;
+                if(!contour.closed){
+                    contour.points.push_back(computePoint(lastEdge));
+                }
+                contours.push_back(std::move(contour));
+            }
+        }
+    });
+    return layers;
+}
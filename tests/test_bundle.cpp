@@ -0,0 +1,82 @@
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "meshcore/acceleration/BoundingVolumeHierarchy.h"
+#include "meshcore/acceleration/CachingBoundsTreeFactory.h"
+#include "meshcore/optimization/StripPackingProblem.h"
+
+TEST(Bundle, SaveAndLoad) {
+
+    std::vector<Vertex> cubeVertices = {Vertex(0,0,0), Vertex(1,0,0), Vertex(0,1,0), Vertex(1,1,0),
+                                        Vertex(0,0,1), Vertex(1,0,1), Vertex(0,1,1), Vertex(1,1,1)};
+    auto cube = ModelSpaceMesh(cubeVertices).getConvexHull();
+    cube->setName("cube.obj");
+
+    std::vector<Vertex> tetrahedronVertices = {Vertex(0,0,0), Vertex(2,0,0), Vertex(0,2,0), Vertex(0,0,2)};
+    auto tetrahedron = ModelSpaceMesh(tetrahedronVertices).getConvexHull();
+    tetrahedron->setName("tetrahedron.obj");
+
+    StripPackingProblem problem("bundle/test.json", "Bundle test", AABB(Vertex(0,0,0), Vertex(4,4,10)),
+                                {cube, tetrahedron}, {3, 5}, ObjectOrigin::AlignToMinimum);
+
+    const auto bundlePath = (std::filesystem::temp_directory_path() / "meshcore_test_bundle.bin").string();
+    problem.saveBundle(bundlePath);
+    auto loaded = StripPackingProblem::loadBundle(bundlePath);
+    std::filesystem::remove(bundlePath);
+
+    EXPECT_EQ(loaded->getName(), problem.getName());
+    EXPECT_EQ(loaded->getInstancePath(), problem.getInstancePath());
+    EXPECT_EQ(loaded->getItemOrigin(), problem.getItemOrigin());
+    EXPECT_EQ(loaded->getContainer().getMinimum(), problem.getContainer().getMinimum());
+    EXPECT_EQ(loaded->getContainer().getMaximum(), problem.getContainer().getMaximum());
+    EXPECT_EQ(loaded->getRequiredItemCounts(), problem.getRequiredItemCounts());
+    ASSERT_EQ(loaded->getRequiredItems().size(), problem.getRequiredItems().size());
+
+    for (size_t i = 0; i < problem.getRequiredItems().size(); ++i){
+        const auto& original = problem.getRequiredItems()[i];
+        const auto& restored = loaded->getRequiredItems()[i];
+
+        EXPECT_EQ(restored->getName(), original->getName());
+        EXPECT_EQ(restored->getVertices(), original->getVertices());
+        EXPECT_EQ(restored->getTriangles().size(), original->getTriangles().size());
+        EXPECT_EQ(restored->getConvexHull()->getVertices(), original->getConvexHull()->getVertices());
+        EXPECT_FLOAT_EQ(restored->getVolume(), original->getVolume());
+        EXPECT_EQ(restored->getVolumeCentroid(), original->getVolumeCentroid());
+        EXPECT_EQ(restored->getBounds().getMinimum(), original->getBounds().getMinimum());
+        EXPECT_EQ(restored->getBounds().getMaximum(), original->getBounds().getMaximum());
+
+        const auto originalTree = CachingBoundsTreeFactory<BoundingVolumeHierarchy>::getBoundsTree(original);
+        const auto restoredTree = CachingBoundsTreeFactory<BoundingVolumeHierarchy>::getBoundsTree(restored);
+        ASSERT_EQ(restoredTree->getNodes().size(), originalTree->getNodes().size());
+        ASSERT_EQ(restoredTree->getTriangles().size(), originalTree->getTriangles().size());
+        for (size_t n = 0; n < originalTree->getNodes().size(); ++n){
+            EXPECT_EQ(restoredTree->getNodes()[n].bounds.getMinimum(), originalTree->getNodes()[n].bounds.getMinimum());
+            EXPECT_EQ(restoredTree->getNodes()[n].firstChildOrTriangleIndex, originalTree->getNodes()[n].firstChildOrTriangleIndex);
+            EXPECT_EQ(restoredTree->getNodes()[n].split, originalTree->getNodes()[n].split);
+        }
+    }
+}
+
+TEST(Bundle, RejectsInvalidFile) {
+    const auto bundlePath = (std::filesystem::temp_directory_path() / "meshcore_invalid_bundle.bin").string();
+    {
+        std::ofstream stream(bundlePath, std::ios::binary);
+        stream << "definitely not a bundle, but long enough to hold a header of some size........................................................................................................";
+    }
+    EXPECT_THROW(StripPackingProblem::loadBundle(bundlePath), std::runtime_error);
+    std::filesystem::remove(bundlePath);
+}
+
+TEST(Bundle, RejectsTruncatedFile) {
+    std::vector<Vertex> cubeVertices = {Vertex(0,0,0), Vertex(1,0,0), Vertex(0,1,0), Vertex(1,1,0),
+                                        Vertex(0,0,1), Vertex(1,0,1), Vertex(0,1,1), Vertex(1,1,1)};
+    StripPackingProblem problem("bundle/test.json", "Bundle test", AABB(Vertex(0,0,0), Vertex(4,4,10)),
+                                {ModelSpaceMesh(cubeVertices).getConvexHull()}, {1}, ObjectOrigin::AlignToMinimum);
+
+    const auto bundlePath = (std::filesystem::temp_directory_path() / "meshcore_truncated_bundle.bin").string();
+    problem.saveBundle(bundlePath);
+    std::filesystem::resize_file(bundlePath, std::filesystem::file_size(bundlePath) / 2);
+    EXPECT_THROW(StripPackingProblem::loadBundle(bundlePath), std::runtime_error);
+    std::filesystem::remove(bundlePath);
+}
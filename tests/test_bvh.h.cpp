@@ -9,6 +9,7 @@
 #include "meshcore/acceleration/BoundingVolumeHierarchy.h"
 #include "meshcore/acceleration/CachingBoundsTreeFactory.h"
 #include "meshcore/core/WorldSpaceMesh.h"
+#include "meshcore/geometric/Intersection.h"
 #include "meshcore/utility/FileParser.h"
 #include "meshcore/utility/random.h"
 
@@ -100,4 +101,166 @@ TEST(BVH, RandomWalk) {
             }
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(BVH, TranslatedDualTraversal) {
+
+    // Two wavy height fields, which give deep trees and many near misses
+    const auto createHeightField = [](int resolution, float frequency){
+        std::vector<Vertex> vertices;
+        std::vector<IndexTriangle> triangles;
+        for (int row = 0; row <= resolution; ++row){
+            for (int column = 0; column <= resolution; ++column){
+                const auto x = static_cast<float>(column) / resolution;
+                const auto y = static_cast<float>(row) / resolution;
+                vertices.emplace_back(x, y, 0.2f * std::sin(frequency * x) * std::cos(frequency * y));
+            }
+        }
+        for (int row = 0; row < resolution; ++row){
+            for (int column = 0; column < resolution; ++column){
+                const auto index = static_cast<unsigned int>(row * (resolution + 1) + column);
+                triangles.emplace_back(index, index + 1, index + resolution + 1);
+                triangles.emplace_back(index + 1, index + resolution + 2, index + resolution + 1);
+            }
+        }
+        return std::make_shared<ModelSpaceMesh>(vertices, triangles);
+    };
+    const auto first = createHeightField(10, 7.0f);
+    const auto second = createHeightField(8, 11.0f);
+    const BoundingVolumeHierarchy firstTree(first);
+    const BoundingVolumeHierarchy secondTree(second);
+
+    Random random(3);
+    int intersecting = 0;
+    for (int sample = 0; sample < 50; ++sample){
+        const glm::vec3 translation(random.nextFloat(-1.0f, 1.0f), random.nextFloat(-1.0f, 1.0f), random.nextFloat(-0.4f, 0.4f));
+
+        bool expected = false;
+        for (const auto& firstTriangle: firstTree.getTriangles()){
+            for (const auto& secondTriangle: secondTree.getTriangles()){
+                if(Intersection::intersect(secondTriangle.getTranslated(translation), firstTriangle)){
+                    expected = true;
+                    break;
+                }
+            }
+            if(expected){
+                break;
+            }
+        }
+        EXPECT_EQ(firstTree.intersectsTranslated(secondTree, translation), expected);
+        EXPECT_EQ(secondTree.intersectsTranslated(firstTree, -translation), expected);
+        intersecting += expected;
+    }
+    EXPECT_GT(intersecting, 0);
+    EXPECT_LT(intersecting, 50);
+}
+
+TEST(BVH, RayQueries) {
+
+    // Wavy height field, hit from above by a coherent grid of parallel rays and by random rays
+    std::vector<Vertex> vertices;
+    std::vector<IndexTriangle> triangles;
+    constexpr int resolution = 30;
+    for (int row = 0; row <= resolution; ++row){
+        for (int column = 0; column <= resolution; ++column){
+            const auto x = static_cast<float>(column) / resolution;
+            const auto y = static_cast<float>(row) / resolution;
+            vertices.emplace_back(x, y, 0.2f * std::sin(9.0f * x) * std::cos(9.0f * y));
+        }
+    }
+    for (int row = 0; row < resolution; ++row){
+        for (int column = 0; column < resolution; ++column){
+            const auto index = static_cast<unsigned int>(row * (resolution + 1) + column);
+            triangles.emplace_back(index, index + 1, index + resolution + 1);
+            triangles.emplace_back(index + 1, index + resolution + 2, index + resolution + 1);
+        }
+    }
+    const BoundingVolumeHierarchy tree(std::make_shared<ModelSpaceMesh>(vertices, triangles));
+
+    Random random(7);
+    std::vector<Ray> rays;
+    for (int row = 0; row < 20; ++row){
+        for (int column = 0; column < 21; ++column){
+            rays.emplace_back(Vertex(-0.05f + 0.055f * column, -0.05f + 0.055f * row, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+        }
+    }
+    for (int sample = 0; sample < 200; ++sample){
+        rays.emplace_back(Vertex(random.nextFloat(-0.5f, 1.5f), random.nextFloat(-0.5f, 1.5f), random.nextFloat(-0.5f, 0.5f)),
+                          glm::vec3(random.nextFloat(-1.0f, 1.0f), random.nextFloat(-1.0f, 1.0f), random.nextFloat(-1.0f, 1.0f)));
+    }
+
+    std::vector<std::optional<BoundingVolumeHierarchy::RayHit>> packetHits;
+    tree.queryClosestHits(rays, packetHits);
+    ASSERT_EQ(packetHits.size(), rays.size());
+
+    int hitCount = 0;
+    for (size_t rayIndex = 0; rayIndex < rays.size(); ++rayIndex){
+        const auto& ray = rays[rayIndex];
+        auto expected = std::numeric_limits<float>::max();
+        for (const auto& triangle: tree.getTriangles()){
+            if(const auto t = Intersection::intersectionDistance(ray, triangle); t > 0){
+                expected = std::min(expected, t);
+            }
+        }
+
+        const auto hit = tree.queryClosestHit(ray);
+        ASSERT_EQ(hit.has_value(), expected < std::numeric_limits<float>::max());
+        ASSERT_EQ(packetHits[rayIndex].has_value(), hit.has_value());
+        EXPECT_EQ(tree.isOccluded(ray), hit.has_value());
+        if(!hit){
+            continue;
+        }
+        hitCount++;
+        EXPECT_NEAR(hit->distance, expected, 1e-5f);
+        EXPECT_EQ(packetHits[rayIndex]->distance, hit->distance);
+        EXPECT_EQ(packetHits[rayIndex]->triangleIndex, hit->triangleIndex);
+
+        // The barycentric coordinates give the same point as the distance along the ray
+        const auto& triangle = tree.getTriangles()[hit->triangleIndex];
+        const auto point = triangle.vertices[0] + hit->barycentricCoordinates.x * (triangle.vertices[1] - triangle.vertices[0]) + hit->barycentricCoordinates.y * (triangle.vertices[2] - triangle.vertices[0]);
+        EXPECT_LT(glm::length(point - (ray.origin + hit->distance * ray.direction)), 1e-5f);
+
+        // Limited to a shorter distance, the hit is culled
+        EXPECT_FALSE(tree.queryClosestHit(ray, 0.99f * hit->distance).has_value());
+        EXPECT_FALSE(tree.isOccluded(ray, 0.99f * hit->distance));
+    }
+    EXPECT_GT(hitCount, 19 * 19); // All grid rays above the field and some random ones
+    EXPECT_LT(hitCount, static_cast<int>(rays.size()));
+}
+
+TEST(BVH, ClosestPointBatch) {
+
+    // Points around a sphere-like hull, including points on its surface
+    std::vector<Vertex> hullVertices;
+    Random random(13);
+    for (int i = 0; i < 200; ++i){
+        hullVertices.push_back(glm::normalize(glm::vec3(random.nextFloat(-1.0f, 1.0f), random.nextFloat(-1.0f, 1.0f), random.nextFloat(-1.0f, 1.0f))));
+    }
+    const auto mesh = ModelSpaceMesh(hullVertices).getConvexHull();
+    const BoundingVolumeHierarchy tree(mesh);
+
+    std::vector<Vertex> points;
+    for (int i = 0; i < 3000; ++i){
+        points.emplace_back(random.nextFloat(-1.5f, 1.5f), random.nextFloat(-1.5f, 1.5f), random.nextFloat(-1.5f, 1.5f));
+    }
+    points.insert(points.end(), mesh->getVertices().begin(), mesh->getVertices().end());
+
+    std::vector<BoundingVolumeHierarchy::ClosestPointQueryResult> results;
+    tree.queryClosestPoints(points, results);
+    ASSERT_EQ(results.size(), points.size());
+    for (size_t pointIndex = 0; pointIndex < points.size(); ++pointIndex){
+        const auto& point = points[pointIndex];
+        const auto& result = results[pointIndex];
+        EXPECT_NEAR(result.distanceSquared, tree.getShortestDistanceSquared(point), 1e-6f);
+        ASSERT_LT(result.triangleIndex, tree.getTriangles().size());
+        const auto closestPoint = tree.getTriangles()[result.triangleIndex].getClosestPoint(point);
+        EXPECT_LT(glm::length(closestPoint - result.closestPoint), 1e-5f);
+        EXPECT_NEAR(glm::dot(point - result.closestPoint, point - result.closestPoint), result.distanceSquared, 1e-6f);
+    }
+    for (size_t vertexIndex = 3000; vertexIndex < points.size(); ++vertexIndex){
+        EXPECT_NEAR(results[vertexIndex].distanceSquared, 0.0f, 1e-10f);
+    }
+
+    tree.queryClosestPoints({}, results);
+    EXPECT_TRUE(results.empty());
+}
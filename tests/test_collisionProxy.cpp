@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include "meshcore/geometric/CollisionProxy.h"
+#include "meshcore/geometric/Intersection.h"
+#include "meshcore/acceleration/BoundingVolumeHierarchy.h"
+#include "meshcore/core/WorldSpaceMesh.h"
+#include "meshcore/optimization/StripPackingSolution.h"
+#include "meshcore/utility/random.h"
+
+namespace {
+
+    /** Closed torus around the z-axis, with a major radius of 1 **/
+    std::shared_ptr<ModelSpaceMesh> createTorus(float minorRadius, int majorSegments, int minorSegments) {
+        std::vector<Vertex> vertices;
+        for (int i = 0; i < majorSegments; ++i){
+            const auto u = 2.0f * glm::pi<float>() * static_cast<float>(i) / majorSegments;
+            for (int j = 0; j < minorSegments; ++j){
+                const auto v = 2.0f * glm::pi<float>() * static_cast<float>(j) / minorSegments;
+                const auto radius = 1.0f + minorRadius * std::cos(v);
+                vertices.emplace_back(radius * std::cos(u), radius * std::sin(u), minorRadius * std::sin(v));
+            }
+        }
+        std::vector<IndexTriangle> triangles;
+        for (int i = 0; i < majorSegments; ++i){
+            for (int j = 0; j < minorSegments; ++j){
+                const auto a = i * minorSegments + j;
+                const auto b = ((i + 1) % majorSegments) * minorSegments + j;
+                const auto c = ((i + 1) % majorSegments) * minorSegments + (j + 1) % minorSegments;
+                const auto d = i * minorSegments + (j + 1) % minorSegments;
+                triangles.emplace_back(a, b, c);
+                triangles.emplace_back(a, c, d);
+            }
+        }
+        return std::make_shared<ModelSpaceMesh>(vertices, triangles);
+    }
+
+    void expectEnclosed(const CollisionProxy& proxy, const ModelSpaceMesh& mesh) {
+        const BoundingVolumeHierarchy tree(proxy.getMesh());
+        for (const auto& vertex: mesh.getVertices()){
+            EXPECT_TRUE(tree.containsPoint(vertex));
+        }
+        for (const auto& triangle: mesh.getTriangles()){
+            EXPECT_FALSE(tree.intersectsTriangle(VertexTriangle(mesh.getVertices()[triangle.vertexIndex0], mesh.getVertices()[triangle.vertexIndex1], mesh.getVertices()[triangle.vertexIndex2])));
+        }
+    }
+}
+
+TEST(CollisionProxy, Construction) {
+    const auto torus = createTorus(0.3f, 96, 48);
+    const auto& proxy = torus->getCollisionProxy();
+    ASSERT_NE(proxy, nullptr);
+    EXPECT_TRUE(proxy->isSimplified());
+    EXPECT_LE(proxy->getMesh()->getTriangles().size(), CollisionProxyParameters().targetTriangles);
+    EXPECT_GT(proxy->getInflation(), 0.0f);
+    EXPECT_LT(proxy->getInflation(), 0.05f);
+    EXPECT_GE(proxy->getMesh()->getVolume(), torus->getVolume());
+    expectEnclosed(*proxy, *torus);
+
+    // The torus' hole is preserved
+    const auto hole = std::make_shared<ModelSpaceMesh>(std::vector<Vertex>{Vertex(-0.1f,-0.1f,-0.1f), Vertex(0.1f,-0.1f,-0.1f), Vertex(0,0.1f,-0.1f), Vertex(0,0,0.1f)}, std::vector<IndexTriangle>{{0,2,1}, {0,1,3}, {1,2,3}, {2,0,3}});
+    EXPECT_FALSE(Intersection::intersectProxyFirst(WorldSpaceMesh(torus), WorldSpaceMesh(hole)));
+
+    // Small meshes are their own proxy
+    EXPECT_FALSE(hole->getCollisionProxy()->isSimplified());
+    EXPECT_EQ(hole->getCollisionProxy()->getMesh()->getTriangles().size(), 4);
+
+    // Open meshes are enclosed by a simplification of their convex hull
+    auto triangles = torus->getTriangles();
+    triangles.pop_back();
+    const ModelSpaceMesh openTorus(torus->getVertices(), triangles);
+    const CollisionProxy openProxy(openTorus);
+    EXPECT_LE(openProxy.getMesh()->getTriangles().size(), CollisionProxyParameters().targetTriangles);
+    expectEnclosed(openProxy, openTorus);
+}
+
+TEST(CollisionProxy, ProxyFirstIntersection) {
+    const auto torus = createTorus(0.3f, 96, 48);
+    const auto thinTorus = createTorus(0.1f, 64, 24);
+    WorldSpaceMesh first(torus);
+    WorldSpaceMesh second(thinTorus);
+
+    CollisionProxyStatistics statistics;
+    Random random(3);
+    const int samples = 200;
+    int intersecting = 0;
+    for (int sample = 0; sample < samples; ++sample){
+        Transformation transformation;
+        transformation.setPosition(glm::vec3(random.nextFloat(-2.0f, 2.0f), random.nextFloat(-2.0f, 2.0f), random.nextFloat(-1.0f, 1.0f)));
+        transformation.setRotation(Quaternion(random.nextFloat(0.0f, 6.28f), random.nextFloat(0.0f, 6.28f), random.nextFloat(0.0f, 6.28f)));
+        second.setModelTransformation(transformation);
+
+        const auto expected = Intersection::intersect(first, second);
+        EXPECT_EQ(Intersection::intersectProxyFirst(first, second, &statistics), expected);
+        intersecting += expected;
+    }
+    EXPECT_GT(intersecting, 0);
+    EXPECT_LT(intersecting, samples);
+
+    EXPECT_GT(statistics.boundsRejections, 0);
+    EXPECT_EQ(statistics.boundsRejections + statistics.proxyTests, samples);
+    EXPECT_EQ(statistics.rejections + statistics.fullTests, statistics.proxyTests);
+    EXPECT_GT(statistics.rejections, 0);
+    EXPECT_LE(statistics.fullTests, static_cast<size_t>(intersecting) + samples / 4); // Near misses need the full test
+    EXPECT_NEAR(statistics.getRejectionRate(), static_cast<float>(statistics.rejections) / static_cast<float>(statistics.proxyTests), 1e-6f);
+    statistics.reset();
+    EXPECT_EQ(statistics.boundsRejections, 0);
+    EXPECT_EQ(statistics.proxyTests, 0);
+}
+
+TEST(CollisionProxy, SolutionFeasibility) {
+    auto problem = std::make_shared<StripPackingProblem>("", "Collision proxy test", AABB(Vertex(-2,-2,-1), Vertex(4,4,20)),
+                                                         std::vector<std::shared_ptr<ModelSpaceMesh>>{createTorus(0.3f, 64, 32), createTorus(0.1f, 48, 16)},
+                                                         std::vector<size_t>{2, 2}, ObjectOrigin::AlignToCenter);
+    StripPackingSolution plain(problem);
+    StripPackingSolution proxied(problem);
+    proxied.setUseCollisionProxies(true);
+    EXPECT_FALSE(plain.isUsingCollisionProxies());
+    EXPECT_TRUE(std::static_pointer_cast<StripPackingSolution>(proxied.clone())->isUsingCollisionProxies());
+
+    // The statistics are optional, the proxies are used without them
+    Random random(11);
+    const int samples = 30;
+    int feasible = 0;
+    for (int sample = 0; sample < samples; ++sample){
+        if(sample == samples / 2){
+            proxied.setCollisionProxyStatistics(std::make_shared<CollisionProxyStatistics>());
+        }
+        for (size_t itemIndex = 0; itemIndex < plain.getNumberOfItems(); ++itemIndex){
+            Transformation transformation;
+            transformation.setPosition(glm::vec3(1.0f + random.nextFloat(), 1.0f + random.nextFloat(), 1.0f + 1.5f * itemIndex * random.nextFloat()));
+            transformation.setRotation(Quaternion(random.nextFloat(0.0f, 6.28f), random.nextFloat(0.0f, 6.28f), random.nextFloat(0.0f, 6.28f)));
+            plain.setItemTransformation(itemIndex, transformation);
+            proxied.setItemTransformation(itemIndex, transformation);
+        }
+        const auto expected = plain.isFeasible();
+        EXPECT_EQ(proxied.isFeasible(), expected);
+        feasible += expected;
+    }
+    EXPECT_LT(feasible, samples);
+    ASSERT_NE(proxied.getCollisionProxyStatistics(), nullptr);
+    EXPECT_GT(proxied.getCollisionProxyStatistics()->proxyTests, 0);
+}
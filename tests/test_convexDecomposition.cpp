@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include "meshcore/geometric/ConvexDecomposition.h"
+#include "meshcore/geometric/Distance.h"
+#include "meshcore/geometric/Intersection.h"
+#include "meshcore/core/WorldSpaceMesh.h"
+#include "meshcore/utility/random.h"
+
+namespace {
+
+    /** L-shaped prism, the footprint is the square [0,2]x[0,2] without the quadrant [1,2]x[1,2] **/
+    std::shared_ptr<ModelSpaceMesh> createLShape() {
+        const std::vector<glm::vec2> footprint = {{0,0}, {2,0}, {2,1}, {1,1}, {1,2}, {0,2}};
+        const auto count = footprint.size();
+        std::vector<Vertex> vertices;
+        for (const auto z: {0.0f, 1.0f}){
+            for (const auto& point: footprint){
+                vertices.emplace_back(point.x, point.y, z);
+            }
+        }
+        std::vector<IndexTriangle> triangles;
+        for (size_t i = 1; i + 1 < count; ++i){
+            triangles.emplace_back(0, i + 1, i); // Bottom, facing down
+            triangles.emplace_back(count, count + i, count + i + 1); // Top, facing up
+        }
+        for (size_t i = 0; i < count; ++i){
+            const auto next = (i + 1) % count;
+            triangles.emplace_back(i, next, count + next);
+            triangles.emplace_back(i, count + next, count + i);
+        }
+        return std::make_shared<ModelSpaceMesh>(vertices, triangles);
+    }
+
+    std::shared_ptr<ModelSpaceMesh> createCube(float size) {
+        std::vector<Vertex> vertices = {Vertex(0,0,0), Vertex(size,0,0), Vertex(0,size,0), Vertex(size,size,0),
+                                        Vertex(0,0,size), Vertex(size,0,size), Vertex(0,size,size), Vertex(size,size,size)};
+        return ModelSpaceMesh(vertices).getConvexHull();
+    }
+
+    bool isInsideHull(const ModelSpaceMesh& hull, const Vertex& point, float tolerance) {
+        for (const auto& triangle: hull.getTriangles()){
+            const auto& v0 = hull.getVertices()[triangle.vertexIndex0];
+            const auto normal = glm::normalize(glm::cross(hull.getVertices()[triangle.vertexIndex1] - v0, hull.getVertices()[triangle.vertexIndex2] - v0));
+            if(glm::dot(normal, point - v0) > tolerance){
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST(ConvexDecomposition, LShape) {
+    const auto lShape = createLShape();
+    ASSERT_FALSE(lShape->isConvex());
+    ASSERT_NEAR(lShape->getVolume(), 3.0f, 1e-4f);
+
+    const auto& decomposition = lShape->getConvexDecomposition();
+    EXPECT_GE(decomposition->getPieces().size(), 2);
+    EXPECT_LE(decomposition->getConcavity(), ConvexDecompositionParameters().concavityTolerance);
+
+    // The pieces enclose the mesh and don't add much volume
+    float totalVolume = 0.0f;
+    for (const auto& piece: decomposition->getPieces()){
+        totalVolume += piece->getVolume();
+    }
+    EXPECT_NEAR(totalVolume, 3.0f, 0.15f);
+    for (const auto& vertex: lShape->getVertices()){
+        bool enclosed = false;
+        for (const auto& piece: decomposition->getPieces()){
+            enclosed |= isInsideHull(*piece, vertex, 1e-4f);
+        }
+        EXPECT_TRUE(enclosed);
+    }
+
+    // Convex meshes are their own decomposition
+    const auto cube = createCube(1.0f);
+    EXPECT_EQ(cube->getConvexDecomposition()->getPieces().size(), 1);
+    EXPECT_EQ(cube->getConvexDecomposition()->getNodes().size(), 1);
+}
+
+TEST(ConvexDecomposition, Tolerance) {
+    const auto lShape = createLShape();
+    ConvexDecompositionParameters coarse;
+    coarse.concavityTolerance = 1.0f;
+    ConvexDecompositionParameters fine;
+    fine.concavityTolerance = 1e-3f;
+    fine.maximumPieces = 64;
+    const ConvexDecomposition coarseDecomposition(*lShape, coarse);
+    const ConvexDecomposition fineDecomposition(*lShape, fine);
+    EXPECT_EQ(coarseDecomposition.getPieces().size(), 1);
+    EXPECT_GE(fineDecomposition.getPieces().size(), 2);
+    EXPECT_LE(fineDecomposition.getPieces().size(), 64);
+
+    // A decomposition with custom parameters can be cached in the mesh
+    lShape->setPrecomputedConvexDecomposition(std::make_shared<ConvexDecomposition>(*lShape, coarse));
+    EXPECT_EQ(lShape->getConvexDecomposition()->getPieces().size(), 1);
+}
+
+TEST(ConvexDecomposition, CollisionAndDistance) {
+    WorldSpaceMesh lShape(createLShape());
+    WorldSpaceMesh cube(createCube(0.8f));
+
+    // In the notch of the L, inside its convex hull but not touching the L itself
+    Transformation transformation;
+    transformation.setPosition(glm::vec3(1.1f, 1.1f, 0.1f));
+    cube.setModelTransformation(transformation);
+    EXPECT_FALSE(Intersection::intersect(lShape, cube));
+    EXPECT_FALSE(Intersection::intersectConvexDecompositions(lShape, cube));
+    EXPECT_NEAR(Distance::distanceConvexDecompositions(lShape, cube), 0.1f, 1e-3f);
+
+    // The decompositions enclose the meshes, so intersections are never missed and distances are lower bounds
+    Random random(5);
+    int intersecting = 0;
+    for (int sample = 0; sample < 200; ++sample){
+        transformation.setPosition(glm::vec3(random.nextFloat(-1.0f, 2.5f), random.nextFloat(-1.0f, 2.5f), random.nextFloat(-1.0f, 1.5f)));
+        transformation.setRotation(Quaternion(random.nextFloat(0.0f, 6.28f), random.nextFloat(0.0f, 6.28f), random.nextFloat(0.0f, 6.28f)));
+        cube.setModelTransformation(transformation);
+
+        const auto exact = Intersection::intersect(lShape, cube);
+        const auto approximate = Intersection::intersectConvexDecompositions(lShape, cube);
+        EXPECT_TRUE(approximate || !exact);
+        EXPECT_EQ(Intersection::intersectConvexDecompositions(cube, lShape), approximate);
+        if(!exact){
+            EXPECT_LE(Distance::distanceConvexDecompositions(lShape, cube), Distance::distance(lShape, cube) + 1e-3f);
+        }
+        intersecting += exact;
+    }
+    EXPECT_GT(intersecting, 0);
+    EXPECT_LT(intersecting, 200);
+}
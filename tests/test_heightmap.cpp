@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include "meshcore/acceleration/Heightmap.h"
+#include "meshcore/core/WorldSpaceMesh.h"
+#include "meshcore/geometric/Intersection.h"
+#include "meshcore/optimization/StripPackingSolution.h"
+#include "meshcore/utility/random.h"
+
+namespace {
+    std::shared_ptr<ModelSpaceMesh> createCube() {
+        std::vector<Vertex> vertices = {Vertex(0,0,0), Vertex(1,0,0), Vertex(0,1,0), Vertex(1,1,0),
+                                        Vertex(0,0,1), Vertex(1,0,1), Vertex(0,1,1), Vertex(1,1,1)};
+        return ModelSpaceMesh(vertices).getConvexHull();
+    }
+
+    std::shared_ptr<ModelSpaceMesh> createTetrahedron() {
+        std::vector<Vertex> vertices = {Vertex(0,0,0), Vertex(1,0,0), Vertex(0,1,0), Vertex(0,0,1)};
+        return ModelSpaceMesh(vertices).getConvexHull();
+    }
+}
+
+TEST(Heightmap, StackedCubes) {
+    const auto cube = createCube();
+    Heightmap heightmap(AABB(Vertex(0,0,0), Vertex(4,4,10)), 0.25f);
+    const auto& depthMap = heightmap.getDepthMap(cube, Quaternion());
+    EXPECT_FLOAT_EQ(heightmap.computeLowestPlacement(*depthMap, 0.0f, 0.0f), 0.0f);
+
+    Transformation transformation;
+    transformation.setPosition(glm::vec3(1.0f, 1.0f, 0.0f));
+    heightmap.setItem(0, cube, transformation);
+    EXPECT_NEAR(heightmap.computeLowestPlacement(*depthMap, 1.5f, 1.5f), 1.0f, 1e-5f);
+    EXPECT_NEAR(heightmap.computeLowestPlacement(*depthMap, 3.0f, 3.0f), 0.0f, 1e-5f);
+
+    // Moving the cube only updates the cells it covered before and after
+    transformation.setPosition(glm::vec3(2.0f, 2.0f, 0.5f));
+    heightmap.setItem(0, cube, transformation);
+    EXPECT_NEAR(heightmap.computeLowestPlacement(*depthMap, 0.0f, 0.0f), 0.0f, 1e-5f);
+    EXPECT_NEAR(heightmap.computeLowestPlacement(*depthMap, 2.5f, 2.5f), 1.5f, 1e-5f);
+
+    heightmap.removeItem(0);
+    EXPECT_NEAR(heightmap.computeLowestPlacement(*depthMap, 2.5f, 2.5f), 0.0f, 1e-5f);
+}
+
+TEST(Heightmap, ConservativePlacement) {
+    const auto tetrahedron = createTetrahedron();
+    const AABB container(Vertex(0,0,0), Vertex(3,3,20));
+    Heightmap heightmap(container, 0.1f);
+    const Random random(0);
+
+    // Items dropped onto the heightmap never intersect the items placed before them
+    std::vector<WorldSpaceMesh> placedItems;
+    for (size_t itemIndex = 0; itemIndex < 30; ++itemIndex){
+        const Quaternion rotation(random.nextFloat(0.0f, 6.28f), random.nextFloat(0.0f, 6.28f), random.nextFloat(0.0f, 6.28f));
+        const auto& depthMap = heightmap.getDepthMap(tetrahedron, rotation);
+        const auto extent = depthMap->getBounds().getMaximum() - depthMap->getBounds().getMinimum();
+        const auto x = random.nextFloat(0.0f, 3.0f - extent.x);
+        const auto y = random.nextFloat(0.0f, 3.0f - extent.y);
+        const Vertex minimum(x, y, heightmap.computeLowestPlacement(*depthMap, x, y) + 1e-4f);
+
+        WorldSpaceMesh item(tetrahedron);
+        item.getModelTransformation().setRotation(rotation);
+        item.getModelTransformation().setPosition(minimum - depthMap->getBounds().getMinimum());
+        for (const auto& placedItem: placedItems){
+            EXPECT_FALSE(Intersection::intersect(item, placedItem));
+        }
+        placedItems.push_back(item);
+        heightmap.setItem(itemIndex, depthMap, minimum);
+    }
+}
+
+TEST(Heightmap, SolutionSynchronisation) {
+    const auto problem = std::make_shared<StripPackingProblem>("", "Heightmap test", AABB(Vertex(0,0,0), Vertex(4,4,20)),
+                                                               std::vector<std::shared_ptr<ModelSpaceMesh>>{createCube(), createTetrahedron()},
+                                                               std::vector<size_t>{3, 3}, ObjectOrigin::AlignToMinimum);
+    StripPackingSolution solution(problem);
+    const auto& heightmap = solution.getHeightmap();
+    const Random random(1);
+    for (int i = 0; i < 50; ++i){
+        Transformation transformation;
+        transformation.setPosition(glm::vec3(random.nextFloat(0.0f, 3.0f), random.nextFloat(0.0f, 3.0f), random.nextFloat(0.0f, 10.0f)));
+        solution.setItemTransformation(random.nextInteger(0, 5), transformation);
+    }
+
+    // The incrementally updated heightmap equals one built from scratch, also after copying the state of another solution
+    StripPackingSolution other(problem);
+    static_cast<void>(other.getHeightmap());
+    other.copyStateFrom(solution);
+    for (const auto* solutionWithHeightmap: {&solution, &other}){
+        const StripPackingSolution copy(*solutionWithHeightmap); // Copies don't share the heightmap, so it is rebuilt from scratch
+        const auto& rebuilt = copy.getHeightmap();
+        ASSERT_EQ(rebuilt.getColumns(), solutionWithHeightmap->getHeightmap().getColumns());
+        for (int row = 0; row < rebuilt.getRows(); ++row){
+            for (int column = 0; column < rebuilt.getColumns(); ++column){
+                EXPECT_FLOAT_EQ(solutionWithHeightmap->getHeightmap().getHeight(column, row), rebuilt.getHeight(column, row));
+            }
+        }
+    }
+    EXPECT_EQ(&heightmap, &solution.getHeightmap());
+}
@@ -0,0 +1,487 @@
+#include <gtest/gtest.h>
+#include <tbb/parallel_for.h>
+
+#include "meshcore/optimization/StripPackingMoves.h"
+#include "meshcore/optimization/StripPackingObjectives.h"
+#include "meshcore/optimization/ParallelLocalSearch.h"
+#include "meshcore/optimization/BestImprovementSearch.h"
+#include "meshcore/optimization/SimulatedAnnealing.h"
+#include "meshcore/optimization/LateAcceptanceHillClimbing.h"
+#include "meshcore/optimization/ThresholdAccepting.h"
+#include "meshcore/optimization/BottomLeftFill.h"
+
+namespace {
+    std::shared_ptr<StripPackingProblem> createProblem() {
+        std::vector<Vertex> cubeVertices = {Vertex(0,0,0), Vertex(1,0,0), Vertex(0,1,0), Vertex(1,1,0),
+                                            Vertex(0,0,1), Vertex(1,0,1), Vertex(0,1,1), Vertex(1,1,1)};
+        auto cube = ModelSpaceMesh(cubeVertices).getConvexHull();
+        cube->setName("cube.obj");
+
+        std::vector<Vertex> tetrahedronVertices = {Vertex(0,0,0), Vertex(1,0,0), Vertex(0,1,0), Vertex(0,0,1)};
+        auto tetrahedron = ModelSpaceMesh(tetrahedronVertices).getConvexHull();
+        tetrahedron->setName("tetrahedron.obj");
+
+        return std::make_shared<StripPackingProblem>("", "Local search test", AABB(Vertex(0,0,0), Vertex(5,5,50)),
+                                                     std::vector<std::shared_ptr<ModelSpaceMesh>>{cube, tetrahedron},
+                                                     std::vector<size_t>{4, 4}, ObjectOrigin::AlignToMinimum);
+    }
+
+    std::shared_ptr<StripPackingSolution> createStackedSolution(const std::shared_ptr<StripPackingProblem>& problem) {
+        auto solution = std::make_shared<StripPackingSolution>(problem);
+        for (size_t itemIndex = 0; itemIndex < problem->getTotalNumberOfItems(); ++itemIndex){
+            Transformation transformation;
+            transformation.setPosition(glm::vec3(0.0f, 0.0f, 2.0f * static_cast<float>(itemIndex)));
+            solution->setItemTransformation(itemIndex, transformation);
+        }
+        return solution;
+    }
+
+    /** Accepts sampled moves that keep the solution feasible and don't worsen the score **/
+    class RandomDescentSearch: public AbstractLocalSearch<StripPackingSolution> {
+    public:
+        using AbstractLocalSearch::AbstractLocalSearch;
+
+    private:
+        void initialize(const std::shared_ptr<StripPackingSolution>& /*initialSolution*/, float /*initialScore*/) override {}
+
+        float performIteration(unsigned int /*currentIteration*/, std::shared_ptr<StripPackingSolution>& currentSolution, float currentScore) override {
+            const auto move = moveFactory.sample(currentSolution, random, 1.0f);
+            move->doMove(currentSolution);
+            const auto score = evaluateMove(currentSolution, *move, currentScore);
+            if(score <= currentScore && currentSolution->isFeasible()){
+                return score;
+            }
+            move->undoMove(currentSolution);
+            return currentScore;
+        }
+    };
+
+    /** Steepest descent over the listed moves, scoring each move through the delta evaluation path **/
+    class DescentSearch: public AbstractLocalSearch<StripPackingSolution> {
+    public:
+        using AbstractLocalSearch::AbstractLocalSearch;
+        unsigned int deltaEvaluations = 0;
+
+    private:
+        void initialize(const std::shared_ptr<StripPackingSolution>& /*initialSolution*/, float /*initialScore*/) override {}
+
+        float performIteration(unsigned int /*currentIteration*/, std::shared_ptr<StripPackingSolution>& currentSolution, float currentScore) override {
+            std::shared_ptr<Move<StripPackingSolution>> bestMove;
+            float bestScore = currentScore;
+            for (const auto &move: moveFactory.listMoves(currentSolution, 0.5f)){
+                move->doMove(currentSolution);
+                const auto score = evaluateMove(currentSolution, *move, currentScore);
+                deltaEvaluations++;
+                if(score < bestScore && currentSolution->isFeasible()){
+                    bestScore = score;
+                    bestMove = move;
+                }
+                move->undoMove(currentSolution);
+            }
+            if(bestMove){
+                bestMove->doMove(currentSolution);
+            }
+            return bestScore;
+        }
+    };
+}
+
+TEST(LocalSearch, DeltaEvaluationMatchesFullEvaluation) {
+    const auto problem = createProblem();
+    auto solution = createStackedSolution(problem);
+    const StripPackingHeightObjective objective;
+    const StripPackingTranslationMoveFactory moveFactory;
+    const Random random(0);
+
+    float score = objective.evaluate(solution);
+    for (int i = 0; i < 1000; ++i){
+        const auto move = moveFactory.sample(solution, random, 2.0f);
+        std::vector<size_t> affectedItems;
+        ASSERT_TRUE(move->appendAffectedItems(affectedItems));
+        ASSERT_EQ(affectedItems.size(), 1);
+        move->doMove(solution);
+        const auto newScore = score + objective.evaluateDelta(*solution, *move, score);
+        EXPECT_NEAR(newScore, objective.evaluate(solution), 1e-5f);
+        EXPECT_NEAR(newScore, StripPackingSolution(*solution).computeTotalHeight(), 1e-5f);
+        if(random.nextFloat() < 0.5f){
+            move->undoMove(solution);
+            score = objective.evaluate(solution);
+        }
+        else {
+            score = newScore;
+        }
+    }
+}
+
+TEST(LocalSearch, DescentWithDeltaEvaluation) {
+    const auto problem = createProblem();
+    const auto solution = createStackedSolution(problem);
+    const StripPackingHeightObjective objective;
+    StripPackingTranslationMoveFactory moveFactory;
+    const Random random(0);
+
+    DescentSearch search(moveFactory, objective, 20, random);
+    const auto initialScore = objective.evaluate(solution);
+    const auto result = search.executeSearch(solution);
+    EXPECT_LT(objective.evaluate(result), initialScore);
+    EXPECT_TRUE(result->isFeasible());
+    EXPECT_GT(search.deltaEvaluations, 0);
+}
+
+TEST(LocalSearch, CopyStateFrom) {
+    const auto problem = createProblem();
+    const auto source = createStackedSolution(problem);
+    const auto target = std::make_shared<StripPackingSolution>(problem);
+    const auto targetItem = target->getItem(3);
+
+    ASSERT_TRUE(target->copyStateFrom(*source));
+    EXPECT_EQ(target->getItem(3), targetItem); // Storage is reused
+    EXPECT_EQ(targetItem->getModelTransformation(), source->getItemTransformation(3)); // Existing views follow the copied state
+    for (size_t itemIndex = 0; itemIndex < problem->getTotalNumberOfItems(); ++itemIndex){
+        EXPECT_EQ(target->getItemTransformation(itemIndex), source->getItemTransformation(itemIndex));
+    }
+    EXPECT_FLOAT_EQ(target->computeTotalHeight(), source->computeTotalHeight());
+
+    // Both solutions remain independent
+    Transformation transformation;
+    transformation.setPosition(glm::vec3(2.0f, 2.0f, 40.0f));
+    source->setItemTransformation(0, transformation);
+    EXPECT_NE(target->getItemTransformation(0), source->getItemTransformation(0));
+    EXPECT_LT(target->computeTotalHeight(), source->computeTotalHeight());
+
+    // Solutions of other problems are not copied
+    const auto otherSolution = std::make_shared<StripPackingSolution>(createProblem());
+    EXPECT_FALSE(otherSolution->copyStateFrom(*source));
+}
+
+TEST(LocalSearch, FlatItemStorage) {
+    const auto problem = createProblem();
+    const auto solution = createStackedSolution(problem);
+    ASSERT_EQ(solution->getNumberOfItems(), problem->getTotalNumberOfItems());
+    EXPECT_EQ(solution->getItemType(0), 0);
+    EXPECT_EQ(solution->getItemType(7), 1);
+    EXPECT_EQ(solution->getItemName(7), "tetrahedron.obj");
+
+    // Rotated and scaled items have the same AABB as their WorldSpaceMesh view
+    Transformation transformation;
+    transformation.setPosition(glm::vec3(2.0f, 2.5f, 30.0f));
+    transformation.setRotation(Quaternion(0.3f, 0.7f, -1.1f));
+    transformation.setScale(1.5f);
+    solution->setItemTransformation(5, transformation);
+    const auto& view = solution->getItem(5);
+    EXPECT_EQ(view->getModelTransformation(), transformation);
+    const auto expectedAABB = view->computeWorldSpaceAABB();
+    const auto& itemAABB = solution->getItemAABB(5);
+    for (int axis = 0; axis < 3; ++axis){
+        EXPECT_NEAR(itemAABB.getMinimum()[axis], expectedAABB.getMinimum()[axis], 1e-4f);
+        EXPECT_NEAR(itemAABB.getMaximum()[axis], expectedAABB.getMaximum()[axis], 1e-4f);
+    }
+
+    // Clones share the item ids but not their state
+    const auto clone = std::static_pointer_cast<StripPackingSolution>(solution->clone());
+    EXPECT_EQ(clone->getItem(5)->getId(), view->getId());
+    EXPECT_NE(clone->getItem(5), view);
+    clone->setItemTransformation(5, Transformation());
+    EXPECT_EQ(solution->getItemTransformation(5), transformation);
+    EXPECT_EQ(view->getModelTransformation(), transformation);
+    EXPECT_EQ(clone->getItemIndexByID(view->getId()), 5);
+
+    // Once the caches are prepared, the queries only read and can run concurrently
+    solution->prepareCaches();
+    const auto& items = solution->getItems();
+    tbb::parallel_for(size_t(0), solution->getNumberOfItems(), [&](size_t itemIndex){
+        const auto worldSpaceAABB = items[itemIndex]->computeWorldSpaceAABB();
+        EXPECT_NEAR(solution->getItemAABB(itemIndex).getMaximum().z, worldSpaceAABB.getMaximum().z, 1e-4f);
+        EXPECT_NEAR(solution->computeTotalHeight(), expectedAABB.getMaximum().z, 1e-4f);
+    });
+}
+
+TEST(LocalSearch, ParallelMultiStart) {
+    const auto problem = createProblem();
+    const auto initialSolution = createStackedSolution(problem);
+    const StripPackingHeightObjective objective;
+    StripPackingTranslationMoveFactory moveFactory;
+    const auto searchFactory = [&](size_t /*replicaIndex*/, const Random& random) {
+        return std::make_shared<RandomDescentSearch>(moveFactory, objective, 200, random);
+    };
+
+    std::vector<std::shared_ptr<StripPackingSolution>> results;
+    for (const int concurrency: {1, 4}){
+        ParallelLocalSearch<StripPackingSolution> search(searchFactory, 8, 2, {}, 7, concurrency);
+        float reportedBestScore = objective.evaluate(initialSolution);
+        auto listener = std::make_shared<LocalSearchListener<StripPackingSolution>>();
+        listener->setOnNewBestSolutionFound([&](std::shared_ptr<const StripPackingSolution> /*solution*/, float score, unsigned int /*iteration*/){
+            EXPECT_LE(score, reportedBestScore);
+            reportedBestScore = score;
+        });
+        search.addListener(listener);
+
+        const auto result = search.executeSearch(initialSolution);
+        EXPECT_TRUE(result->isFeasible());
+        EXPECT_LT(objective.evaluate(result), objective.evaluate(initialSolution));
+        EXPECT_FLOAT_EQ(objective.evaluate(result), reportedBestScore);
+        results.push_back(result);
+    }
+
+    // Seeded runs don't depend on the number of threads
+    for (size_t itemIndex = 0; itemIndex < problem->getTotalNumberOfItems(); ++itemIndex){
+        EXPECT_EQ(results[0]->getItemTransformation(itemIndex), results[1]->getItemTransformation(itemIndex));
+    }
+}
+
+TEST(LocalSearch, ParallelTempering) {
+    const auto problem = createProblem();
+    const auto initialSolution = createStackedSolution(problem);
+    const StripPackingHeightObjective objective;
+    StripPackingTranslationMoveFactory moveFactory;
+    const auto searchFactory = [&](size_t /*replicaIndex*/, const Random& random) {
+        return std::make_shared<RandomDescentSearch>(moveFactory, objective, 50, random);
+    };
+
+    EXPECT_THROW(ParallelLocalSearch<StripPackingSolution>(searchFactory, 4, 10, {1.0f, 2.0f}), std::invalid_argument);
+
+    ParallelLocalSearch<StripPackingSolution> search(searchFactory, 4, 10, {0.1f, 0.5f, 2.0f, 10.0f});
+    const auto result = search.executeSearch(initialSolution);
+    EXPECT_TRUE(result->isFeasible());
+    EXPECT_LT(objective.evaluate(result), objective.evaluate(initialSolution));
+    EXPECT_GT(search.getAcceptedExchanges(), 0);
+}
+
+TEST(LocalSearch, ParallelBestImprovement) {
+    const auto problem = createProblem();
+    const auto solution = createStackedSolution(problem);
+    const StripPackingHeightObjective objective;
+    StripPackingTranslationMoveFactory moveFactory;
+    const Random random(0);
+
+    DescentSearch sequentialSearch(moveFactory, objective, 20, random);
+    const auto expected = sequentialSearch.executeSearch(solution);
+
+    // Same moves are selected as in the sequential descent, whatever the number of threads
+    for (const int concurrency: {1, 4}){
+        BestImprovementSearch<StripPackingSolution> search(moveFactory, objective, 20, random, 0.5f);
+        std::shared_ptr<StripPackingSolution> result;
+        tbb::task_arena(concurrency).execute([&](){
+            result = search.executeSearch(solution);
+        });
+        EXPECT_TRUE(result->isFeasible());
+        EXPECT_FLOAT_EQ(objective.evaluate(result), objective.evaluate(expected));
+        for (size_t itemIndex = 0; itemIndex < problem->getTotalNumberOfItems(); ++itemIndex){
+            EXPECT_EQ(result->getItemTransformation(itemIndex), expected->getItemTransformation(itemIndex));
+        }
+    }
+}
+
+TEST(LocalSearch, ParallelBestImprovementWithOverlap) {
+
+    // Enough items for the overlap penalties to be reduced in parallel, inside the parallel evaluation of the moves
+    std::vector<Vertex> cubeVertices = {Vertex(0,0,0), Vertex(1,0,0), Vertex(0,1,0), Vertex(1,1,0),
+                                        Vertex(0,0,1), Vertex(1,0,1), Vertex(0,1,1), Vertex(1,1,1)};
+    const auto problem = std::make_shared<StripPackingProblem>("", "Overlap search test", AABB(Vertex(0,0,0), Vertex(5,5,50)),
+                                                               std::vector<std::shared_ptr<ModelSpaceMesh>>{ModelSpaceMesh(cubeVertices).getConvexHull()},
+                                                               std::vector<size_t>{24}, ObjectOrigin::AlignToMinimum);
+    const auto solution = std::make_shared<StripPackingSolution>(problem);
+    for (size_t itemIndex = 0; itemIndex < problem->getTotalNumberOfItems(); ++itemIndex){
+        Transformation transformation;
+        transformation.setPosition(glm::vec3(0.5f * static_cast<float>(itemIndex % 3), 0.5f * static_cast<float>((itemIndex / 3) % 3), 0.6f * static_cast<float>(itemIndex)));
+        solution->setItemTransformation(itemIndex, transformation);
+    }
+    const StripPackingOverlapObjective objective(10.0f);
+    StripPackingTranslationMoveFactory moveFactory;
+    const Random random(0);
+
+    std::vector<std::shared_ptr<StripPackingSolution>> results;
+    for (const int concurrency: {1, 4}){
+        BestImprovementSearch<StripPackingSolution> search(moveFactory, objective, 10, random, 0.5f, false);
+        tbb::task_arena(concurrency).execute([&](){
+            results.push_back(search.executeSearch(solution));
+        });
+    }
+    EXPECT_LT(objective.evaluate(results[0]), objective.evaluate(solution));
+    EXPECT_FLOAT_EQ(objective.evaluate(results[1]), objective.evaluate(results[0]));
+    for (size_t itemIndex = 0; itemIndex < problem->getTotalNumberOfItems(); ++itemIndex){
+        EXPECT_EQ(results[1]->getItemTransformation(itemIndex), results[0]->getItemTransformation(itemIndex));
+    }
+}
+
+TEST(LocalSearch, SamplingSearches) {
+    const auto problem = createProblem();
+    const auto initialSolution = createStackedSolution(problem);
+    const StripPackingHeightObjective objective;
+    StripPackingTranslationMoveFactory moveFactory;
+    const Random random(0);
+    const auto initialScore = objective.evaluate(initialSolution);
+
+    SamplingSearchParameters parameters;
+    parameters.initialStepSize = 2.0f;
+    parameters.minimumStepSize = 0.1f;
+    parameters.maximumStepSize = 4.0f;
+    parameters.adaptationInterval = 50;
+    parameters.reheatAfter = 300;
+
+    // Sampling into a move nobody else holds reuses its allocation
+    const Random sampleRandom(1);
+    std::shared_ptr<Move<StripPackingSolution>> move;
+    moveFactory.sampleInto(move, initialSolution, sampleRandom, 1.0f);
+    const auto allocation = move.get();
+    moveFactory.sampleInto(move, initialSolution, sampleRandom, 1.0f);
+    EXPECT_EQ(move.get(), allocation);
+
+    SimulatedAnnealing<StripPackingSolution> simulatedAnnealing(moveFactory, objective, 2000, random, 1.0f, 0.01f, parameters);
+    LateAcceptanceHillClimbing<StripPackingSolution> lateAcceptance(moveFactory, objective, 2000, random, 50, parameters);
+    ThresholdAccepting<StripPackingSolution> thresholdAccepting(moveFactory, objective, 2000, random, 0.5f, parameters);
+
+    for (AbstractSamplingSearch<StripPackingSolution>* search: std::initializer_list<AbstractSamplingSearch<StripPackingSolution>*>{&simulatedAnnealing, &lateAcceptance, &thresholdAccepting}){
+        const auto result = search->executeSearch(initialSolution);
+        EXPECT_TRUE(result->isFeasible());
+        EXPECT_LT(objective.evaluate(result), initialScore);
+        EXPECT_GE(search->getStepSize(), parameters.minimumStepSize);
+        EXPECT_LE(search->getStepSize(), parameters.maximumStepSize);
+        EXPECT_GT(search->getReheats(), 0);
+    }
+
+    // Without reheats, the threshold of the last iteration follows directly from the linear schedule
+    ThresholdAccepting<StripPackingSolution> decayingThreshold(moveFactory, objective, 1000, random, 0.5f);
+    decayingThreshold.executeSearch(initialSolution);
+    EXPECT_NEAR(decayingThreshold.getThreshold(), 0.5f * (1.0f - 999.0f / 1000.0f), 1e-6f);
+    EXPECT_THROW(SimulatedAnnealing<StripPackingSolution>(moveFactory, objective, 10, random, 0.0f, 1.0f), std::invalid_argument);
+}
+
+TEST(LocalSearch, TerminationCriteria) {
+    const auto problem = createProblem();
+    const auto initialSolution = createStackedSolution(problem);
+    const StripPackingHeightObjective objective;
+    StripPackingTranslationMoveFactory moveFactory;
+    const Random random(0);
+
+    // Time budget, the search stops within a few clock checks after the budget runs out, long before its iteration limit
+    const unsigned int maximumIterations = 100000000;
+    const std::chrono::milliseconds budget(100);
+    RandomDescentSearch timedSearch(moveFactory, objective, maximumIterations, random);
+    timedSearch.setTimeBudget(budget);
+    unsigned int iterations = 0;
+    auto listener = std::make_shared<LocalSearchListener<StripPackingSolution>>();
+    listener->setOnNewCurrentSolutionFound([&](std::shared_ptr<const StripPackingSolution>, float, std::shared_ptr<const StripPackingSolution>, float, unsigned int){ iterations++; });
+    timedSearch.addListener(listener);
+    const auto start = std::chrono::steady_clock::now();
+    timedSearch.executeSearch(initialSolution);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(elapsed, budget);
+    EXPECT_LT(elapsed, 3 * budget);
+    EXPECT_GT(iterations, 0);
+    EXPECT_LT(iterations, maximumIterations);
+
+    // Stagnation, the descent reaches a local optimum well within the iteration limit
+    DescentSearch stagnatingSearch(moveFactory, objective, 1000, random);
+    stagnatingSearch.setMaximumIterationsWithoutImprovement(5);
+    stagnatingSearch.executeSearch(initialSolution);
+    EXPECT_LT(stagnatingSearch.deltaEvaluations, 1000 * 48);
+}
+
+TEST(LocalSearch, ListenerNotification) {
+    const auto problem = createProblem();
+    const auto initialSolution = createStackedSolution(problem);
+    const StripPackingHeightObjective objective;
+    StripPackingTranslationMoveFactory moveFactory;
+    const Random random(0);
+
+    unsigned int currentNotifications = 0;
+    unsigned int bestNotifications = 0;
+    auto listener = std::make_shared<LocalSearchListener<StripPackingSolution>>();
+    listener->setOnNewCurrentSolutionFound([&](std::shared_ptr<const StripPackingSolution>, float, std::shared_ptr<const StripPackingSolution>, float, unsigned int){ currentNotifications++; });
+    listener->setOnNewBestSolutionFound([&](std::shared_ptr<const StripPackingSolution>, float, unsigned int){ bestNotifications++; });
+
+    RandomDescentSearch search(moveFactory, objective, 1000, random);
+    search.addListener(listener);
+
+    search.executeSearch(initialSolution);
+    EXPECT_EQ(currentNotifications, 1000);
+    EXPECT_GT(bestNotifications, 0);
+
+    currentNotifications = 0;
+    search.notifyEveryIterations(100);
+    search.executeSearch(initialSolution);
+    EXPECT_EQ(currentNotifications, 10);
+
+    currentNotifications = 0;
+    bestNotifications = 0;
+    search.notifyOnlyImprovements();
+    search.executeSearch(initialSolution);
+    EXPECT_EQ(currentNotifications, 0);
+    EXPECT_GT(bestNotifications, 0);
+
+    currentNotifications = 0;
+    search.notifyEveryInterval(std::chrono::hours(1));
+    search.executeSearch(initialSolution);
+    EXPECT_EQ(currentNotifications, 0);
+}
+
+TEST(LocalSearch, OverlapObjective) {
+    const auto problem = createProblem();
+    auto solution = createStackedSolution(problem);
+    const StripPackingOverlapObjective objective(10.0f);
+    const StripPackingTranslationMoveFactory moveFactory;
+    const Random random(0);
+
+    // A feasible stack of cubes and tetrahedra only pays for its height
+    EXPECT_NEAR(objective.computePenalty(*solution), 0.0f, 1e-5f);
+    EXPECT_NEAR(objective.evaluate(solution), solution->computeTotalHeight(), 1e-5f);
+
+    // Two cubes overlapping by 0.25 along z, and a third one sticking out of the container by 0.5 along x
+    Transformation transformation;
+    transformation.setPosition(glm::vec3(0.0f, 0.0f, 0.75f));
+    solution->setItemTransformation(1, transformation);
+    transformation.setPosition(glm::vec3(4.5f, 0.0f, 6.0f));
+    solution->setItemTransformation(3, transformation);
+    EXPECT_NEAR(objective.computePenalty(*solution), 0.25f + 0.5f, 1e-3f);
+
+    // Delta evaluation matches full evaluation, also when the moves pass through infeasible solutions
+    float score = objective.evaluate(solution);
+    for (int i = 0; i < 300; ++i){
+        const auto move = moveFactory.sample(solution, random, 2.0f);
+        move->doMove(solution);
+        const auto newScore = score + objective.evaluateDelta(*solution, *move, score);
+        ASSERT_NEAR(newScore, objective.evaluate(solution), 1e-3f);
+        if(random.nextFloat() < 0.3f){
+            move->undoMove(solution);
+            score = objective.evaluate(solution);
+        }
+        else {
+            score = newScore;
+        }
+    }
+
+    // The penalty is summed in the same order on every evaluation, so repeated evaluations are bit-identical
+    const auto penalty = objective.computePenalty(*solution);
+    for (int i = 0; i < 10; ++i){
+        EXPECT_EQ(objective.computePenalty(*solution), penalty);
+    }
+}
+
+TEST(LocalSearch, BottomLeftFill) {
+    const auto problem = createProblem();
+
+    // The four cubes form a single layer in the corner, the tetrahedra are placed on and next to them
+    const BottomLeftFill constructor;
+    const auto solution = constructor.construct(problem);
+    EXPECT_TRUE(solution->isFeasible());
+    EXPECT_LT(solution->computeTotalHeight(), 2.1f);
+    for (size_t itemIndex = 0; itemIndex < 4; ++itemIndex){
+        EXPECT_NEAR(solution->getItemAABB(itemIndex).getMinimum().z, 0.0f, 1e-3f);
+    }
+
+    // The result doesn't depend on the number of threads
+    BottomLeftFillParameters parameters;
+    parameters.itemOrder = ItemOrder::DecreasingHeight;
+    parameters.orientations = BottomLeftFill::getAxisAlignedOrientations();
+    EXPECT_EQ(parameters.orientations.size(), 24);
+    const BottomLeftFill rotatingConstructor(parameters);
+    std::shared_ptr<StripPackingSolution> sequentialSolution;
+    std::shared_ptr<StripPackingSolution> parallelSolution;
+    tbb::task_arena(1).execute([&](){ sequentialSolution = rotatingConstructor.construct(problem); });
+    tbb::task_arena(4).execute([&](){ parallelSolution = rotatingConstructor.construct(problem); });
+    EXPECT_TRUE(sequentialSolution->isFeasible());
+    for (size_t itemIndex = 0; itemIndex < problem->getTotalNumberOfItems(); ++itemIndex){
+        EXPECT_EQ(sequentialSolution->getItemTransformation(itemIndex), parallelSolution->getItemTransformation(itemIndex));
+    }
+}
@@ -0,0 +1,113 @@
+#include <array>
+#include <gtest/gtest.h>
+#include <tbb/parallel_for.h>
+
+#include "meshcore/core/ModelSpaceMesh.h"
+#include "meshcore/utility/random.h"
+
+namespace {
+    std::shared_ptr<ModelSpaceMesh> randomConvexMesh(const Random& random, size_t vertexCount) {
+        std::vector<Vertex> vertices;
+        for (size_t i = 0; i < vertexCount; ++i){
+            vertices.emplace_back(random.nextFloat(-1.0f, 1.0f), random.nextFloat(-1.0f, 1.0f), random.nextFloat(-1.0f, 1.0f));
+        }
+        return ModelSpaceMesh(vertices).getConvexHull();
+    }
+}
+
+TEST(ModelSpaceMesh, ConcurrentLazyProperties) {
+    Random random(0);
+    for (int i = 0; i < 20; ++i){
+        const auto reference = randomConvexMesh(random, 200);
+        const auto shared = std::make_shared<ModelSpaceMesh>(reference->getVertices(), reference->getTriangles());
+
+        // All workers query the same fresh mesh at once
+        tbb::parallel_for(0, 64, [&](int worker){
+            switch (worker % 6) {
+                case 0: EXPECT_FLOAT_EQ(shared->getVolume(), reference->getVolume()); break;
+                case 1: EXPECT_EQ(shared->getBounds(), reference->getBounds()); break;
+                case 2: EXPECT_EQ(shared->getConvexHull()->getVertices().size(), reference->getConvexHull()->getVertices().size()); break;
+                case 3: EXPECT_EQ(shared->getFaces().size(), reference->getFaces().size()); break;
+                case 4: EXPECT_EQ(shared->getEdges().size(), reference->getEdges().size()); break;
+                default: EXPECT_FLOAT_EQ(shared->getSurfaceArea(), reference->getSurfaceArea()); break;
+            }
+        });
+    }
+}
+
+TEST(ModelSpaceMesh, PrecomputeAll) {
+    Random random(1);
+    const auto reference = randomConvexMesh(random, 100);
+    for (const bool parallel: {false, true}){
+        const ModelSpaceMesh mesh(reference->getVertices(), reference->getTriangles());
+        mesh.precomputeAll(parallel);
+        EXPECT_FLOAT_EQ(mesh.getVolume(), reference->getVolume());
+        EXPECT_FLOAT_EQ(mesh.getSurfaceArea(), reference->getSurfaceArea());
+        EXPECT_EQ(mesh.getBounds(), reference->getBounds());
+        EXPECT_TRUE(mesh.isConvex());
+        EXPECT_EQ(mesh.getFaceEdges().size(), reference->getFaceEdges().size());
+        EXPECT_EQ(mesh.getConnectedVertexIndices().size(), reference->getVertices().size());
+    }
+}
+
+namespace {
+    // Unit cube of which each side is subdivided in a grid of resolution x resolution quads
+    std::shared_ptr<ModelSpaceMesh> subdividedCube(unsigned int resolution) {
+        const std::array<std::array<glm::vec3, 3>, 6> sides = {{ // Origin, u, v with u x v pointing outwards
+            {glm::vec3(0, 0, 1), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0)},
+            {glm::vec3(0, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 0, 0)},
+            {glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, 0, 1)},
+            {glm::vec3(0, 0, 0), glm::vec3(0, 0, 1), glm::vec3(0, 1, 0)},
+            {glm::vec3(0, 1, 0), glm::vec3(0, 0, 1), glm::vec3(1, 0, 0)},
+            {glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 0, 1)}
+        }};
+        std::vector<Vertex> vertices;
+        std::vector<IndexTriangle> triangles;
+        for (const auto &side: sides){
+            const size_t offset = vertices.size();
+            for (unsigned int j = 0; j <= resolution; ++j){
+                for (unsigned int i = 0; i <= resolution; ++i){
+                    vertices.emplace_back(side[0] + side[1] * (float(i) / float(resolution)) + side[2] * (float(j) / float(resolution)));
+                }
+            }
+            auto index = [&](unsigned int i, unsigned int j){ return offset + j * (resolution + 1) + i; };
+            for (unsigned int j = 0; j < resolution; ++j){
+                for (unsigned int i = 0; i < resolution; ++i){
+                    triangles.emplace_back(index(i, j), index(i + 1, j), index(i + 1, j + 1));
+                    triangles.emplace_back(index(i, j), index(i + 1, j + 1), index(i, j + 1));
+                }
+            }
+        }
+        return std::make_shared<ModelSpaceMesh>(vertices, triangles);
+    }
+}
+
+TEST(ModelSpaceMesh, ConvexHullFaces) {
+    std::vector<Vertex> cubeVertices = {Vertex(0,0,0), Vertex(1,0,0), Vertex(0,1,0), Vertex(1,1,0),
+                                        Vertex(0,0,1), Vertex(1,0,1), Vertex(0,1,1), Vertex(1,1,1)};
+    const auto cube = ModelSpaceMesh(cubeVertices).getConvexHull();
+    ASSERT_EQ(cube->getFaces().size(), 6);
+    for (const auto &face: cube->getFaces()){
+        EXPECT_EQ(face.vertexIndices.size(), 4);
+    }
+    EXPECT_EQ(cube->getFaceEdges().size(), 12);
+}
+
+TEST(ModelSpaceMesh, SubdividedFaces) {
+    for (const unsigned int resolution: {1u, 7u, 130u}){ // The largest one has over 200k triangles
+        const auto mesh = subdividedCube(resolution);
+        const auto& faces = mesh->getFaces();
+        ASSERT_EQ(faces.size(), 6);
+        for (const auto &face: faces){
+            EXPECT_EQ(face.vertexIndices.size(), 4 * resolution);
+
+            // Boundary vertices of a side share exactly one coordinate
+            const auto& first = mesh->getVertices()[face.vertexIndices[0]];
+            glm::bvec3 sharedAxes(true);
+            for (const auto &vertexIndex: face.vertexIndices){
+                sharedAxes &= glm::equal(mesh->getVertices()[vertexIndex], first);
+            }
+            EXPECT_EQ(int(sharedAxes.x) + int(sharedAxes.y) + int(sharedAxes.z), 1);
+        }
+    }
+}
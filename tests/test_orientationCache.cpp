@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include "meshcore/acceleration/OrientationCache.h"
+#include "meshcore/core/WorldSpaceMesh.h"
+#include "meshcore/geometric/Intersection.h"
+#include "meshcore/optimization/BottomLeftFill.h"
+#include "meshcore/optimization/StripPackingSolution.h"
+#include "meshcore/utility/random.h"
+
+namespace {
+    std::shared_ptr<ModelSpaceMesh> createBlock() {
+        std::vector<Vertex> vertices = {Vertex(0,0,0), Vertex(2,0,0), Vertex(0,1,0), Vertex(2,1,0),
+                                        Vertex(0,0,0.5f), Vertex(2,0,0.5f), Vertex(0,1,0.5f), Vertex(2,1,0.5f)};
+        return ModelSpaceMesh(vertices).getConvexHull();
+    }
+
+    std::shared_ptr<ModelSpaceMesh> createTetrahedron() {
+        std::vector<Vertex> vertices = {Vertex(0,0,0), Vertex(1,0,0), Vertex(0,1,0), Vertex(0,0,1)};
+        return ModelSpaceMesh(vertices).getConvexHull();
+    }
+}
+
+TEST(OrientationCache, EquivalentRotationsShareAnEntry) {
+    const auto block = createBlock();
+    OrientationCache cache;
+    const Quaternion rotation(glm::vec3(0, 0, 1), glm::pi<float>() / 2.0f);
+    const auto orientedMesh = cache.get(block, rotation);
+    ASSERT_NE(orientedMesh, nullptr);
+
+    const Quaternion negated(-rotation.w, -rotation.x, -rotation.y, -rotation.z);
+    const Quaternion perturbed(rotation.w + 1e-7f, rotation.x, rotation.y - 1e-7f, rotation.z);
+    EXPECT_EQ(cache.get(block, negated), orientedMesh);
+    EXPECT_EQ(cache.get(block, perturbed), orientedMesh);
+    EXPECT_EQ(cache.getNumberOfEntries(), 1);
+
+    // The bounds match the tight AABB of the rotated mesh
+    WorldSpaceMesh worldSpaceMesh(block);
+    Transformation transformation;
+    transformation.setRotation(rotation);
+    worldSpaceMesh.setModelTransformation(transformation);
+    const auto expected = worldSpaceMesh.computeWorldSpaceAABB();
+    for (int axis = 0; axis < 3; ++axis){
+        EXPECT_NEAR(orientedMesh->bounds.getMinimum()[axis], expected.getMinimum()[axis], 1e-5f);
+        EXPECT_NEAR(orientedMesh->bounds.getMaximum()[axis], expected.getMaximum()[axis], 1e-5f);
+    }
+}
+
+TEST(OrientationCache, AgreesWithGenericIntersection) {
+    const auto block = createBlock();
+    const auto tetrahedron = createTetrahedron();
+    const auto orientations = BottomLeftFill::getAxisAlignedOrientations();
+    OrientationCache cache;
+    cache.prepare({block, tetrahedron}, orientations);
+    EXPECT_EQ(cache.getNumberOfEntries(), 2 * orientations.size());
+
+    Random random(42);
+    WorldSpaceMesh first(block);
+    WorldSpaceMesh second(tetrahedron);
+    int intersecting = 0;
+    for (int sample = 0; sample < 500; ++sample){
+        const auto& firstRotation = orientations[random.nextInteger(0, orientations.size() - 1)];
+        const auto& secondRotation = orientations[random.nextInteger(0, orientations.size() - 1)];
+        const glm::vec3 firstPosition(random.nextFloat() * 2.0f, random.nextFloat() * 2.0f, random.nextFloat() * 2.0f);
+        const glm::vec3 secondPosition(random.nextFloat() * 2.0f, random.nextFloat() * 2.0f, random.nextFloat() * 2.0f);
+        const auto scale = sample % 2 == 0 ? 1.0f : 0.5f;
+
+        Transformation firstTransformation;
+        firstTransformation.setPosition(firstPosition);
+        firstTransformation.setRotation(firstRotation);
+        firstTransformation.setScale(scale);
+        first.setModelTransformation(firstTransformation);
+        Transformation secondTransformation;
+        secondTransformation.setPosition(secondPosition);
+        secondTransformation.setRotation(secondRotation);
+        secondTransformation.setScale(scale);
+        second.setModelTransformation(secondTransformation);
+
+        const auto expected = Intersection::intersect(first, second);
+        const auto firstOrientedMesh = cache.find(block, firstRotation);
+        const auto secondOrientedMesh = cache.find(tetrahedron, secondRotation);
+        ASSERT_NE(firstOrientedMesh, nullptr);
+        ASSERT_NE(secondOrientedMesh, nullptr);
+        EXPECT_EQ(Intersection::intersect(*firstOrientedMesh, firstPosition, *secondOrientedMesh, secondPosition, scale), expected);
+        EXPECT_EQ(Intersection::intersect(*secondOrientedMesh, secondPosition, *firstOrientedMesh, firstPosition, scale), expected);
+        intersecting += expected;
+    }
+    EXPECT_GT(intersecting, 0);
+    EXPECT_LT(intersecting, 500);
+}
+
+TEST(OrientationCache, MemoryLimitAndLazyBuild) {
+    const auto block = createBlock();
+    const auto orientations = BottomLeftFill::getAxisAlignedOrientations();
+
+    OrientationCache unlimited;
+    const auto entrySize = unlimited.get(block, orientations[0])->computeMemoryUsage();
+    EXPECT_EQ(unlimited.getMemoryUsage(), entrySize);
+
+    // Only three entries fit, the oldest ones are evicted first
+    OrientationCache limited({1e-5f, 3 * entrySize + entrySize / 2});
+    for (const auto& orientation: orientations){
+        static_cast<void>(limited.get(block, orientation));
+    }
+    EXPECT_EQ(limited.getNumberOfEntries(), 3);
+    EXPECT_LE(limited.getMemoryUsage(), 3 * entrySize + entrySize / 2);
+    EXPECT_EQ(limited.find(block, orientations[0]), nullptr);
+    EXPECT_NE(limited.find(block, orientations.back()), nullptr);
+
+    OrientationCacheParameters parameters;
+    parameters.lazyBuild = false;
+    parameters.buildTrees = false;
+    OrientationCache prepared(parameters);
+    EXPECT_EQ(prepared.get(block, orientations[1]), nullptr);
+    prepared.prepare({block}, {orientations[1]});
+    const auto orientedMesh = prepared.get(block, orientations[1]);
+    ASSERT_NE(orientedMesh, nullptr);
+    EXPECT_EQ(orientedMesh->tree, nullptr);
+}
+
+TEST(OrientationCache, SolutionFeasibility) {
+    const auto block = createBlock();
+    const auto tetrahedron = createTetrahedron();
+    auto problem = std::make_shared<StripPackingProblem>("", "Orientation cache test", AABB(Vertex(0,0,0), Vertex(4,4,20)),
+                                                         std::vector<std::shared_ptr<ModelSpaceMesh>>{block, tetrahedron}, std::vector<size_t>{4, 4}, ObjectOrigin::AlignToMinimum);
+    const auto orientations = BottomLeftFill::getAxisAlignedOrientations();
+
+    StripPackingSolution plain(problem);
+    StripPackingSolution cached(problem);
+    cached.setOrientationCache(std::make_shared<OrientationCache>());
+    cached.getOrientationCache()->prepare(problem->getRequiredItems(), orientations);
+
+    Random random(7);
+    int feasible = 0;
+    for (int sample = 0; sample < 50; ++sample){
+        for (size_t itemIndex = 0; itemIndex < plain.getNumberOfItems(); ++itemIndex){
+            Transformation transformation;
+            transformation.setRotation(orientations[random.nextInteger(0, orientations.size() - 1)]);
+            transformation.setPosition(glm::vec3(2.0f + random.nextFloat() * 0.5f, 2.0f + random.nextFloat() * 0.5f, 2.0f + 2.0f * itemIndex * random.nextFloat()));
+            plain.setItemTransformation(itemIndex, transformation);
+            cached.setItemTransformation(itemIndex, transformation);
+        }
+        for (size_t itemIndex = 0; itemIndex < plain.getNumberOfItems(); ++itemIndex){
+            for (int axis = 0; axis < 3; ++axis){
+                EXPECT_NEAR(cached.getItemAABB(itemIndex).getMinimum()[axis], plain.getItemAABB(itemIndex).getMinimum()[axis], 1e-4f);
+                EXPECT_NEAR(cached.getItemAABB(itemIndex).getMaximum()[axis], plain.getItemAABB(itemIndex).getMaximum()[axis], 1e-4f);
+            }
+        }
+        const auto expected = plain.isFeasible();
+        EXPECT_EQ(cached.isFeasible(), expected);
+        feasible += expected;
+    }
+    EXPECT_EQ(cached.getOrientationCache()->getNumberOfEntries(), 2 * orientations.size());
+    EXPECT_LT(feasible, 50);
+}
+
+TEST(OrientationCache, SolutionOnlyUsesPreparedOrientations) {
+    const auto block = createBlock();
+    auto problem = std::make_shared<StripPackingProblem>("", "Orientation cache test", AABB(Vertex(0,0,0), Vertex(4,4,20)),
+                                                         std::vector<std::shared_ptr<ModelSpaceMesh>>{block}, std::vector<size_t>{4}, ObjectOrigin::AlignToMinimum);
+    const auto orientations = BottomLeftFill::getAxisAlignedOrientations();
+
+    // The default cache builds entries lazily, but a solution only looks up orientations and never adds them
+    StripPackingSolution plain(problem);
+    StripPackingSolution cached(problem);
+    cached.setOrientationCache(std::make_shared<OrientationCache>());
+    cached.getOrientationCache()->prepare(problem->getRequiredItems(), orientations);
+
+    Random random(3);
+    for (int sample = 0; sample < 200; ++sample){
+        const auto itemIndex = static_cast<size_t>(random.nextInteger(0, 3));
+        Transformation transformation;
+        transformation.setRotation(sample % 2 == 0 ? orientations[random.nextInteger(0, orientations.size() - 1)] :
+                                   Quaternion(random.nextFloat(0.0f, 6.28f), random.nextFloat(0.0f, 6.28f), random.nextFloat(0.0f, 6.28f)));
+        transformation.setPosition(glm::vec3(random.nextFloat(0.0f, 2.0f), random.nextFloat(0.0f, 2.0f), random.nextFloat(0.0f, 4.0f)));
+        plain.setItemTransformation(itemIndex, transformation);
+        cached.setItemTransformation(itemIndex, transformation);
+
+        for (int axis = 0; axis < 3; ++axis){
+            EXPECT_NEAR(cached.getItemAABB(itemIndex).getMinimum()[axis], plain.getItemAABB(itemIndex).getMinimum()[axis], 1e-4f);
+            EXPECT_NEAR(cached.getItemAABB(itemIndex).getMaximum()[axis], plain.getItemAABB(itemIndex).getMaximum()[axis], 1e-4f);
+        }
+        EXPECT_EQ(cached.isFeasible(), plain.isFeasible());
+    }
+    EXPECT_EQ(cached.getOrientationCache()->getNumberOfEntries(), orientations.size());
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include "meshcore/core/WorldSpaceMesh.h"
+#include "meshcore/geometric/GJK.h"
+
+namespace {
+    std::shared_ptr<ModelSpaceMesh> createCube() {
+        std::vector<Vertex> vertices = {Vertex(0,0,0), Vertex(1,0,0), Vertex(0,1,0), Vertex(1,1,0),
+                                        Vertex(0,0,1), Vertex(1,0,1), Vertex(0,1,1), Vertex(1,1,1)};
+        return ModelSpaceMesh(vertices).getConvexHull();
+    }
+}
+
+TEST(PenetrationDepth, OverlappingCubes) {
+    const auto cube = createCube();
+    WorldSpaceMesh first(cube);
+    WorldSpaceMesh second(cube);
+    second.getModelTransformation().setPosition(glm::vec3(0.7f, 0.1f, 0.95f));
+
+    glm::vec3 normal;
+    EXPECT_NEAR(GJK::computePenetrationDepth(first, second, &normal), 0.05f, 1e-3f);
+    EXPECT_NEAR(std::abs(normal.z), 1.0f, 1e-3f);
+
+    second.getModelTransformation().setPosition(glm::vec3(0.7f, 0.0f, 0.0f));
+    EXPECT_NEAR(GJK::computePenetrationDepth(first, second, &normal), 0.3f, 1e-3f);
+    EXPECT_NEAR(normal.x, 1.0f, 1e-3f);
+
+    // Moving the second shape along the normal by the depth separates the shapes
+    const auto depth = GJK::computePenetrationDepth(first, second, &normal);
+    second.getModelTransformation().setPosition(second.getModelTransformation().getPosition() + normal * (depth + 1e-3f));
+    EXPECT_TRUE(GJK::hasSeparation(first, second));
+}
+
+TEST(PenetrationDepth, SeparatedAndRotatedCubes) {
+    const auto cube = createCube();
+    WorldSpaceMesh first(cube);
+    WorldSpaceMesh second(cube);
+    second.getModelTransformation().setPosition(glm::vec3(1.5f, 0.0f, 0.0f));
+    EXPECT_EQ(GJK::computePenetrationDepth(first, second), 0.0f);
+
+    // Identical shapes penetrate by their smallest extent
+    second.getModelTransformation().setPosition(glm::vec3(0.0f));
+    EXPECT_NEAR(GJK::computePenetrationDepth(first, second), 1.0f, 1e-3f);
+
+    // A cube rotated 45 degrees around z, with an edge pushed 0.2 into the other cube, which translating by 0.2 along x resolves
+    second.getModelTransformation().setRotation(Quaternion(glm::vec3(0.0f, 0.0f, 1.0f), 0.25f * 3.14159265f));
+    second.getModelTransformation().setPosition(glm::vec3(0.8f + std::sqrt(0.5f), 0.0f, 0.0f));
+    const auto depth = GJK::computePenetrationDepth(first, second);
+    EXPECT_GT(depth, 0.0f);
+    EXPECT_LE(depth, 0.2f + 1e-3f);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include "meshcore/utility/random.h"
+
+TEST(Random, Reproducible) {
+    const Random first(42);
+    const Random second(42);
+    const Random other(43);
+    bool differs = false;
+    for (int i = 0; i < 100; ++i){
+        const auto value = first.nextBits();
+        EXPECT_EQ(value, second.nextBits());
+        differs |= value != other.nextBits();
+    }
+    EXPECT_TRUE(differs);
+}
+
+TEST(Random, Bounds) {
+    const Random random(0);
+    std::vector<int> counts(7, 0);
+    for (int i = 0; i < 70000; ++i){
+        const auto integer = random.nextInteger(-3, 3);
+        ASSERT_GE(integer, -3);
+        ASSERT_LE(integer, 3);
+        counts[integer + 3]++;
+
+        const auto unsignedInteger = random.nextUnsignedInteger(5u, 6u);
+        ASSERT_TRUE(unsignedInteger == 5u || unsignedInteger == 6u);
+
+        const auto floatValue = random.nextFloat(-1.0f, 2.0f);
+        ASSERT_GE(floatValue, -1.0f);
+        ASSERT_LT(floatValue, 2.0f);
+
+        const auto doubleValue = random.nextDouble();
+        ASSERT_GE(doubleValue, 0.0);
+        ASSERT_LT(doubleValue, 1.0);
+    }
+    for (const auto count: counts){
+        EXPECT_NEAR(count, 10000, 500);
+    }
+
+    // The full integer range doesn't overflow
+    random.nextInteger(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    random.nextUnsignedInteger();
+}
+
+TEST(Random, BatchedFloats) {
+    const Random random(3);
+    std::vector<float> values(1001);
+    random.nextFloats(values.data(), values.size(), 2.0f, 4.0f);
+    double sum = 0.0;
+    for (const auto value: values){
+        ASSERT_GE(value, 2.0f);
+        ASSERT_LT(value, 4.0f);
+        sum += value;
+    }
+    EXPECT_NEAR(sum / values.size(), 3.0, 0.1);
+}
+
+TEST(Random, Split) {
+    Random parent(7);
+    Random reference(7);
+    auto firstStream = parent.split();
+    auto secondStream = parent.split();
+
+    // The first stream continues the original sequence, the second one starts 2^128 draws further
+    reference.jump();
+    for (int i = 0; i < 100; ++i){
+        const auto value = secondStream.nextBits();
+        EXPECT_EQ(value, reference.nextBits());
+        EXPECT_NE(value, firstStream.nextBits());
+    }
+
+    // Splitting is deterministic
+    Random parentCopy(7);
+    auto firstStreamCopy = parentCopy.split();
+    Random original(7);
+    for (int i = 0; i < 100; ++i){
+        EXPECT_EQ(firstStreamCopy.nextBits(), original.nextBits());
+    }
+}
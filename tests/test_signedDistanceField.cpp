@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+
+#include "meshcore/acceleration/SignedDistanceField.h"
+#include "meshcore/acceleration/BoundingVolumeHierarchy.h"
+#include "meshcore/optimization/SingleVolumeMaximisationSolution.h"
+#include "meshcore/utility/random.h"
+
+namespace {
+    std::shared_ptr<ModelSpaceMesh> createBox(const Vertex& size) {
+        std::vector<Vertex> vertices;
+        for (int corner = 0; corner < 8; ++corner){
+            vertices.emplace_back(corner & 1 ? size.x : 0.0f, corner & 2 ? size.y : 0.0f, corner & 4 ? size.z : 0.0f);
+        }
+        return ModelSpaceMesh(vertices).getConvexHull();
+    }
+
+    /** Exact signed distance to the box [0, size] **/
+    float computeBoxDistance(const Vertex& size, const Vertex& point) {
+        const auto outside = glm::max(glm::max(-point, point - size), Vertex(0.0f));
+        if(outside.x > 0.0f || outside.y > 0.0f || outside.z > 0.0f){
+            return glm::length(outside);
+        }
+        return -std::min(std::min(std::min(point.x, size.x - point.x), std::min(point.y, size.y - point.y)), std::min(point.z, size.z - point.z));
+    }
+}
+
+TEST(SignedDistanceField, BoundsContainExactDistance) {
+    const Vertex size(2.0f, 1.0f, 1.5f);
+    const auto box = createBox(size);
+    SignedDistanceFieldParameters parameters;
+    parameters.resolution = 16;
+    const SignedDistanceField field(box, parameters);
+    SignedDistanceFieldParameters bandParameters = parameters;
+    bandParameters.bandWidth = 0.1f;
+    const SignedDistanceField bandField(box, bandParameters);
+    EXPECT_NEAR(bandField.getBandWidth(), 0.2f, 1e-6f);
+
+    const auto tree = std::make_shared<BoundingVolumeHierarchy>(box);
+    const Random random(11);
+    int decisive = 0;
+    for (int sample = 0; sample < 2000; ++sample){
+        const Vertex point(random.nextFloat(-1.0f, 3.0f), random.nextFloat(-1.0f, 2.0f), random.nextFloat(-1.0f, 2.5f));
+        const auto expected = computeBoxDistance(size, point);
+
+        const auto [lower, upper] = field.getSignedDistanceBounds(point);
+        EXPECT_LE(lower, expected);
+        EXPECT_GE(upper, expected);
+        if(field.getBounds().containsPoint(point)){
+            EXPECT_NEAR(field.getSignedDistance(point), expected, field.getCellSize());
+            EXPECT_LE(upper - lower, 2.0f * std::sqrt(3.0f) * field.getCellSize() + 1e-4f);
+        }
+
+        const auto [bandLower, bandUpper] = bandField.getSignedDistanceBounds(point);
+        EXPECT_LE(bandLower, expected);
+        EXPECT_GE(bandUpper, expected);
+
+        EXPECT_EQ(field.isWithinDistance(point, 0.3f, *tree), std::abs(expected) < 0.3f);
+        decisive += lower >= 0.3f || upper <= -0.3f || (lower >= 0.0f && upper < 0.3f) || (upper <= 0.0f && lower > -0.3f);
+    }
+    EXPECT_GT(decisive, 1000); // Most queries don't need the tree
+
+    // Clamped samples outside the band still carry the sign
+    EXPECT_NEAR(bandField.getSignedDistance(Vertex(1.0f, 0.5f, 0.75f)), -0.2f, 1e-5f);
+    EXPECT_LT(bandField.getSignedDistanceBounds(Vertex(1.0f, 0.5f, 0.75f)).second, 0.0f);
+}
+
+TEST(SignedDistanceField, SaveAndLoad) {
+    const auto box = createBox(Vertex(1.0f));
+    const auto& field = box->getSignedDistanceField();
+    ASSERT_NE(field, nullptr);
+    EXPECT_EQ(box->getSignedDistanceField(), field);
+    EXPECT_THROW(static_cast<void>(ModelSpaceMesh(*box).getSignedDistanceField()), std::bad_weak_ptr); // Not owned by a shared pointer
+
+    const std::string path = "signedDistanceFieldTest.sdf";
+    field->save(path);
+    const auto loaded = SignedDistanceField::load(path);
+    EXPECT_EQ(loaded->getDimensions(), field->getDimensions());
+    EXPECT_EQ(loaded->getOrigin(), field->getOrigin());
+    EXPECT_EQ(loaded->getCellSize(), field->getCellSize());
+    EXPECT_EQ(loaded->getSamples(), field->getSamples());
+
+    const auto other = createBox(Vertex(1.0f));
+    other->setPrecomputedSignedDistanceField(loaded);
+    EXPECT_EQ(other->getSignedDistanceField(), loaded);
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "not a field";
+    EXPECT_THROW(SignedDistanceField::load(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(SignedDistanceField, PenetrationAndContainment) {
+    const auto container = createBox(Vertex(2.0f));
+    const auto item = createBox(Vertex(0.5f));
+    const auto& field = container->getSignedDistanceField();
+
+    Transformation transformation;
+    transformation.setPosition(glm::vec3(1.7f, 0.5f, 0.5f));
+    EXPECT_NEAR(field->estimatePenetrationDepth(*item, transformation), 0.3f, 0.05f);
+    transformation.setPosition(glm::vec3(3.0f, 0.5f, 0.5f));
+    EXPECT_EQ(field->estimatePenetrationDepth(*item, transformation), 0.0f);
+
+    // Feasibility with the distance field matches the exact test
+    auto itemWorldSpaceMesh = std::make_shared<WorldSpaceMesh>(item);
+    auto containerWorldSpaceMesh = std::make_shared<WorldSpaceMesh>(container);
+    SingleVolumeMaximisationSolution exact(itemWorldSpaceMesh, containerWorldSpaceMesh);
+    auto withField = std::static_pointer_cast<SingleVolumeMaximisationSolution>(exact.clone());
+    withField->setContainerDistanceField(field);
+    EXPECT_EQ(std::static_pointer_cast<SingleVolumeMaximisationSolution>(withField->clone())->getContainerDistanceField(), field);
+    auto copy = std::static_pointer_cast<SingleVolumeMaximisationSolution>(exact.clone());
+    ASSERT_TRUE(copy->copyStateFrom(*withField));
+    EXPECT_EQ(copy->getContainerDistanceField(), field);
+    ASSERT_TRUE(copy->copyStateFrom(exact));
+    EXPECT_EQ(copy->getContainerDistanceField(), nullptr);
+
+    const Random random(5);
+    int feasible = 0;
+    for (int sample = 0; sample < 300; ++sample){
+        transformation.setPosition(glm::vec3(random.nextFloat(-0.5f, 2.0f), random.nextFloat(-0.5f, 2.0f), random.nextFloat(-0.5f, 2.0f)));
+        transformation.setRotation(Quaternion(random.nextFloat(0.0f, 6.28f), random.nextFloat(0.0f, 6.28f), random.nextFloat(0.0f, 6.28f)));
+        transformation.setScale(random.nextFloat(0.5f, 2.0f));
+        exact.getItemWorldSpaceMesh()->setModelTransformation(transformation);
+        withField->getItemWorldSpaceMesh()->setModelTransformation(transformation);
+        const auto expected = exact.isFeasible();
+        EXPECT_EQ(withField->isFeasible(), expected);
+        feasible += expected;
+    }
+    EXPECT_GT(feasible, 0);
+    EXPECT_LT(feasible, 300);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <glm/gtc/constants.hpp>
+
+#include "meshcore/utility/Slicer.h"
+
+namespace {
+    std::shared_ptr<ModelSpaceMesh> createBox(const Vertex& size) {
+        std::vector<Vertex> vertices;
+        for (int corner = 0; corner < 8; ++corner){
+            vertices.emplace_back(corner & 1 ? size.x : 0.0f, corner & 2 ? size.y : 0.0f, corner & 4 ? size.z : 0.0f);
+        }
+        return ModelSpaceMesh(vertices).getConvexHull();
+    }
+
+    std::shared_ptr<ModelSpaceMesh> createTorus(float minorRadius, int majorSegments, int minorSegments) {
+        std::vector<Vertex> vertices;
+        for (int i = 0; i < majorSegments; ++i){
+            const auto u = 2.0f * glm::pi<float>() * static_cast<float>(i) / majorSegments;
+            for (int j = 0; j < minorSegments; ++j){
+                const auto v = 2.0f * glm::pi<float>() * static_cast<float>(j) / minorSegments;
+                const auto radius = 1.0f + minorRadius * std::cos(v);
+                vertices.emplace_back(radius * std::cos(u), radius * std::sin(u), minorRadius * std::sin(v));
+            }
+        }
+        std::vector<IndexTriangle> triangles;
+        for (int i = 0; i < majorSegments; ++i){
+            for (int j = 0; j < minorSegments; ++j){
+                const auto a = i * minorSegments + j;
+                const auto b = ((i + 1) % majorSegments) * minorSegments + j;
+                const auto c = ((i + 1) % majorSegments) * minorSegments + (j + 1) % minorSegments;
+                const auto d = i * minorSegments + (j + 1) % minorSegments;
+                triangles.emplace_back(a, b, c);
+                triangles.emplace_back(a, c, d);
+            }
+        }
+        return std::make_shared<ModelSpaceMesh>(vertices, triangles);
+    }
+}
+
+TEST(Slicer, TransformedBoxes) {
+    auto first = std::make_shared<WorldSpaceMesh>(createBox(Vertex(2.0f, 1.0f, 1.5f)));
+    first->getModelTransformation().setPosition(glm::vec3(1.0f, 2.0f, 0.5f));
+    first->getModelTransformation().setRotation(Quaternion(glm::vec3(0.0f, 0.0f, 1.0f), 0.7f));
+    auto second = std::make_shared<WorldSpaceMesh>(createBox(Vertex(1.0f)));
+    second->getModelTransformation().setPosition(glm::vec3(5.0f, 0.0f, 0.0f));
+    second->getModelTransformation().setScale(0.5f);
+
+    const Slicer slicer({first, second});
+    EXPECT_FLOAT_EQ(slicer.getBounds().getMinimum().z, 0.0f);
+    EXPECT_FLOAT_EQ(slicer.getBounds().getMaximum().z, 2.0f);
+
+    const auto layers = slicer.slice(0.1f);
+    ASSERT_EQ(layers.size(), 20);
+    for (const auto& layer: layers){
+        const auto expectedContours = (layer.height > 0.5f ? 1 : 0) + (layer.height < 0.5f ? 1 : 0);
+        ASSERT_EQ(layer.contours.size(), expectedContours);
+        for (const auto& contour: layer.contours){
+            EXPECT_TRUE(contour.closed);
+            EXPECT_GT(contour.computeSignedArea(), 0.0f);
+        }
+        EXPECT_NEAR(layer.computeArea(), (layer.height > 0.5f ? 2.0f : 0.0f) + (layer.height < 0.5f ? 0.25f : 0.0f), 1e-4f);
+    }
+
+    // Vertices on a plane count as above it, so a plane through the bottom faces cuts nothing and one through the top face cuts just below it
+    EXPECT_TRUE(slicer.sliceAt(0.0f).contours.empty());
+    EXPECT_NEAR(slicer.sliceAt(2.0f).computeArea(), 2.0f, 1e-4f);
+    EXPECT_THROW(auto unused = slicer.slice(std::vector<float>{1.0f, 0.5f}), std::invalid_argument);
+}
+
+TEST(Slicer, HolesAndOpenMeshes) {
+    const auto torus = createTorus(0.3f, 64, 32);
+    const auto layer = Slicer(WorldSpaceMesh(torus)).sliceAt(0.01f);
+    ASSERT_EQ(layer.contours.size(), 2);
+    const auto outerArea = std::max(layer.contours[0].computeSignedArea(), layer.contours[1].computeSignedArea());
+    const auto innerArea = std::min(layer.contours[0].computeSignedArea(), layer.contours[1].computeSignedArea());
+    EXPECT_GT(outerArea, 0.0f);
+    EXPECT_LT(innerArea, 0.0f); // The hole runs clockwise
+    const auto halfWidth = std::sqrt(0.3f * 0.3f - 0.01f * 0.01f);
+    const auto expectedArea = glm::pi<float>() * ((1.0f + halfWidth) * (1.0f + halfWidth) - (1.0f - halfWidth) * (1.0f - halfWidth));
+    EXPECT_NEAR(layer.computeArea(), expectedArea, 0.02f * expectedArea);
+
+    // Without its face at x = 0, the box is open and its contour is a chain
+    const auto box = createBox(Vertex(1.0f));
+    std::vector<IndexTriangle> openTriangles;
+    for (const auto& triangle: box->getTriangles()){
+        const auto& vertices = box->getVertices();
+        if(vertices[triangle.vertexIndex0].x == 0.0f && vertices[triangle.vertexIndex1].x == 0.0f && vertices[triangle.vertexIndex2].x == 0.0f){
+            continue;
+        }
+        openTriangles.push_back(triangle);
+    }
+    const auto openBox = std::make_shared<ModelSpaceMesh>(box->getVertices(), openTriangles);
+    const auto openLayer = Slicer(WorldSpaceMesh(openBox)).sliceAt(0.5f);
+    ASSERT_EQ(openLayer.contours.size(), 1);
+    EXPECT_FALSE(openLayer.contours[0].closed);
+    EXPECT_EQ(openLayer.contours[0].points.front().x, 0.0f);
+    EXPECT_EQ(openLayer.contours[0].points.back().x, 0.0f);
+}
@@ -0,0 +1,113 @@
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "meshcore/core/VoxelGrid.h"
+#include "meshcore/utility/FileParser.h"
+#include "meshcore/utility/random.h"
+
+namespace {
+    VoxelGrid randomGrid(const Random& random, const glm::uvec3& dimensions, float density) {
+        VoxelGrid grid(dimensions);
+        for (unsigned int x = 0; x < dimensions.x; ++x){
+            for (unsigned int y = 0; y < dimensions.y; ++y){
+                for (unsigned int z = 0; z < dimensions.z; ++z){
+                    if(random.nextFloat() < density){
+                        grid.setOccupied(x, y, z);
+                    }
+                }
+            }
+        }
+        return grid;
+    }
+
+    size_t bruteForceOverlap(const VoxelGrid& a, const VoxelGrid& b, const glm::ivec3& offset) {
+        size_t count = 0;
+        for (unsigned int x = 0; x < b.getDimensions().x; ++x){
+            for (unsigned int y = 0; y < b.getDimensions().y; ++y){
+                for (unsigned int z = 0; z < b.getDimensions().z; ++z){
+                    const glm::ivec3 position = glm::ivec3(x, y, z) + offset;
+                    if(position.x < 0 || position.y < 0 || position.z < 0) continue;
+                    if(position.x >= int(a.getDimensions().x) || position.y >= int(a.getDimensions().y) || position.z >= int(a.getDimensions().z)) continue;
+                    if(b.isOccupied(x, y, z) && a.isOccupied(position.x, position.y, position.z)) count++;
+                }
+            }
+        }
+        return count;
+    }
+}
+
+TEST(VoxelGrid, SetRowRange) {
+    VoxelGrid grid(glm::uvec3(150, 2, 2));
+    grid.setRowRange(1, 1, 10, 140);
+    EXPECT_EQ(grid.getOccupiedCount(), 130);
+    EXPECT_FALSE(grid.isOccupied(9, 1, 1));
+    EXPECT_TRUE(grid.isOccupied(10, 1, 1));
+    EXPECT_TRUE(grid.isOccupied(139, 1, 1));
+    EXPECT_FALSE(grid.isOccupied(140, 1, 1));
+    EXPECT_FALSE(grid.isOccupied(50, 0, 1));
+
+    grid.setColumnRange(70, 0, 0, 2);
+    grid.setColumnRange(145, 1, 0, 1);
+    EXPECT_EQ(grid.getOccupiedCount(), 133);
+    EXPECT_TRUE(grid.isOccupied(70, 0, 0));
+    EXPECT_TRUE(grid.isOccupied(70, 1, 0));
+    EXPECT_TRUE(grid.isOccupied(145, 0, 1));
+    EXPECT_FALSE(grid.isOccupied(145, 1, 0));
+}
+
+TEST(VoxelGrid, OverlapMatchesBruteForce) {
+    Random random(0);
+    for (int i = 0; i < 50; ++i){
+        const auto a = randomGrid(random, glm::uvec3(random.nextInteger(1, 140), random.nextInteger(1, 6), random.nextInteger(1, 6)), 0.3f);
+        const auto b = randomGrid(random, glm::uvec3(random.nextInteger(1, 140), random.nextInteger(1, 6), random.nextInteger(1, 6)), 0.3f);
+        for (int j = 0; j < 20; ++j){
+            const glm::ivec3 offset(random.nextInteger(-150, 150), random.nextInteger(-6, 6), random.nextInteger(-6, 6));
+            const auto expected = bruteForceOverlap(a, b, offset);
+            EXPECT_EQ(a.getOverlapCount(b, offset), expected);
+            EXPECT_EQ(a.intersects(b, offset), expected > 0);
+        }
+    }
+}
+
+TEST(VoxelGrid, Containment) {
+    VoxelGrid container(glm::uvec3(100, 10, 10));
+    for (unsigned int y = 0; y < 10; ++y){
+        for (unsigned int z = 0; z < 10; ++z){
+            container.setRowRange(y, z, 0, 100);
+        }
+    }
+    container.setOccupied(70, 5, 5, false); // Hole in the container
+
+    VoxelGrid item(glm::uvec3(3, 3, 3));
+    item.setRowRange(1, 1, 0, 3);
+
+    EXPECT_TRUE(item.isContainedIn(container, glm::ivec3(0, 0, 0)));
+    EXPECT_TRUE(item.isContainedIn(container, glm::ivec3(97, -1, -1))); // Empty rows may stick out
+    EXPECT_FALSE(item.isContainedIn(container, glm::ivec3(98, 0, 0)));
+    EXPECT_FALSE(item.isContainedIn(container, glm::ivec3(-1, 0, 0)));
+    EXPECT_FALSE(item.isContainedIn(container, glm::ivec3(0, 9, 0)));
+    EXPECT_FALSE(item.isContainedIn(container, glm::ivec3(69, 4, 4)));
+    EXPECT_TRUE(item.isContainedIn(container, glm::ivec3(71, 4, 4)));
+}
+
+TEST(VoxelGrid, ParseBinvox) {
+    const auto filePath = (std::filesystem::temp_directory_path() / "meshcore_test_grid.binvox").string();
+    {
+        std::ofstream stream(filePath, std::ios::binary);
+        stream << "#binvox 1\ndim 4 4 4\ntranslate 0 0 0\nscale 4\ndata\n";
+        // 64 voxels, y running fastest: first 6 empty, 3 occupied, rest empty
+        const unsigned char data[] = {0, 6, 1, 3, 0, 55};
+        stream.write(reinterpret_cast<const char*>(data), sizeof(data));
+    }
+    auto grid = FileParser::loadVoxelFile(filePath);
+    std::filesystem::remove(filePath);
+
+    ASSERT_NE(grid, nullptr);
+    EXPECT_EQ(grid->getDimensions(), glm::uvec3(4, 4, 4));
+    EXPECT_EQ(grid->getOccupiedCount(), 3);
+    EXPECT_TRUE(grid->isOccupied(0, 2, 1));  // Voxel 6: z = 1, y = 2
+    EXPECT_TRUE(grid->isOccupied(0, 3, 1));  // Voxel 7
+    EXPECT_TRUE(grid->isOccupied(0, 0, 2));  // Voxel 8: z = 2, y = 0
+    EXPECT_FLOAT_EQ(grid->getVolume(), 3.0f);
+}
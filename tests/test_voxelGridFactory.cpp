@@ -0,0 +1,120 @@
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <glm/gtc/constants.hpp>
+
+#include "meshcore/factories/VoxelGridFactory.h"
+#include "meshcore/utility/FileParser.h"
+
+namespace {
+    std::shared_ptr<ModelSpaceMesh> createBox(const Vertex& size) {
+        std::vector<Vertex> vertices;
+        for (int corner = 0; corner < 8; ++corner){
+            vertices.emplace_back(corner & 1 ? size.x : 0.0f, corner & 2 ? size.y : 0.0f, corner & 4 ? size.z : 0.0f);
+        }
+        return ModelSpaceMesh(vertices).getConvexHull();
+    }
+
+    std::shared_ptr<ModelSpaceMesh> createTorus(float minorRadius, int majorSegments, int minorSegments) {
+        std::vector<Vertex> vertices;
+        for (int i = 0; i < majorSegments; ++i){
+            const auto u = 2.0f * glm::pi<float>() * static_cast<float>(i) / majorSegments;
+            for (int j = 0; j < minorSegments; ++j){
+                const auto v = 2.0f * glm::pi<float>() * static_cast<float>(j) / minorSegments;
+                const auto radius = 1.0f + minorRadius * std::cos(v);
+                vertices.emplace_back(radius * std::cos(u), radius * std::sin(u), minorRadius * std::sin(v));
+            }
+        }
+        std::vector<IndexTriangle> triangles;
+        for (int i = 0; i < majorSegments; ++i){
+            for (int j = 0; j < minorSegments; ++j){
+                const auto a = i * minorSegments + j;
+                const auto b = ((i + 1) % majorSegments) * minorSegments + j;
+                const auto c = ((i + 1) % majorSegments) * minorSegments + (j + 1) % minorSegments;
+                const auto d = i * minorSegments + (j + 1) % minorSegments;
+                triangles.emplace_back(a, b, c);
+                triangles.emplace_back(a, c, d);
+            }
+        }
+        return std::make_shared<ModelSpaceMesh>(vertices, triangles);
+    }
+}
+
+TEST(VoxelGridFactory, SolidBox) {
+    const auto box = createBox(Vertex(2.0f, 1.0f, 1.5f));
+    const auto voxelSize = VoxelGridFactory::computeVoxelSize(*box, 20);
+    EXPECT_FLOAT_EQ(voxelSize, 0.1f);
+
+    const auto solid = VoxelGridFactory::createSolidVoxelGrid(box, voxelSize);
+    EXPECT_EQ(solid->getOccupiedCount(), 20 * 10 * 15);
+    EXPECT_NEAR(solid->getVolume(), box->getVolume(), 1e-3f);
+    EXPECT_TRUE(solid->getBounds().containsPoint(box->getBounds().getMinimum()));
+    EXPECT_TRUE(solid->getBounds().containsPoint(box->getBounds().getMaximum()));
+
+    EXPECT_THROW(VoxelGridFactory::createSolidVoxelGrid(box, 0.0f), std::invalid_argument);
+}
+
+TEST(VoxelGridFactory, SurfaceEnclosesSolidBoundary) {
+    const auto torus = createTorus(0.3f, 64, 32);
+    const auto voxelSize = VoxelGridFactory::computeVoxelSize(*torus, 48);
+    const auto solid = VoxelGridFactory::createSolidVoxelGrid(torus, voxelSize);
+    const auto surface = VoxelGridFactory::createSurfaceVoxelGrid(torus, voxelSize);
+    const auto solidWithSurface = VoxelGridFactory::createSolidVoxelGrid(torus, voxelSize, true);
+    ASSERT_EQ(solid->getDimensions(), surface->getDimensions());
+
+    EXPECT_NEAR(solid->getVolume(), torus->getVolume(), 0.03f * torus->getVolume());
+    EXPECT_GT(solidWithSurface->getVolume(), torus->getVolume());
+
+    // The surface crosses each segment between the centers of an occupied and an empty voxel, so it occupies one of both
+    const auto& dimensions = solid->getDimensions();
+    const auto occupied = [&](const VoxelGrid& grid, const glm::ivec3& voxel){
+        return glm::all(glm::greaterThanEqual(voxel, glm::ivec3(0))) && glm::all(glm::lessThan(voxel, glm::ivec3(dimensions))) && grid.isOccupied(voxel.x, voxel.y, voxel.z);
+    };
+    for (int x = 0; x < int(dimensions.x); ++x){
+        for (int y = 0; y < int(dimensions.y); ++y){
+            for (int z = 0; z < int(dimensions.z); ++z){
+                const glm::ivec3 voxel(x, y, z);
+                EXPECT_EQ(occupied(*solidWithSurface, voxel), occupied(*solid, voxel) || occupied(*surface, voxel));
+                if(!occupied(*solid, voxel)){
+                    continue;
+                }
+                for (int axis = 0; axis < 3; ++axis){
+                    for (int direction = -1; direction <= 1; direction += 2){
+                        auto neighbour = voxel;
+                        neighbour[axis] += direction;
+                        if(!occupied(*solid, neighbour)){
+                            EXPECT_TRUE(occupied(*surface, voxel) || occupied(*surface, neighbour));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Batches match the individual grids
+    const auto grids = VoxelGridFactory::createSolidVoxelGrids({torus, createBox(Vertex(1.0f))}, voxelSize);
+    ASSERT_EQ(grids.size(), 2);
+    EXPECT_EQ(grids[0]->getOccupiedCount(), solid->getOccupiedCount());
+    EXPECT_EQ(grids[0]->getOverlapCount(*solid, glm::ivec3(0)), solid->getOccupiedCount());
+}
+
+TEST(VoxelGridFactory, SaveBinvox) {
+    const auto torus = createTorus(0.3f, 32, 16);
+    const auto solid = VoxelGridFactory::createSolidVoxelGrid(torus, VoxelGridFactory::computeVoxelSize(*torus, 40));
+
+    const auto filePath = (std::filesystem::temp_directory_path() / "meshcore_test_voxelisation.binvox").string();
+    std::filesystem::remove(filePath);
+    FileParser::saveVoxelFile(filePath, *solid);
+    const auto loaded = FileParser::loadVoxelFile(filePath);
+    std::filesystem::remove(filePath);
+
+    ASSERT_NE(loaded, nullptr);
+    const auto& dimensions = solid->getDimensions();
+    const auto size = std::max(dimensions.x, std::max(dimensions.y, dimensions.z));
+    EXPECT_EQ(loaded->getDimensions(), glm::uvec3(size));
+    for (int axis = 0; axis < 3; ++axis){
+        EXPECT_NEAR(loaded->getOrigin()[axis], solid->getOrigin()[axis], 1e-5f);
+        EXPECT_NEAR(loaded->getVoxelSize()[axis], solid->getVoxelSize()[axis], 1e-6f);
+    }
+    EXPECT_EQ(loaded->getOccupiedCount(), solid->getOccupiedCount());
+    EXPECT_EQ(loaded->getOverlapCount(*solid, glm::ivec3(0)), solid->getOccupiedCount());
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <tbb/parallel_for.h>
+
+#include "meshcore/core/WorldSpaceMesh.h"
+#include "meshcore/utility/random.h"
+
+TEST(WorldSpaceMesh, TightAndConservativeAABB) {
+    Random random(0);
+    std::vector<Vertex> vertices;
+    for (int i = 0; i < 500; ++i){
+        vertices.emplace_back(random.nextFloat(-1.0f, 2.0f), random.nextFloat(-0.5f, 0.5f), random.nextFloat(0.0f, 3.0f));
+    }
+    WorldSpaceMesh worldSpaceMesh(std::make_shared<ModelSpaceMesh>(vertices));
+    worldSpaceMesh.getModelTransformation().setPosition(glm::vec3(3.0f, -2.0f, 1.0f));
+    worldSpaceMesh.getModelTransformation().setScale(1.5f);
+
+    // Small consecutive rotations, as in a local search, followed by arbitrary jumps
+    Quaternion rotation;
+    for (int step = 0; step < 400; ++step){
+        if(step < 200){
+            rotation = rotation * Quaternion(glm::vec3(random.nextFloat(), random.nextFloat(), random.nextFloat()) + 0.01f, 0.05f);
+        }
+        else{
+            rotation = Quaternion(random.nextFloat(0.0f, 6.28f), random.nextFloat(0.0f, 6.28f), random.nextFloat(0.0f, 6.28f));
+        }
+        worldSpaceMesh.getModelTransformation().setRotation(rotation);
+
+        const auto exact = worldSpaceMesh.computeWorldSpaceAABB();
+        const auto tight = worldSpaceMesh.computeTightWorldSpaceAABB();
+        EXPECT_TRUE(glm::all(glm::epsilonEqual(exact.getMinimum(), tight.getMinimum(), 1e-5f)));
+        EXPECT_TRUE(glm::all(glm::epsilonEqual(exact.getMaximum(), tight.getMaximum(), 1e-5f)));
+
+        const auto conservative = worldSpaceMesh.computeConservativeWorldSpaceAABB();
+        EXPECT_TRUE(glm::all(glm::lessThanEqual(conservative.getMinimum(), exact.getMinimum() + 1e-4f)));
+        EXPECT_TRUE(glm::all(glm::greaterThanEqual(conservative.getMaximum(), exact.getMaximum() - 1e-4f)));
+    }
+}
+
+TEST(WorldSpaceMesh, ConcurrentAABBQueries) {
+    Random random(1);
+    std::vector<Vertex> vertices;
+    for (int i = 0; i < 500; ++i){
+        vertices.emplace_back(random.nextFloat(-1.0f, 2.0f), random.nextFloat(-0.5f, 0.5f), random.nextFloat(0.0f, 3.0f));
+    }
+    WorldSpaceMesh worldSpaceMesh(std::make_shared<ModelSpaceMesh>(vertices));
+    worldSpaceMesh.getModelTransformation().setRotation(Quaternion(0.3f, 1.2f, -0.7f));
+    const auto exact = worldSpaceMesh.computeWorldSpaceAABB();
+
+    // The first queries race to compute the OBB and share the warm start of the tight AABB
+    tbb::parallel_for(0, 256, [&](int){
+        const auto tight = worldSpaceMesh.computeTightWorldSpaceAABB();
+        EXPECT_TRUE(glm::all(glm::epsilonEqual(exact.getMinimum(), tight.getMinimum(), 1e-5f)));
+        EXPECT_TRUE(glm::all(glm::epsilonEqual(exact.getMaximum(), tight.getMaximum(), 1e-5f)));
+        const auto conservative = worldSpaceMesh.computeConservativeWorldSpaceAABB();
+        EXPECT_TRUE(glm::all(glm::lessThanEqual(conservative.getMinimum(), exact.getMinimum() + 1e-4f)));
+        EXPECT_TRUE(glm::all(glm::greaterThanEqual(conservative.getMaximum(), exact.getMaximum() - 1e-4f)));
+    });
+}